@@ -0,0 +1,112 @@
+/**
+ * @file Allocations.cpp
+ * @brief Counts the calls of the global allocator during expansions, evaluations and searches
+ */
+
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <Game/AI.h>
+#include <Game/Search.hpp>
+#include "Corpus.hpp"
+
+namespace {
+    std::atomic_ulong allocationCount = 0;
+
+    const aiTools::ActionState ACTION_STATE(communication::messages::types::EntityId::LEFT_CHASER3,
+                                            aiTools::ActionState::TurnState::FirstMove);
+}
+
+// Replaces the global allocator of this executable, all other operator new/delete overloads forward to these
+void *operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (auto *ret = std::malloc(size == 0 ? 1 : size)) {
+        return ret;
+    }
+
+    throw std::bad_alloc{};
+}
+
+void operator delete(void *pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+/**
+ * Calls of the global allocator per expansion with (second argument 1) and without an arena for the successors. With
+ * the arena only the environment clones inside aiTools::expandState remain.
+ */
+static void BM_ExpandAllocations(benchmark::State &state) {
+    const auto &positions = corpus::positions();
+    auto useArena = state.range(0) != 0;
+    ai::SearchContext context(positions.front().env);
+    std::vector<ai::SearchState> flat;
+    for (const auto &position : positions) {
+        flat.emplace_back(ai::SearchState::fromState(position));
+    }
+
+    ai::Arena arena;
+    unsigned long expansions = 0;
+    auto allocationsBefore = allocationCount.load();
+    for (auto _ : state) {
+        for (const auto &position : flat) {
+            ai::Arena::Scope scope(arena);
+            benchmark::DoNotOptimize(ai::expand(position, context, ACTION_STATE, useArena ? &arena : nullptr));
+            expansions++;
+        }
+    }
+
+    state.counters["allocs_per_expand"] = static_cast<double>(allocationCount.load() - allocationsBefore) /
+                                          static_cast<double>(expansions);
+}
+BENCHMARK(BM_ExpandAllocations)->Arg(0)->Arg(1);
+
+/**
+ * Calls of the global allocator per evalState of an Environment, goal rates come from the ShotTable
+ */
+static void BM_EvalStateAllocations(benchmark::State &state) {
+    const auto &positions = corpus::positions();
+    auto shots = std::make_shared<const ai::ShotTable>(positions.front().env->config);
+    unsigned long evals = 0;
+    auto allocationsBefore = allocationCount.load();
+    for (auto _ : state) {
+        for (const auto &position : positions) {
+            benchmark::DoNotOptimize(ai::evalState(position.env, *shots, gameModel::TeamSide::LEFT,
+                                                   position.goalScoredThisRound));
+            evals++;
+        }
+    }
+
+    state.counters["allocs_per_eval"] = static_cast<double>(allocationCount.load() - allocationsBefore) /
+                                        static_cast<double>(evals);
+}
+BENCHMARK(BM_EvalStateAllocations);
+
+/**
+ * Calls of the global allocator per expanded node of a fixed depth search, the rest comes from aiTools::expandState
+ */
+static void BM_SearchAllocations(benchmark::State &state) {
+    const auto &positions = corpus::positions();
+    auto depth = static_cast<unsigned int>(state.range(0));
+    ai::SearchContext context(positions.front().env);
+    const std::atomic_bool abort = false;
+    unsigned long expansions = 0;
+    unsigned long allocations = 0;
+    for (auto _ : state) {
+        for (const auto &position : positions) {
+            ai::TranspositionTable table;
+            ai::Search search(context, gameModel::TeamSide::LEFT, table);
+            auto root = ai::SearchState::fromState(position);
+            auto allocationsBefore = allocationCount.load();
+            expansions += search.computeBestAction(root, ACTION_STATE, abort, depth, depth).expansions;
+            allocations += allocationCount.load() - allocationsBefore;
+        }
+    }
+
+    state.counters["allocs_per_node"] = static_cast<double>(allocations) / static_cast<double>(expansions);
+}
+BENCHMARK(BM_SearchAllocations)->DenseRange(1, 3)->Unit(benchmark::kMillisecond);
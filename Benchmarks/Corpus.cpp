@@ -0,0 +1,85 @@
+/**
+ * @file Corpus.cpp
+ * @brief Defines the positions all benchmarks run on
+ */
+
+#include "Corpus.hpp"
+#include "setup.h"
+
+namespace corpus {
+    namespace {
+        auto createState(const std::shared_ptr<gameModel::Environment> &env) -> aiTools::State {
+            aiTools::State state;
+            state.env = env;
+            state.roundNumber = 1;
+            state.currentPhase = communication::messages::types::PhaseType::PLAYER_PHASE;
+            state.availableFansLeft = {1, 2, 2, 1, 1};
+            state.availableFansRight = {1, 2, 2, 1, 1};
+            state.playersUsedLeft = {};
+            state.playersUsedRight = {};
+            return state;
+        }
+
+        auto createPositions() -> std::vector<aiTools::State> {
+            std::vector<aiTools::State> ret;
+
+            // Opening
+            ret.emplace_back(createState(setup::createEnv()));
+            ret.emplace_back(createState(setup::createSymmetricEnv()));
+
+            // Quaffle held by a chaser in front of the goals
+            auto env = setup::createEnv();
+            env->team1->chasers[2]->position = {13, 6};
+            env->quaffle->position = env->team1->chasers[2]->position;
+            ret.emplace_back(createState(env));
+
+            // Quaffle held by the opponent, left team behind
+            env = setup::createEnv();
+            env->quaffle->position = env->team2->keeper->position;
+            env->team2->score = 40;
+            ret.emplace_back(createState(env));
+
+            // Snitch hunt in the middle of the game
+            env = setup::createEnv();
+            env->snitch->exists = true;
+            env->snitch->position = {9, 6};
+            env->team1->score = 30;
+            env->team2->score = 20;
+            auto state = createState(env);
+            state.roundNumber = 12;
+            state.playersUsedLeft.emplace(communication::messages::types::EntityId::LEFT_CHASER1);
+            ret.emplace_back(state);
+
+            // Knockouts, bans and wombat cubes
+            env = setup::createEnv();
+            env->team1->beaters[0]->knockedOut = true;
+            env->team2->chasers[1]->knockedOut = true;
+            env->team2->seeker->isFined = true;
+            env->pileOfShit.emplace_back(std::make_shared<gameModel::CubeOfShit>(gameModel::Position{8, 6}));
+            env->pileOfShit.emplace_back(std::make_shared<gameModel::CubeOfShit>(gameModel::Position{4, 8}));
+            state = createState(env);
+            state.roundNumber = 7;
+            state.goalScoredThisRound = true;
+            ret.emplace_back(state);
+
+            return ret;
+        }
+    }
+
+    auto positions() -> const std::vector<aiTools::State> & {
+        static const auto ret = createPositions();
+        return ret;
+    }
+
+    auto snapshots() -> const std::vector<communication::messages::broadcast::Snapshot> & {
+        static const auto ret = [](){
+            std::vector<communication::messages::broadcast::Snapshot> snapshots;
+            for (const auto &state : positions()) {
+                snapshots.emplace_back(setup::createSnapshot(state, communication::messages::types::DeltaType::ROUND_CHANGE));
+            }
+
+            return snapshots;
+        }();
+        return ret;
+    }
+}
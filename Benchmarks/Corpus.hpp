@@ -0,0 +1,28 @@
+/**
+ * @file Corpus.hpp
+ * @brief Declares the positions all benchmarks run on
+ */
+
+#ifndef KI_CORPUS_HPP
+#define KI_CORPUS_HPP
+
+#include <vector>
+#include <SopraAITools/AITools.h>
+#include <SopraMessages/Snapshot.hpp>
+
+namespace corpus {
+    /**
+     * Fixed set of positions built from the test setup, covering the opening, quaffle possession, a running snitch
+     * hunt, knockouts, bans and wombat cubes
+     * @return all positions of the corpus
+     */
+    auto positions() -> const std::vector<aiTools::State> &;
+
+    /**
+     * The positions of the corpus as they are sent by the server
+     * @return one snapshot per position
+     */
+    auto snapshots() -> const std::vector<communication::messages::broadcast::Snapshot> &;
+}
+
+#endif //KI_CORPUS_HPP
@@ -0,0 +1,181 @@
+/**
+ * @file Eval.cpp
+ * @brief Benchmarks of the evaluation functions
+ */
+
+#include <benchmark/benchmark.h>
+#include <Game/AI.h>
+#include <Game/IncrementalEval.hpp>
+#include <Game/EvalCache.hpp>
+#include <Game/ShotTable.hpp>
+#include "Corpus.hpp"
+
+namespace {
+    /**
+     * Reports the time per evaluation, every iteration evaluates the whole corpus
+     */
+    void setEvalCounter(benchmark::State &state, std::size_t evalsPerIteration) {
+        state.counters["ns_per_eval"] = benchmark::Counter(static_cast<double>(evalsPerIteration) * 1e-9,
+                benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+    }
+}
+
+static void BM_SimpleEval(benchmark::State &state) {
+    const auto &positions = corpus::positions();
+    for (auto _ : state) {
+        for (const auto &position : positions) {
+            benchmark::DoNotOptimize(ai::simpleEval(position, gameModel::TeamSide::LEFT));
+        }
+    }
+
+    setEvalCounter(state, positions.size());
+}
+BENCHMARK(BM_SimpleEval);
+
+static void BM_SimpleEvalFlat(benchmark::State &state) {
+    const auto &positions = corpus::positions();
+    ai::SearchContext context(positions.front().env);
+    std::vector<ai::SearchState> flat;
+    for (const auto &position : positions) {
+        flat.emplace_back(ai::SearchState::fromState(position));
+    }
+
+    // Computed from scratch, simpleEval would serve the positions from the eval cache after the first iteration
+    for (auto _ : state) {
+        for (const auto &position : flat) {
+            benchmark::DoNotOptimize(ai::IncrementalEval(position, context, gameModel::TeamSide::LEFT).value(position));
+        }
+    }
+
+    setEvalCounter(state, flat.size());
+}
+BENCHMARK(BM_SimpleEvalFlat);
+
+static void BM_SimpleEvalFlatCached(benchmark::State &state) {
+    const auto &positions = corpus::positions();
+    ai::SearchContext context(positions.front().env);
+    std::vector<ai::SearchState> flat;
+    for (const auto &position : positions) {
+        flat.emplace_back(ai::SearchState::fromState(position));
+    }
+
+    auto &cache = ai::EvalCache::forThread();
+    cache.clear();
+    auto hitsBefore = cache.getHits();
+    auto missesBefore = cache.getMisses();
+    for (auto _ : state) {
+        for (const auto &position : flat) {
+            benchmark::DoNotOptimize(ai::simpleEval(position, context, gameModel::TeamSide::LEFT));
+        }
+    }
+
+    setEvalCounter(state, flat.size());
+    auto hits = static_cast<double>(cache.getHits() - hitsBefore);
+    state.counters["hit_rate"] = hits / (hits + static_cast<double>(cache.getMisses() - missesBefore));
+}
+BENCHMARK(BM_SimpleEvalFlatCached);
+
+static void BM_IncrementalEvalUpdate(benchmark::State &state) {
+    const auto &positions = corpus::positions();
+    ai::SearchContext context(positions.front().env);
+    std::vector<ai::SearchState> flat;
+    for (const auto &position : positions) {
+        flat.emplace_back(ai::SearchState::fromState(position));
+    }
+
+    ai::IncrementalEval eval(flat.front(), context, gameModel::TeamSide::LEFT);
+    for (auto _ : state) {
+        for (std::size_t i = 1; i <= flat.size(); i++) {
+            eval.update(flat[i - 1], flat[i % flat.size()]);
+            benchmark::DoNotOptimize(eval.value(flat[i % flat.size()]));
+        }
+    }
+
+    setEvalCounter(state, flat.size());
+}
+BENCHMARK(BM_IncrementalEvalUpdate);
+
+static void BM_EvalState(benchmark::State &state) {
+    const auto &positions = corpus::positions();
+    auto shots = std::make_shared<const ai::ShotTable>(positions.front().env->config);
+    for (auto _ : state) {
+        for (const auto &position : positions) {
+            benchmark::DoNotOptimize(ai::evalState(position.env, *shots, gameModel::TeamSide::LEFT,
+                                                   position.goalScoredThisRound));
+        }
+    }
+
+    setEvalCounter(state, positions.size());
+}
+BENCHMARK(BM_EvalState);
+
+static void BM_EvalStateFlat(benchmark::State &state) {
+    const auto &positions = corpus::positions();
+    ai::SearchContext context(positions.front().env);
+    std::vector<ai::SearchState> flat;
+    for (const auto &position : positions) {
+        flat.emplace_back(ai::SearchState::fromState(position));
+    }
+
+    for (auto _ : state) {
+        for (const auto &position : flat) {
+            benchmark::DoNotOptimize(ai::evalState(position, context, gameModel::TeamSide::LEFT));
+        }
+    }
+
+    setEvalCounter(state, flat.size());
+}
+BENCHMARK(BM_EvalStateFlat);
+
+static void BM_GetHighestGoalRate(benchmark::State &state) {
+    const auto &positions = corpus::positions();
+    for (auto _ : state) {
+        for (const auto &position : positions) {
+            for (const auto &player : position.env->getAllPlayers()) {
+                benchmark::DoNotOptimize(ai::getHighestGoalRate(position.env, player));
+            }
+        }
+    }
+
+    setEvalCounter(state, positions.size() * ai::PLAYER_COUNT);
+}
+BENCHMARK(BM_GetHighestGoalRate);
+
+static void BM_GetHighestGoalRateTable(benchmark::State &state) {
+    const auto &positions = corpus::positions();
+    ai::ShotTable shots(positions.front().env->config);
+    for (auto _ : state) {
+        for (const auto &position : positions) {
+            for (const auto &player : position.env->getAllPlayers()) {
+                benchmark::DoNotOptimize(ai::getHighestGoalRate(shots, position.env, player));
+            }
+        }
+    }
+
+    setEvalCounter(state, positions.size() * ai::PLAYER_COUNT);
+}
+BENCHMARK(BM_GetHighestGoalRateTable);
+
+static void BM_EnvironmentClone(benchmark::State &state) {
+    const auto &positions = corpus::positions();
+    for (auto _ : state) {
+        for (const auto &position : positions) {
+            benchmark::DoNotOptimize(position.env->clone());
+        }
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * positions.size()));
+}
+BENCHMARK(BM_EnvironmentClone);
+
+static void BM_SearchStateFromState(benchmark::State &state) {
+    const auto &positions = corpus::positions();
+    for (auto _ : state) {
+        for (const auto &position : positions) {
+            benchmark::DoNotOptimize(ai::SearchState::fromState(position));
+        }
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * positions.size()));
+}
+BENCHMARK(BM_SearchStateFromState);
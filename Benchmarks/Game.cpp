@@ -0,0 +1,25 @@
+/**
+ * @file Game.cpp
+ * @brief Benchmarks of the message handling in Game
+ */
+
+#include <benchmark/benchmark.h>
+#include <iostream>
+#include <Game/Game.hpp>
+#include "Corpus.hpp"
+
+static void BM_OnSnapshot(benchmark::State &state) {
+    const auto &snapshots = corpus::snapshots();
+    Game game(0, 1, false, ai::Engine::AlphaBeta, nullptr, nullptr, {}, util::AsyncLog{std::cout, 0});
+
+    // The first snapshot builds the environment and the match constants
+    game.onSnapshot(snapshots.front());
+    for (auto _ : state) {
+        for (const auto &snapshot : snapshots) {
+            game.onSnapshot(snapshot);
+        }
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * snapshots.size()));
+}
+BENCHMARK(BM_OnSnapshot);
@@ -0,0 +1,150 @@
+/**
+ * @file Search.cpp
+ * @brief Benchmarks of fixed depth searches
+ */
+
+#include <benchmark/benchmark.h>
+#include <Game/AI.h>
+#include <Game/EvalCache.hpp>
+#include <Game/Search.hpp>
+#include <Game/Mcts.hpp>
+#include "Corpus.hpp"
+
+namespace {
+    const aiTools::ActionState ACTION_STATE(communication::messages::types::EntityId::LEFT_CHASER3,
+                                            aiTools::ActionState::TurnState::FirstMove);
+    const aiTools::ActionState ACTION_TURN(communication::messages::types::EntityId::LEFT_CHASER3,
+                                           aiTools::ActionState::TurnState::Action);
+}
+
+static void BM_Search(benchmark::State &state) {
+    const auto &positions = corpus::positions();
+    auto depth = static_cast<unsigned int>(state.range(0));
+    ai::SearchContext context(positions.front().env);
+    const std::atomic_bool abort = false;
+    unsigned long expansions = 0;
+    for (auto _ : state) {
+        for (const auto &position : positions) {
+            // A fresh table and eval cache per search, otherwise every iteration after the first one is a hit
+            ai::TranspositionTable table;
+            ai::EvalCache::forThread().clear();
+            ai::Search search(context, gameModel::TeamSide::LEFT, table);
+            expansions += search.computeBestAction(ai::SearchState::fromState(position), ACTION_STATE, abort,
+                    depth, depth).expansions;
+        }
+    }
+
+    state.counters["nodes_per_sec"] = benchmark::Counter(static_cast<double>(expansions), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_Search)->DenseRange(1, 3)->Unit(benchmark::kMillisecond);
+
+static void BM_SearchEvalState(benchmark::State &state) {
+    const auto &positions = corpus::positions();
+    auto depth = static_cast<unsigned int>(state.range(0));
+    ai::SearchContext context(positions.front().env);
+    const std::atomic_bool abort = false;
+    unsigned long evals = 0;
+    for (auto _ : state) {
+        for (const auto &position : positions) {
+            ai::TranspositionTable table;
+            ai::Search search(context, gameModel::TeamSide::LEFT, table);
+            search.setLeafEval(ai::evalState);
+            evals += search.computeBestAction(ai::SearchState::fromState(position), ACTION_STATE, abort,
+                    depth, depth).stats.evals;
+        }
+    }
+
+    state.counters["evals_per_sec"] = benchmark::Counter(static_cast<double>(evals), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_SearchEvalState)->DenseRange(1, 3)->Unit(benchmark::kMillisecond);
+
+/**
+ * Expansions of a fixed depth search with (second argument 1) and without move ordering, the move stored in the
+ * transposition table is searched first in both cases
+ */
+static void BM_SearchMoveOrdering(benchmark::State &state) {
+    const auto &positions = corpus::positions();
+    auto depth = static_cast<unsigned int>(state.range(0));
+    auto orderMoves = state.range(1) != 0;
+    ai::SearchContext context(positions.front().env);
+    const std::atomic_bool abort = false;
+    unsigned long expansions = 0;
+    unsigned long searches = 0;
+    for (auto _ : state) {
+        for (const auto &position : positions) {
+            ai::TranspositionTable table;
+            ai::Search search(context, gameModel::TeamSide::LEFT, table, 1, false, orderMoves);
+            expansions += search.computeBestAction(ai::SearchState::fromState(position), ACTION_STATE, abort,
+                    1, depth).expansions;
+            searches++;
+        }
+    }
+
+    state.counters["expansions"] = static_cast<double>(expansions) / static_cast<double>(searches);
+}
+BENCHMARK(BM_SearchMoveOrdering)->Args({2, 0})->Args({2, 1})->Args({3, 0})->Args({3, 1})
+        ->Unit(benchmark::kMillisecond);
+
+static void BM_ComputeBestActionAlphaBetaID(benchmark::State &state) {
+    const auto &positions = corpus::positions();
+    auto depth = static_cast<unsigned int>(state.range(0));
+    const std::atomic_bool abort = false;
+    auto evalFunction = [](const aiTools::State &s) {
+        return ai::simpleEval(s, gameModel::TeamSide::LEFT);
+    };
+
+    unsigned long expansions = 0;
+    for (auto _ : state) {
+        for (const auto &position : positions) {
+            expansions += std::get<2>(aiTools::computeBestActionAlphaBetaID(position, evalFunction, ACTION_STATE,
+                    abort, depth, depth));
+        }
+    }
+
+    state.counters["nodes_per_sec"] = benchmark::Counter(static_cast<double>(expansions), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_ComputeBestActionAlphaBetaID)->DenseRange(1, 3)->Unit(benchmark::kMillisecond);
+
+/**
+ * Playouts and expansions of the Monte Carlo tree search for an ACTION turn with the given number of threads, compare
+ * with BM_SearchAction
+ */
+static void BM_Mcts(benchmark::State &state) {
+    const auto &positions = corpus::positions();
+    auto threads = static_cast<unsigned int>(state.range(0));
+    ai::SearchContext context(positions.front().env);
+    const std::atomic_bool abort = false;
+    unsigned long playouts = 0;
+    unsigned long expansions = 0;
+    for (auto _ : state) {
+        for (const auto &position : positions) {
+            ai::Mcts mcts(context, gameModel::TeamSide::LEFT, threads);
+            auto result = mcts.computeBestAction(ai::SearchState::fromState(position), ACTION_TURN, abort, 1000);
+            playouts += result.stats.playouts;
+            expansions += result.expansions;
+        }
+    }
+
+    state.counters["playouts_per_sec"] = benchmark::Counter(static_cast<double>(playouts), benchmark::Counter::kIsRate);
+    state.counters["nodes_per_sec"] = benchmark::Counter(static_cast<double>(expansions), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_Mcts)->RangeMultiplier(2)->Range(1, 4)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_SearchAction(benchmark::State &state) {
+    const auto &positions = corpus::positions();
+    auto depth = static_cast<unsigned int>(state.range(0));
+    ai::SearchContext context(positions.front().env);
+    const std::atomic_bool abort = false;
+    unsigned long expansions = 0;
+    for (auto _ : state) {
+        for (const auto &position : positions) {
+            ai::TranspositionTable table;
+            ai::Search search(context, gameModel::TeamSide::LEFT, table);
+            expansions += search.computeBestAction(ai::SearchState::fromState(position), ACTION_TURN, abort,
+                    depth, depth).expansions;
+        }
+    }
+
+    state.counters["nodes_per_sec"] = benchmark::Counter(static_cast<double>(expansions), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_SearchAction)->DenseRange(1, 2)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,67 @@
+/**
+ * @file Serialization.cpp
+ * @brief Benchmarks of the serialization of outgoing messages
+ */
+
+#include <benchmark/benchmark.h>
+#include <Communication/MessageWriter.hpp>
+
+namespace {
+    auto createMessage() -> communication::messages::Message {
+        using namespace communication::messages;
+        return Message{request::DeltaRequest{types::DeltaType::QUAFFLE_THROW, std::nullopt, std::nullopt,
+                                             std::nullopt, 14, 6, types::EntityId::LEFT_CHASER2, std::nullopt,
+                                             std::nullopt, std::nullopt, std::nullopt, std::nullopt, std::nullopt}};
+    }
+
+    void setMessageCounters(benchmark::State &state, std::size_t bytes) {
+        state.counters["bytes_per_message"] = static_cast<double>(bytes);
+        state.counters["us_per_message"] = benchmark::Counter(1e-6,
+                benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+    }
+}
+
+/**
+ * Serialization used before the MessageWriter: json object, indented with 4 spaces
+ */
+static void BM_SerializeDomPretty(benchmark::State &state) {
+    auto message = createMessage();
+    std::size_t bytes = 0;
+    for (auto _ : state) {
+        nlohmann::json json = message;
+        auto serialized = json.dump(4);
+        bytes = serialized.size();
+        benchmark::DoNotOptimize(serialized);
+    }
+
+    setMessageCounters(state, bytes);
+}
+BENCHMARK(BM_SerializeDomPretty);
+
+static void BM_SerializeDomCompact(benchmark::State &state) {
+    auto message = createMessage();
+    std::size_t bytes = 0;
+    for (auto _ : state) {
+        nlohmann::json json = message;
+        auto serialized = json.dump();
+        bytes = serialized.size();
+        benchmark::DoNotOptimize(serialized);
+    }
+
+    setMessageCounters(state, bytes);
+}
+BENCHMARK(BM_SerializeDomCompact);
+
+static void BM_SerializeWriter(benchmark::State &state) {
+    auto message = createMessage();
+    communication::MessageWriter writer;
+    std::size_t bytes = 0;
+    for (auto _ : state) {
+        const auto &serialized = writer.write(message);
+        bytes = serialized.size();
+        benchmark::DoNotOptimize(serialized.data());
+    }
+
+    setMessageCounters(state, bytes);
+}
+BENCHMARK(BM_SerializeWriter);
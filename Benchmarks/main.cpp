@@ -0,0 +1,25 @@
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <vector>
+
+/**
+ * Runs all benchmarks, the results are printed as JSON unless another format is requested
+ */
+int main(int argc, char **argv) {
+    std::vector<char *> args(argv, argv + argc);
+    char jsonFormat[] = "--benchmark_format=json";
+    bool formatSet = false;
+    for (const auto &arg : args) {
+        formatSet |= std::strncmp(arg, "--benchmark_format", std::strlen("--benchmark_format")) == 0;
+    }
+
+    if (!formatSet) {
+        args.emplace_back(jsonFormat);
+    }
+
+    auto count = static_cast<int>(args.size());
+    benchmark::Initialize(&count, args.data());
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -9,19 +9,22 @@
 #include <SopraGameLogic/GameController.h>
 #include <SopraGameLogic/GameModel.h>
 #include <SopraGameLogic/Interference.h>
+#include <functional>
 
 //-------------------------------------eval-----------------------------------------------------------------------------
 
 TEST(ai_test, ai_left_right_equal){
     auto env = setup::createSymmetricEnv();
-    auto valLeft = ai::evalState(env, gameModel::TeamSide::LEFT, false);
-    auto valRight = ai::evalState(env, gameModel::TeamSide::RIGHT, false);
+    auto shots = std::make_shared<const ai::ShotTable>(env->config);
+    auto valLeft = ai::evalState(env, *shots, gameModel::TeamSide::LEFT, false);
+    auto valRight = ai::evalState(env, *shots, gameModel::TeamSide::RIGHT, false);
     EXPECT_EQ(valLeft, valRight);
 }
 
 TEST(ai_test, ai_left_right_equal_zero){
     auto env = setup::createSymmetricEnv();
-    auto valLeft = ai::evalState(env, gameModel::TeamSide::LEFT, false);
+    auto shots = std::make_shared<const ai::ShotTable>(env->config);
+    auto valLeft = ai::evalState(env, *shots, gameModel::TeamSide::LEFT, false);
     EXPECT_EQ(valLeft, 0);
 }
 
@@ -29,10 +32,31 @@ TEST(ai_test, ai_is_winning){
     auto env = setup::createSymmetricEnv();
     auto leftTeam = env->getTeam(gameModel::TeamSide::LEFT);
     leftTeam->score = 100;
-    auto val = ai::evalState(env, gameModel::TeamSide::LEFT, false);
+    auto shots = std::make_shared<const ai::ShotTable>(env->config);
+    auto val = ai::evalState(env, *shots, gameModel::TeamSide::LEFT, false);
     EXPECT_GT(val, 0);
 }
 
+TEST(ai_test, flat_eval_state_matches_environment){
+    auto state = setup::createState();
+    auto env = state.env;
+    ai::SearchContext context(env);
+
+    // Quaffle held by a chaser, loose, held by a keeper, then with the snitch next to a seeker and a banned chaser
+    std::vector<std::function<void()>> changes{
+        [&env](){ env->quaffle->position = env->team1->chasers[1]->position; },
+        [&env](){ env->quaffle->position = {8, 8}; },
+        [&env](){ env->quaffle->position = env->team2->keeper->position; env->team2->score = 40; },
+        [&env](){ env->snitch->exists = true; env->snitch->position = {6, 4}; env->team1->chasers[0]->isFined = true; }};
+    for (const auto &change : changes) {
+        change();
+        auto flat = ai::SearchState::fromState(state);
+        for (auto side : {gameModel::TeamSide::LEFT, gameModel::TeamSide::RIGHT}) {
+            EXPECT_NEAR(ai::evalState(flat, context, side), ai::evalState(env, *context.shots, side, false), 1e-6);
+        }
+    }
+}
+
 TEST(ai_test, team_has_quaffle_works_for_left){
     auto env = setup::createEnv();
     auto leftTeam = env->getTeam(gameModel::TeamSide::LEFT);
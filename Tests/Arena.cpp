@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <Game/Arena.hpp>
+
+TEST(arena_test, rewind_reuses_memory){
+    ai::Arena arena(1024);
+    auto marker = arena.mark();
+    auto *first = arena.allocate(100, 8);
+    auto *second = arena.allocate(1, 1);
+    auto *third = arena.allocate(16, 16);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(third) % 16, 0);
+    EXPECT_NE(first, second);
+    EXPECT_GE(static_cast<std::byte *>(third), static_cast<std::byte *>(second) + 1);
+
+    arena.rewind(marker);
+    EXPECT_EQ(arena.allocate(100, 8), first);
+    EXPECT_EQ(arena.getAllocations(), 4u);
+    EXPECT_EQ(arena.getChunkAllocations(), 1u);
+}
+
+TEST(arena_test, chunks_are_kept){
+    ai::Arena arena(1024);
+    {
+        ai::Arena::Scope scope(arena);
+        for (int i = 0; i < 10; i++) {
+            arena.allocate(512, 8);
+        }
+
+        // Larger than a chunk
+        arena.allocate(4096, 8);
+    }
+
+    auto chunks = arena.getChunkAllocations();
+    auto capacity = arena.capacity();
+    EXPECT_GE(capacity, 5u * 1024 + 4096);
+    for (int i = 0; i < 10; i++) {
+        arena.allocate(512, 8);
+    }
+
+    arena.release();
+    arena.allocate(4096, 8);
+    EXPECT_EQ(arena.getChunkAllocations(), chunks);
+    EXPECT_EQ(arena.capacity(), capacity);
+}
+
+TEST(arena_test, copies_use_global_allocator){
+    ai::Arena arena;
+    ai::ArenaVector<int> vector{ai::ArenaAllocator<int>{&arena}};
+    vector.reserve(3);
+    vector.insert(vector.end(), {1, 2, 3});
+    EXPECT_EQ(arena.getAllocations(), 1u);
+
+    auto copy = vector;
+    EXPECT_EQ(copy, vector);
+    EXPECT_EQ(copy.get_allocator(), ai::ArenaAllocator<int>{});
+    EXPECT_EQ(arena.getAllocations(), 1u);
+
+    auto moved = std::move(vector);
+    EXPECT_EQ(moved.get_allocator(), ai::ArenaAllocator<int>{&arena});
+}
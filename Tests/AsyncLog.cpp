@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <thread>
+#include <Util/AsyncLog.hpp>
+
+TEST(async_log_test, writes_records_in_order){
+    std::ostringstream stream;
+    {
+        util::AsyncLog log{stream, 4};
+        for (int i = 0; i < 100; i++) {
+            log.info("record " + std::to_string(i) + ";");
+        }
+
+        log.flush();
+    }
+
+    auto text = stream.str();
+    std::size_t last = 0;
+    for (int i = 0; i < 100; i++) {
+        auto position = text.find("record " + std::to_string(i) + ";");
+        ASSERT_NE(position, std::string::npos);
+        EXPECT_GE(position, last);
+        last = position;
+    }
+}
+
+TEST(async_log_test, formats_lazily){
+    std::ostringstream stream;
+    util::AsyncLog log{stream, 2};
+    bool formatted = false;
+    log.debug([&formatted]{
+        formatted = true;
+        return std::string{"debug"};
+    });
+    log.warn([]{ return std::string{"lazy warning"}; });
+    log.flush();
+    EXPECT_FALSE(formatted);
+    EXPECT_FALSE(log.isEnabled(util::AsyncLog::Level::Info));
+    EXPECT_NE(stream.str().find("lazy warning"), std::string::npos);
+}
+
+TEST(async_log_test, concurrent_producers){
+    constexpr int THREADS = 4;
+    constexpr int RECORDS = 500;
+    std::ostringstream stream;
+    util::AsyncLog log{stream, 3, THREADS * RECORDS};
+    std::vector<std::thread> producers;
+    for (int t = 0; t < THREADS; t++) {
+        producers.emplace_back([log, t]{
+            for (int i = 0; i < RECORDS; i++) {
+                log.info([t, i]{ return "<" + std::to_string(t) + ":" + std::to_string(i) + ">"; });
+            }
+        });
+    }
+
+    for (auto &producer : producers) {
+        producer.join();
+    }
+
+    log.flush();
+    EXPECT_EQ(log.getDropped(), 0u);
+    auto text = stream.str();
+    for (int t = 0; t < THREADS; t++) {
+        for (int i = 0; i < RECORDS; i++) {
+            EXPECT_NE(text.find("<" + std::to_string(t) + ":" + std::to_string(i) + ">"), std::string::npos);
+        }
+    }
+}
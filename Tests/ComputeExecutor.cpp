@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+#include <future>
+#include <Util/ComputeExecutor.hpp>
+
+TEST(compute_executor_test, runs_jobs_in_order){
+    std::vector<int> order;
+    std::promise<void> done;
+    {
+        util::ComputeExecutor executor(8, {});
+        for (int i = 0; i < 5; i++) {
+            EXPECT_TRUE(executor.submit([&order, i]{ order.emplace_back(i); }));
+        }
+
+        executor.submit([&done]{ done.set_value(); });
+        done.get_future().wait();
+    }
+
+    EXPECT_EQ(order, (std::vector<int>{0, 1, 2, 3, 4}));
+}
+
+TEST(compute_executor_test, replaces_stale_jobs_and_bounds_queue){
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    std::promise<void> started;
+    std::promise<void> done;
+    std::vector<int> order;
+    util::ComputeExecutor executor(2, {});
+    executor.submit([&started, released]{ started.set_value(); released.wait(); });
+    started.get_future().wait();
+
+    EXPECT_TRUE(executor.submit([&order]{ order.emplace_back(1); }, true));
+    EXPECT_TRUE(executor.submit([&order]{ order.emplace_back(2); }, true));
+    EXPECT_TRUE(executor.submit([&order]{ order.emplace_back(3); }));
+    EXPECT_EQ(executor.getDropped(), 1u);
+
+    // Jobs that are not replaceable are never dropped, the capacity only applies to replaceable ones
+    EXPECT_TRUE(executor.submit([&order]{ order.emplace_back(4); }));
+    EXPECT_FALSE(executor.submit([&order]{ order.emplace_back(5); }, true));
+    EXPECT_EQ(executor.getDropped(), 3u);
+
+    EXPECT_TRUE(executor.submit([&done]{ done.set_value(); }));
+    release.set_value();
+    done.get_future().wait();
+    EXPECT_EQ(order, (std::vector<int>{3, 4}));
+    EXPECT_EQ(executor.getDropped(), 3u);
+}
+
+TEST(compute_executor_test, reports_exceptions){
+    std::promise<std::string> error;
+    util::ComputeExecutor executor(1, [&error](const std::exception &e){ error.set_value(e.what()); });
+    executor.submit([]{ throw std::runtime_error("search failed"); });
+    EXPECT_EQ(error.get_future().get(), "search failed");
+}
+
+TEST(compute_executor_test, latency_stats){
+    util::LatencyStats stats;
+    EXPECT_EQ(stats.getMean(), 0);
+    stats.add(std::chrono::milliseconds{10});
+    stats.add(std::chrono::milliseconds{30});
+    EXPECT_EQ(stats.getCount(), 2u);
+    EXPECT_DOUBLE_EQ(stats.getMean(), 20);
+    EXPECT_DOUBLE_EQ(stats.getMax(), 30);
+}
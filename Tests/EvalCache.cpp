@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include <Game/AI.h>
+#include <Game/EvalCache.hpp>
+#include <Game/IncrementalEval.hpp>
+#include "setup.h"
+
+TEST(eval_cache_test, store_and_probe){
+    ai::EvalCache cache(4);
+    EXPECT_FALSE(cache.probe(42).has_value());
+    cache.store(42, 1.5);
+    auto value = cache.probe(42);
+    ASSERT_TRUE(value.has_value());
+    EXPECT_EQ(*value, 1.5);
+    EXPECT_EQ(cache.getHits(), 1u);
+    EXPECT_EQ(cache.getMisses(), 1u);
+}
+
+TEST(eval_cache_test, collision_replaces_entry){
+    ai::EvalCache cache(4);
+    cache.store(3, 1);
+    cache.store(3 + 16, 2);
+    EXPECT_FALSE(cache.probe(3).has_value());
+    EXPECT_EQ(cache.probe(3 + 16), 2);
+}
+
+TEST(eval_cache_test, clear_keeps_counters){
+    ai::EvalCache cache(4);
+    cache.store(7, 1);
+    EXPECT_TRUE(cache.probe(7).has_value());
+    cache.clear();
+    EXPECT_FALSE(cache.probe(7).has_value());
+    EXPECT_EQ(cache.getHits(), 1u);
+    EXPECT_EQ(cache.getMisses(), 1u);
+}
+
+TEST(eval_cache_test, simple_eval_is_cached){
+    auto state = setup::createState();
+    ai::SearchContext context(state.env);
+    auto flat = ai::SearchState::fromState(state);
+
+    auto &cache = ai::EvalCache::forThread();
+    cache.clear();
+    auto hits = cache.getHits();
+    auto expected = ai::IncrementalEval(flat, context, gameModel::TeamSide::LEFT).value(flat);
+    EXPECT_DOUBLE_EQ(ai::simpleEval(flat, context, gameModel::TeamSide::LEFT), expected);
+    EXPECT_DOUBLE_EQ(ai::simpleEval(flat, context, gameModel::TeamSide::LEFT), expected);
+    EXPECT_EQ(cache.getHits(), hits + 1);
+
+    // The other side has its own entry
+    EXPECT_DOUBLE_EQ(ai::simpleEval(flat, context, gameModel::TeamSide::RIGHT),
+                     ai::IncrementalEval(flat, context, gameModel::TeamSide::RIGHT).value(flat));
+    EXPECT_EQ(cache.getHits(), hits + 1);
+}
+
+TEST(eval_cache_test, contexts_do_not_share_entries){
+    auto state = setup::createState();
+    ai::SearchContext context(state.env);
+    ai::SearchContext otherContext(state.env);
+    auto flat = ai::SearchState::fromState(state);
+
+    auto &cache = ai::EvalCache::forThread();
+    cache.clear();
+    auto hits = cache.getHits();
+    ai::simpleEval(flat, context, gameModel::TeamSide::LEFT);
+    ai::simpleEval(flat, otherContext, gameModel::TeamSide::LEFT);
+    EXPECT_EQ(cache.getHits(), hits);
+    ai::simpleEval(flat, context, gameModel::TeamSide::LEFT);
+    EXPECT_EQ(cache.getHits(), hits + 1);
+}
+
+TEST(eval_cache_test, incremental_eval_shares_the_cache){
+    auto state = setup::createState();
+    ai::SearchContext context(state.env);
+    auto flat = ai::SearchState::fromState(state);
+
+    auto &cache = ai::EvalCache::forThread();
+    cache.clear();
+    auto hits = cache.getHits();
+    const ai::IncrementalEval eval(flat, context, gameModel::TeamSide::LEFT);
+    EXPECT_DOUBLE_EQ(eval.cachedValue(flat), eval.value(flat));
+    EXPECT_EQ(cache.getHits(), hits);
+    EXPECT_DOUBLE_EQ(ai::simpleEval(flat, context, gameModel::TeamSide::LEFT), eval.value(flat));
+    EXPECT_EQ(cache.getHits(), hits + 1);
+}
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+#include <Game/Mcts.hpp>
+#include "setup.h"
+
+namespace {
+    const aiTools::ActionState ACTION_STATE(communication::messages::types::EntityId::LEFT_CHASER2,
+                                            aiTools::ActionState::TurnState::Action);
+
+    bool isPossible(const aiTools::State &state, const communication::messages::request::DeltaRequest &action) {
+        for (const auto &successor : aiTools::expandState(state, ACTION_STATE)) {
+            if (successor.first == action) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+}
+
+TEST(mcts_test, node_pool_capacity){
+    ai::NodePool pool(ai::NodePool::BLOCK_SIZE + 10);
+    auto *first = pool.allocate(ai::NodePool::BLOCK_SIZE - 5);
+    ASSERT_NE(first, nullptr);
+
+    // Does not fit into the rest of the first block
+    auto *second = pool.allocate(10);
+    ASSERT_NE(second, nullptr);
+    EXPECT_EQ(pool.size(), ai::NodePool::BLOCK_SIZE + 5);
+    EXPECT_FALSE(pool.exhausted());
+
+    EXPECT_EQ(pool.allocate(6), nullptr);
+    EXPECT_NE(pool.allocate(5), nullptr);
+    EXPECT_TRUE(pool.exhausted());
+    EXPECT_EQ(pool.allocate(1), nullptr);
+}
+
+TEST(mcts_test, best_action_is_possible){
+    auto state = setup::createState(true);
+    ai::SearchContext context(state.env);
+    const std::atomic_bool abort = false;
+    for (unsigned int threads : {1u, 4u}) {
+        ai::Mcts mcts(context, gameModel::TeamSide::LEFT, threads);
+        auto result = mcts.computeBestAction(ai::SearchState::fromState(state), ACTION_STATE, abort, 200);
+        EXPECT_GE(result.stats.playouts, 200);
+        EXPECT_LT(result.stats.playouts, 200 + threads);
+        EXPECT_EQ(result.stats.evals, result.stats.playouts);
+        EXPECT_GE(result.depth, 1);
+        EXPECT_TRUE(isPossible(state, result.action));
+    }
+}
+
+TEST(mcts_test, abort_before_first_playout){
+    auto state = setup::createState(true);
+    ai::SearchContext context(state.env);
+    const std::atomic_bool abort = true;
+    ai::Mcts mcts(context, gameModel::TeamSide::LEFT, 2);
+    auto result = mcts.computeBestAction(ai::SearchState::fromState(state), ACTION_STATE, abort);
+    EXPECT_EQ(result.stats.playouts, 0);
+    EXPECT_TRUE(isPossible(state, result.action));
+}
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <Communication/MessageParser.hpp>
+#include "setup.h"
+
+namespace {
+    constexpr unsigned int FUZZ_SEED = 42;
+    constexpr unsigned int RANDOM_SNAPSHOTS = 200;
+    constexpr unsigned int MUTATIONS = 2000;
+
+    auto randomMessage(std::mt19937 &random) -> std::string {
+        using namespace communication::messages::types;
+        constexpr std::array<DeltaType, 4> deltaTypes = {DeltaType::MOVE, DeltaType::TURN_USED,
+                                                         DeltaType::ROUND_CHANGE, DeltaType::QUAFFLE_THROW};
+        auto state = setup::createRandomState(random);
+        auto deltaType = deltaTypes[std::uniform_int_distribution<std::size_t>(0, deltaTypes.size() - 1)(random)];
+        nlohmann::json message;
+        message["payload"] = setup::createSnapshotJson(state, deltaType, EntityId::LEFT_CHASER1);
+        message["payloadType"] = communication::messages::broadcast::Snapshot::getName();
+        message["timestamp"] = "2019-06-16 12:00:00.000";
+        return message.dump();
+    }
+
+    /**
+     * Parses a message with nlohmann::json and the message library
+     * @return the snapshot if the message is a valid snapshot
+     */
+    auto parseDom(const std::string &text) -> std::optional<communication::SnapshotFrame> {
+        try {
+            auto message = nlohmann::json::parse(text).get<communication::messages::Message>();
+            auto payload = message.getPayload();
+            if (const auto *snapshot = std::get_if<communication::messages::broadcast::Snapshot>(&payload)) {
+                return communication::SnapshotFrame::fromSnapshot(*snapshot);
+            }
+        } catch (std::exception &) {}
+
+        return std::nullopt;
+    }
+}
+
+TEST(message_parser_test, snapshot_matches_json){
+    std::mt19937 random(FUZZ_SEED);
+    communication::MessageParser parser;
+    for (unsigned int i = 0; i < RANDOM_SNAPSHOTS; i++) {
+        auto text = randomMessage(random);
+        auto expected = parseDom(text);
+        ASSERT_TRUE(expected.has_value());
+        ASSERT_EQ(parser.parse(text), communication::MessageParser::Result::Snapshot);
+        EXPECT_EQ(parser.getSnapshot(), *expected);
+    }
+}
+
+TEST(message_parser_test, next_matches_json){
+    using namespace communication::messages;
+    communication::MessageParser parser;
+    for (auto turnType : {types::TurnType::MOVE, types::TurnType::ACTION, types::TurnType::FAN,
+                          types::TurnType::REMOVE_BAN}) {
+        broadcast::Next next{types::EntityId::RIGHT_BEATER2, turnType, 3000};
+        nlohmann::json json = Message{next};
+        ASSERT_EQ(parser.parse(json.dump()), communication::MessageParser::Result::Next);
+        EXPECT_EQ(parser.getNext(), next);
+    }
+}
+
+TEST(message_parser_test, other_messages_are_left_to_json){
+    using namespace communication::messages;
+    communication::MessageParser parser;
+    nlohmann::json json = Message{request::TeamFormation{}};
+    EXPECT_EQ(parser.parse(json.dump()), communication::MessageParser::Result::Other);
+    EXPECT_EQ(parser.parse("{\"payloadType\":\"snapshot\"}"), communication::MessageParser::Result::Other);
+    EXPECT_EQ(parser.parse("not json"), communication::MessageParser::Result::Other);
+}
+
+TEST(message_parser_test, fuzz_mutated_snapshots){
+    // Whenever the streaming parser accepts a mutated message, the json conversion has to agree
+    std::mt19937 random(FUZZ_SEED);
+    const std::string alphabet = "{}[]\":,0123456789-.eEtruefalsn xyPos";
+    communication::MessageParser parser;
+    for (unsigned int i = 0; i < MUTATIONS; i++) {
+        auto text = randomMessage(random);
+        std::uniform_int_distribution<std::size_t> index(0, text.size() - 1);
+        auto mutations = std::uniform_int_distribution<int>(1, 4)(random);
+        for (int m = 0; m < mutations && !text.empty(); m++) {
+            auto at = index(random) % text.size();
+            switch (std::uniform_int_distribution<int>(0, 2)(random)) {
+                case 0:
+                    text[at] = alphabet[std::uniform_int_distribution<std::size_t>(0, alphabet.size() - 1)(random)];
+                    break;
+                case 1:
+                    text.erase(at, 1);
+                    break;
+                default:
+                    text.insert(at, text.substr(index(random) % text.size(), 8));
+                    break;
+            }
+        }
+
+        auto expected = parseDom(text);
+        if (parser.parse(text) == communication::MessageParser::Result::Snapshot) {
+            ASSERT_TRUE(expected.has_value()) << text;
+            EXPECT_EQ(parser.getSnapshot(), *expected) << text;
+        }
+    }
+}
@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cctype>
+#include <Communication/MessageWriter.hpp>
+
+namespace {
+    auto createDeltaRequests() -> std::vector<communication::messages::request::DeltaRequest> {
+        using namespace communication::messages;
+        return {
+            request::DeltaRequest{types::DeltaType::MOVE, std::nullopt, std::nullopt, std::nullopt, 3, 12,
+                                  types::EntityId::RIGHT_SEEKER, std::nullopt, std::nullopt, std::nullopt,
+                                  std::nullopt, std::nullopt, std::nullopt},
+            request::DeltaRequest{types::DeltaType::BLUDGER_BEATING, true, 4, 5, -1, 0,
+                                  types::EntityId::LEFT_BEATER1, types::EntityId::BLUDGER2,
+                                  types::PhaseType::PLAYER_PHASE, 30, 120, 17, types::BanReason::STOOGING},
+            request::DeltaRequest{types::DeltaType::SKIP, std::nullopt, std::nullopt, std::nullopt, std::nullopt,
+                                  std::nullopt, types::EntityId::LEFT_KEEPER, std::nullopt, std::nullopt,
+                                  std::nullopt, std::nullopt, std::nullopt, std::nullopt}
+        };
+    }
+}
+
+TEST(message_writer_test, compact_matches_json){
+    communication::MessageWriter writer;
+    for(const auto &deltaRequest : createDeltaRequests()){
+        communication::messages::Message message{deltaRequest};
+        nlohmann::json expected = message;
+        const auto &serialized = writer.write(message);
+        // The only whitespace is the one inside the timestamp
+        EXPECT_EQ(std::count_if(serialized.begin(), serialized.end(), [](char c){ return std::isspace(c); }), 1);
+        auto parsed = nlohmann::json::parse(serialized);
+        EXPECT_EQ(parsed["payload"], expected["payload"]);
+        EXPECT_EQ(parsed["payloadType"], expected["payloadType"]);
+        EXPECT_EQ(parsed["timestamp"].get<std::string>().size(), std::string{"yyyy-MM-dd HH:mm:ss.SSS"}.size());
+    }
+}
+
+TEST(message_writer_test, pretty_print_is_opt_in){
+    communication::messages::Message message{createDeltaRequests().front()};
+    communication::MessageWriter compact;
+    communication::MessageWriter pretty{true};
+    EXPECT_EQ(compact.write(message).find('\n'), std::string::npos);
+    EXPECT_NE(pretty.write(message).find('\n'), std::string::npos);
+    EXPECT_EQ(nlohmann::json::parse(pretty.write(message))["payload"],
+              nlohmann::json::parse(compact.write(message))["payload"]);
+}
+
+TEST(message_writer_test, buffer_is_reused){
+    communication::MessageWriter writer;
+    auto deltaRequests = createDeltaRequests();
+    const auto *data = writer.write(communication::messages::Message{deltaRequests.front()}).data();
+    for(const auto &deltaRequest : deltaRequests){
+        EXPECT_EQ(writer.write(communication::messages::Message{deltaRequest}).data(), data);
+    }
+}
@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+#include <Game/MoveOrdering.hpp>
+
+namespace {
+    using communication::messages::types::DeltaType;
+    using communication::messages::types::EntityId;
+
+    auto action(DeltaType type, EntityId entity, gameModel::Position target) -> ai::Successor {
+        return {{type, std::nullopt, std::nullopt, std::nullopt, target.x, target.y, entity, std::nullopt,
+                 std::nullopt, std::nullopt, std::nullopt, std::nullopt, std::nullopt}, {}};
+    }
+
+    auto createState() -> ai::SearchState {
+        ai::SearchState state{};
+        for (std::size_t i = 0; i < ai::PLAYER_COUNT; i++) {
+            state.players[i] = ai::toCell({static_cast<int>(i % 7) + 4, static_cast<int>(i / 7) * 6 + 2});
+        }
+
+        state.players[ai::CHASER_OFFSET] = ai::toCell({8, 6});
+        state.quaffle = ai::toCell({8, 6});
+        state.bludgers = {ai::NO_CELL, ai::NO_CELL};
+        state.snitch = ai::NO_CELL;
+        return state;
+    }
+}
+
+TEST(move_ordering_test, tactical_moves_first){
+    auto state = createState();
+    ai::Successors successors{action(DeltaType::MOVE, EntityId::LEFT_SEEKER, {3, 3}),
+                              action(DeltaType::MOVE, EntityId::LEFT_CHASER1, {9, 6}),
+                              action(DeltaType::QUAFFLE_THROW, EntityId::LEFT_CHASER1, {14, 6})};
+    ai::MoveOrdering ordering;
+    EXPECT_EQ(ordering.order(state, successors, std::nullopt, 0), (ai::ArenaVector<std::size_t>{2, 1, 0}));
+    EXPECT_EQ(ordering.order(state, successors, 0, 0), (ai::ArenaVector<std::size_t>{0, 2, 1}));
+}
+
+TEST(move_ordering_test, killers_per_ply){
+    auto state = createState();
+    ai::Successors successors{action(DeltaType::MOVE, EntityId::LEFT_SEEKER, {3, 3}),
+                              action(DeltaType::MOVE, EntityId::LEFT_KEEPER, {3, 6})};
+    ai::MoveOrdering ordering;
+    ordering.onCutoff(state, successors[1], 2, 1);
+    EXPECT_EQ(ordering.order(state, successors, std::nullopt, 2), (ai::ArenaVector<std::size_t>{1, 0}));
+
+    // Other plies only see the history score, which is lost when a new search halves it
+    ordering.onCutoff(state, successors[0], 3, 1);
+    ordering.newSearch();
+    EXPECT_EQ(ordering.order(state, successors, std::nullopt, 2), (ai::ArenaVector<std::size_t>{0, 1}));
+}
+
+TEST(move_ordering_test, history_orders_quiet_moves){
+    auto state = createState();
+    ai::Successors successors{action(DeltaType::MOVE, EntityId::LEFT_SEEKER, {3, 3}),
+                              action(DeltaType::MOVE, EntityId::LEFT_KEEPER, {3, 6})};
+    ai::MoveOrdering ordering;
+    ordering.onCutoff(state, successors[1], 5, 4);
+    EXPECT_EQ(ordering.order(state, successors, std::nullopt, 1), (ai::ArenaVector<std::size_t>{1, 0}));
+}
@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+#include <Game/OccupancyGrid.hpp>
+#include <Game/AI.h>
+#include <SopraGameLogic/conversions.h>
+#include "setup.h"
+
+TEST(occupancy_grid_test, lookup_matches_env){
+    auto env = setup::createEnv();
+    ai::OccupancyGrid grid(*env);
+    for (const auto &player : env->getAllPlayers()) {
+        EXPECT_EQ(grid.playerAt(player->position), player->getId());
+    }
+
+    EXPECT_FALSE(grid.playerAt(gameModel::Position{8, 6}).has_value());
+    EXPECT_FALSE(grid.playerAt(ai::NO_CELL).has_value());
+}
+
+TEST(occupancy_grid_test, update_moves_and_bans){
+    auto env = setup::createEnv();
+    ai::OccupancyGrid grid(*env);
+    auto oldPosition = env->team1->keeper->position;
+    env->team1->keeper->position = {8, 6};
+    env->team2->seeker->isFined = true;
+    EXPECT_FALSE(grid.update(*env).has_value());
+    EXPECT_FALSE(grid.playerAt(oldPosition).has_value());
+    EXPECT_EQ(grid.playerAt(gameModel::Position{8, 6}), env->team1->keeper->getId());
+    EXPECT_FALSE(grid.playerAt(env->team2->seeker->position).has_value());
+}
+
+TEST(occupancy_grid_test, update_allows_swaps_and_reports_collisions){
+    auto env = setup::createEnv();
+    ai::OccupancyGrid grid(*env);
+    std::swap(env->team1->chasers[0]->position, env->team2->chasers[0]->position);
+    EXPECT_FALSE(grid.update(*env).has_value());
+    EXPECT_EQ(grid.playerAt(env->team1->chasers[0]->position), env->team1->chasers[0]->getId());
+
+    env->team1->beaters[0]->position = env->team2->keeper->position;
+    auto collision = grid.update(*env);
+    ASSERT_TRUE(collision.has_value());
+    EXPECT_EQ(ai::playerIds[collision->first], env->team2->keeper->getId());
+    EXPECT_EQ(ai::playerIds[collision->second], env->team1->beaters[0]->getId());
+}
+
+TEST(occupancy_grid_test, team_has_quaffle){
+    auto env = setup::createEnv();
+    for (const auto &holder : env->getAllPlayers()) {
+        env->quaffle->position = holder->position;
+        ai::OccupancyGrid grid(*env);
+        auto side = gameLogic::conversions::idToSide(holder->getId());
+        EXPECT_TRUE(ai::teamHasQuaffle(grid, *env, side));
+        EXPECT_FALSE(ai::teamHasQuaffle(grid, *env, side == gameModel::TeamSide::LEFT ?
+                                                     gameModel::TeamSide::RIGHT : gameModel::TeamSide::LEFT));
+        EXPECT_TRUE(ai::teamHasQuaffle(env, holder));
+    }
+
+    env->quaffle->position = {8, 6};
+    EXPECT_FALSE(ai::teamHasQuaffle(ai::OccupancyGrid(*env), *env, gameModel::TeamSide::LEFT));
+    EXPECT_FALSE(ai::teamHasQuaffle(ai::OccupancyGrid(*env), *env, gameModel::TeamSide::RIGHT));
+    EXPECT_FALSE(ai::teamHasQuaffle(env, env->team1->keeper));
+    EXPECT_FALSE(ai::teamHasQuaffle(env, env->team2->keeper));
+}
@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <Game/OpeningBook.hpp>
+#include "setup.h"
+
+namespace {
+    auto move(communication::messages::types::EntityId id, int x, int y) ->
+            communication::messages::request::DeltaRequest {
+        return {communication::messages::types::DeltaType::MOVE, std::nullopt, std::nullopt, std::nullopt, x, y, id,
+                std::nullopt, std::nullopt, std::nullopt, std::nullopt, std::nullopt, std::nullopt};
+    }
+}
+
+TEST(opening_book_test, write_and_probe){
+    using namespace communication::messages;
+    auto path = std::filesystem::temp_directory_path() / "ki_opening_book_test.bin";
+    auto id = types::EntityId::LEFT_CHASER1;
+    request::TeamFormation formation{1, 2, 3, 4, 5, 6, 7, 8, 2, 10, 4, 11, 6, 12};
+    ai::OpeningBook::Builder builder;
+    builder.addFormation(1, formation, 0);
+    builder.addMove(2, move(id, 3, 3), -10);
+    builder.addMove(2, move(id, 4, 4), 10);
+    builder.addMove(2, move(id, 4, 4), 20);
+    builder.addMove(3, move(id, 5, 5), 0);
+    EXPECT_EQ(builder.write(path.string()), 3u);
+
+    ai::OpeningBook book(path.string());
+    EXPECT_EQ(book.size(), 3u);
+    auto bookFormation = book.probeFormation(1);
+    ASSERT_TRUE(bookFormation.has_value());
+    EXPECT_EQ(bookFormation->getSeekerX(), 1);
+    EXPECT_EQ(bookFormation->getKeeperY(), 4);
+    EXPECT_EQ(bookFormation->getChaser3X(), 2);
+    EXPECT_EQ(bookFormation->getBeater2Y(), 12);
+
+    auto bookMove = book.probeMove(2);
+    ASSERT_TRUE(bookMove.has_value());
+    EXPECT_TRUE(ai::OpeningBook::sameAction(*bookMove, move(id, 4, 4)));
+    EXPECT_FALSE(ai::OpeningBook::sameAction(*bookMove, move(id, 3, 3)));
+    EXPECT_FALSE(book.probeMove(4).has_value());
+    std::filesystem::remove(path);
+}
+
+TEST(opening_book_test, rejects_invalid_files){
+    auto path = std::filesystem::temp_directory_path() / "ki_opening_book_invalid.bin";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "not an opening book";
+    }
+
+    EXPECT_THROW(ai::OpeningBook{path.string()}, std::runtime_error);
+    std::filesystem::remove(path);
+    EXPECT_THROW(ai::OpeningBook{path.string()}, std::runtime_error);
+}
+
+TEST(opening_book_test, keys_depend_on_brooms){
+    using namespace communication::messages::types;
+    auto state = setup::createState();
+    auto brooms = ai::OpeningBook::broomsOf(*state.env);
+    auto otherBrooms = brooms;
+    otherBrooms[0] = brooms[0] == Broom::FIREBOLT ? Broom::NIMBUS2001 : Broom::FIREBOLT;
+    auto searchState = ai::SearchState::fromState(state);
+    aiTools::ActionState turn{EntityId::LEFT_SEEKER, aiTools::ActionState::TurnState::FirstMove};
+    EXPECT_NE(ai::OpeningBook::moveKey(searchState, turn, brooms),
+              ai::OpeningBook::moveKey(searchState, turn, otherBrooms));
+    EXPECT_NE(ai::OpeningBook::formationKey(gameModel::TeamSide::LEFT, brooms),
+              ai::OpeningBook::formationKey(gameModel::TeamSide::RIGHT, brooms));
+}
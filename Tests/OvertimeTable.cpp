@@ -0,0 +1,40 @@
+#include <gtest/gtest.h>
+#include <Game/OvertimeTable.hpp>
+
+namespace {
+    const auto centre = ai::toCell({8, 6});
+}
+
+TEST(overtime_table_test, stationary_snitch_is_shortest_path){
+    EXPECT_EQ(ai::catchDistance(ai::toCell({2, 6}), centre, false), 6);
+    EXPECT_EQ(ai::catchDistance(ai::toCell({2, 6}), centre, true), 7);
+    EXPECT_EQ(ai::catchDistance(ai::toCell({9, 7}), centre, false), 1);
+    EXPECT_EQ(ai::catchDistance(centre, centre, true), 0);
+}
+
+TEST(overtime_table_test, snitch_flies_to_centre){
+    EXPECT_EQ(ai::snitchStep(centre), centre);
+    EXPECT_EQ(ai::snitchStep(ai::toCell({2, 2})), ai::toCell({3, 3}));
+    EXPECT_EQ(ai::snitchStep(ai::toCell({8, 10})), ai::toCell({8, 9}));
+
+    // The snitch can't fly onto the seeker, it stops next to it and is caught in the following turn
+    auto snitch = ai::toCell({14, 6});
+    EXPECT_EQ(ai::catchDistance(centre, snitch, false), 4);
+    EXPECT_EQ(ai::catchDistance(ai::toCell({12, 6}), snitch, false), 2);
+    EXPECT_EQ(ai::catchDistance(ai::toCell({13, 6}), snitch, false), 1);
+}
+
+TEST(overtime_table_test, catch_step){
+    ai::CellSet blocked{};
+    EXPECT_EQ(ai::catchStep(ai::toCell({9, 7}), centre, blocked), centre);
+
+    auto step = ai::catchStep(ai::toCell({5, 6}), centre, blocked);
+    ASSERT_TRUE(step.has_value());
+    EXPECT_EQ(ai::catchDistance(*step, centre, false), 2);
+
+    for(auto cell : {ai::toCell({6, 5}), ai::toCell({6, 6}), ai::toCell({6, 7})}){
+        blocked.set(cell);
+    }
+
+    EXPECT_FALSE(ai::catchStep(ai::toCell({5, 6}), centre, blocked).has_value());
+}
@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include <Game/PathTable.hpp>
+#include "setup.h"
+
+TEST(path_table_test, distances_without_obstacles){
+    ai::PathTable table;
+    auto from = ai::toCell({3, 6});
+    auto to = ai::toCell({8, 6});
+    EXPECT_EQ(table.distance(from, to), 5);
+    EXPECT_EQ(table.distance(to, from), 5);
+    EXPECT_EQ(table.distance(from, from), 0);
+    EXPECT_EQ(table.distance(from, ai::NO_CELL), ai::PathTable::UNREACHABLE);
+
+    auto path = table.path(from, to);
+    ASSERT_EQ(path.size(), 6u);
+    EXPECT_EQ(path.front(), (gameModel::Position{8, 6}));
+    EXPECT_EQ(path.back(), (gameModel::Position{3, 6}));
+}
+
+TEST(path_table_test, obstacles_and_invalidation){
+    ai::PathTable table;
+    auto from = ai::toCell({3, 6});
+    auto to = ai::toCell({5, 6});
+    ai::CellSet wall{};
+    for(int y = 3; y <= 9; y++){
+        wall.set(ai::toCell({4, y}));
+    }
+
+    EXPECT_FALSE(table.update({}));
+    EXPECT_TRUE(table.update(wall));
+    EXPECT_FALSE(table.update(wall));
+    EXPECT_EQ(table.distance(from, to), 8);
+    EXPECT_EQ(table.distance(from, ai::toCell({4, 6})), ai::PathTable::UNREACHABLE);
+
+    auto step = table.nextStep(from, to);
+    ASSERT_TRUE(step.has_value());
+    EXPECT_EQ(table.distance(*step, to), 7);
+}
+
+TEST(path_table_test, next_step_avoids_blocked_cells){
+    ai::PathTable table;
+    auto from = ai::toCell({3, 6});
+    auto to = ai::toCell({6, 6});
+    ai::CellSet blocked{};
+    blocked.set(ai::toCell({4, 6}));
+    auto step = table.nextStep(from, to, blocked);
+    ASSERT_TRUE(step.has_value());
+    EXPECT_NE(*step, ai::toCell({4, 6}));
+    EXPECT_EQ(table.distance(*step, to), 2);
+
+    blocked.set(ai::toCell({4, 5}));
+    blocked.set(ai::toCell({4, 7}));
+    EXPECT_FALSE(table.nextStep(from, to, blocked).has_value());
+    EXPECT_EQ(table.nextStep(ai::toCell({5, 6}), to, blocked), to);
+}
+
+TEST(path_table_test, obstacles_of_environment){
+    auto env = setup::createEnv();
+    env->pileOfShit.emplace_back(std::make_shared<gameModel::CubeOfShit>(gameModel::Position{8, 6}));
+    auto obstacles = ai::PathTable::obstaclesOf(*env);
+    EXPECT_TRUE(obstacles.test(ai::toCell({8, 6})));
+    EXPECT_FALSE(ai::PathTable(obstacles).nextStep(ai::toCell({7, 6}), ai::toCell({9, 6})) == ai::toCell({8, 6}));
+}
+
+TEST(path_table_test, shortest_distance_matches_table){
+    ai::CellSet obstacles{};
+    for(int y = 3; y <= 9; y++){
+        obstacles.set(ai::toCell({4, y}));
+    }
+
+    obstacles.set(ai::toCell({9, 5}));
+    ai::PathTable table(obstacles);
+    for(std::size_t from = 0; from < ai::CELL_COUNT; from += 7){
+        for(std::size_t to = 0; to < ai::CELL_COUNT; to++){
+            EXPECT_EQ(ai::PathTable::shortestDistance(static_cast<ai::Cell>(from), static_cast<ai::Cell>(to), obstacles),
+                      table.distance(static_cast<ai::Cell>(from), static_cast<ai::Cell>(to)));
+        }
+    }
+
+    EXPECT_EQ(ai::PathTable::shortestDistance(ai::toCell({3, 6}), ai::NO_CELL, obstacles), ai::PathTable::UNREACHABLE);
+}
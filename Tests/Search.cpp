@@ -0,0 +1,226 @@
+#include <gtest/gtest.h>
+#include <Game/AI.h>
+#include <Game/Search.hpp>
+#include <Game/Zobrist.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
+#include <SopraGameLogic/conversions.h>
+#include "setup.h"
+
+namespace {
+    const aiTools::ActionState ACTION_STATE(communication::messages::types::EntityId::LEFT_CHASER2,
+                                            aiTools::ActionState::TurnState::Action);
+
+    bool isPossible(const aiTools::State &state, const communication::messages::request::DeltaRequest &action,
+                    const aiTools::ActionState &actionState = ACTION_STATE) {
+        for (const auto &successor : aiTools::expandState(state, actionState)) {
+            if (successor.first == action) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    constexpr ai::EvalBounds UNIT_BOUNDS{-1, 1};
+
+    /**
+     * evalState scaled far beyond UNIT_BOUNDS, so almost every leaf is clamped
+     */
+    double scaledEval(const ai::SearchState &state, const ai::SearchContext &context, gameModel::TeamSide mySide) {
+        return 1e6 * ai::evalState(state, context, mySide);
+    }
+
+    double clampedScaledEval(const ai::SearchState &state, const ai::SearchContext &context,
+                             gameModel::TeamSide mySide) {
+        return std::clamp(scaledEval(state, context, mySide), UNIT_BOUNDS.lower, UNIT_BOUNDS.upper);
+    }
+
+    auto search(ai::ChancePruning pruning, unsigned int depth, ai::LeafEval leafEval = nullptr,
+                ai::EvalBounds bounds = ai::SIMPLE_EVAL_BOUNDS) -> ai::SearchResult {
+        auto state = setup::createState(true);
+        ai::SearchContext context(state.env);
+        ai::TranspositionTable table;
+        ai::Search search(context, gameModel::TeamSide::LEFT, table);
+        search.setLeafEval(leafEval);
+        search.setChancePruning(pruning, bounds);
+        const std::atomic_bool abort = false;
+        return search.computeBestAction(ai::SearchState::fromState(state), ACTION_STATE, abort, depth, depth);
+    }
+
+    /**
+     * Ponders the turns of the left team as the right team until one of them is predicted to be followed by a turn of
+     * the right team
+     * @return the opponent's turn and the result of pondering it
+     */
+    auto ponderOpponent(ai::Search &search, const ai::SearchState &root, const std::atomic_bool &stop)
+        -> std::optional<std::pair<aiTools::ActionState, ai::PonderResult>> {
+        using ID = communication::messages::types::EntityId;
+        for (auto turnState : {aiTools::ActionState::TurnState::Action, aiTools::ActionState::TurnState::FirstMove}) {
+            for (auto id : {ID::LEFT_CHASER2, ID::LEFT_CHASER1, ID::LEFT_CHASER3, ID::LEFT_KEEPER, ID::LEFT_BEATER1,
+                            ID::LEFT_BEATER2, ID::LEFT_SEEKER}) {
+                aiTools::ActionState turn(id, turnState);
+                if (auto result = search.ponder(root, turn, stop, 1, 2)) {
+                    return std::make_pair(turn, *result);
+                }
+            }
+        }
+
+        return std::nullopt;
+    }
+}
+
+TEST(search_test, star_pruning_keeps_the_value){
+    for (auto pruning : {ai::ChancePruning::Star1, ai::ChancePruning::Star2}) {
+        unsigned long cutoffs = 0;
+        for (unsigned int depth = 1; depth <= 3; depth++) {
+            auto expected = search(ai::ChancePruning::None, depth);
+            auto result = search(pruning, depth);
+            EXPECT_NEAR(result.score, expected.score, 1e-6);
+            EXPECT_LE(result.expansions, expected.expansions);
+            EXPECT_EQ(expected.stats.chanceCutoffs, 0);
+            cutoffs += result.stats.chanceCutoffs;
+        }
+
+        EXPECT_GT(cutoffs, 0);
+    }
+}
+
+TEST(search_test, star_pruning_clamps_to_the_bounds){
+    const unsigned int depth = 2;
+    auto unclamped = search(ai::ChancePruning::None, depth, scaledEval);
+    auto expected = search(ai::ChancePruning::None, depth, clampedScaledEval);
+    ASSERT_GT(std::abs(unclamped.score), UNIT_BOUNDS.upper);
+    for (auto pruning : {ai::ChancePruning::Star1, ai::ChancePruning::Star2}) {
+        auto result = search(pruning, depth, scaledEval, UNIT_BOUNDS);
+        EXPECT_GE(result.score, UNIT_BOUNDS.lower);
+        EXPECT_LE(result.score, UNIT_BOUNDS.upper);
+        EXPECT_NEAR(result.score, expected.score, 1e-6);
+    }
+}
+
+TEST(search_test, parallel_search_merges_helpers){
+    auto state = setup::createState(true);
+    ai::SearchContext context(state.env);
+    auto root = ai::SearchState::fromState(state);
+    const std::atomic_bool abort = false;
+
+    // The main thread stops after the first iteration, which does not expand any node below the root. It waits
+    // until a helper completed an iteration, the timeout only keeps a broken search from hanging the test.
+    std::mutex mutex;
+    std::condition_variable helperDone;
+    unsigned int helperDepth = 0;
+    auto stopAfterFirst = [&](const ai::SearchResult &) {
+        std::unique_lock<std::mutex> lock(mutex);
+        helperDone.wait_for(lock, std::chrono::minutes(5), [&helperDepth] { return helperDepth >= 2; });
+        return false;
+    };
+
+    ai::TranspositionTable singleTable;
+    auto single = ai::Search(context, gameModel::TeamSide::LEFT, singleTable)
+            .computeBestAction(root, ACTION_STATE, abort, 1, 3, [](const ai::SearchResult &) { return false; });
+    EXPECT_EQ(single.depth, 1);
+    EXPECT_EQ(single.expansions, 1);
+
+    // The helpers start at depth 2 and 3 and keep searching while the main thread waits
+    ai::TranspositionTable table;
+    ai::Search search(context, gameModel::TeamSide::LEFT, table, 3);
+    search.setHelperCallback([&](const ai::SearchResult &iteration) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            helperDepth = std::max(helperDepth, iteration.depth);
+        }
+
+        helperDone.notify_all();
+        return true;
+    });
+    auto parallel = search.computeBestAction(root, ACTION_STATE, abort, 1, 3, stopAfterFirst);
+    ASSERT_GE(helperDepth, 2);
+    EXPECT_TRUE(isPossible(state, parallel.action));
+    EXPECT_GE(parallel.depth, 2);
+    EXPECT_GT(parallel.expansions, single.expansions);
+    EXPECT_GT(parallel.stats.evals, single.stats.evals);
+    EXPECT_GT(parallel.stats.children, single.stats.children);
+}
+
+TEST(search_test, ponder_hit_reuses_result){
+    auto state = setup::createState(true);
+    ai::SearchContext context(state.env);
+    auto root = ai::SearchState::fromState(state);
+    const std::atomic_bool stop = false;
+    ai::TranspositionTable table;
+    ai::Search search(context, gameModel::TeamSide::RIGHT, table);
+    auto pondered = ponderOpponent(search, root, stop);
+    ASSERT_TRUE(pondered.has_value());
+    auto [opponentTurn, ponderResult] = *pondered;
+    EXPECT_GE(ponderResult.result.depth, 1);
+
+    // The key belongs to one of the outcomes of the opponent's turn that is followed by a turn of the right team
+    std::optional<ai::Outcome> predicted;
+    for (const auto &successor : ai::expand(root, context, opponentTurn)) {
+        for (const auto &outcome : successor.outcomes) {
+            if (outcome.next.has_value() && ai::nodeKey(outcome.state, *outcome.next) == ponderResult.key) {
+                predicted = outcome;
+            }
+        }
+    }
+
+    ASSERT_TRUE(predicted.has_value());
+    EXPECT_EQ(gameLogic::conversions::idToSide(predicted->next->id), gameModel::TeamSide::RIGHT);
+    EXPECT_TRUE(isPossible(predicted->state.toState(context), ponderResult.result.action, *predicted->next));
+
+    std::optional<ai::PonderResult> stored = ponderResult;
+    auto hit = ai::takePonderResult(stored, predicted->state, *predicted->next);
+    ASSERT_TRUE(hit.has_value());
+    EXPECT_EQ(hit->action, ponderResult.result.action);
+    EXPECT_EQ(hit->depth, ponderResult.result.depth);
+    EXPECT_FALSE(stored.has_value());
+}
+
+TEST(search_test, ponder_miss_searches){
+    auto state = setup::createState(true);
+    ai::SearchContext context(state.env);
+    auto root = ai::SearchState::fromState(state);
+    const std::atomic_bool stop = false;
+    ai::TranspositionTable table;
+    ai::Search search(context, gameModel::TeamSide::RIGHT, table);
+    auto pondered = ponderOpponent(search, root, stop);
+    ASSERT_TRUE(pondered.has_value());
+
+    // The opponent's turn itself is never the predicted one
+    std::optional<ai::PonderResult> stored = pondered->second;
+    EXPECT_FALSE(ai::takePonderResult(stored, root, pondered->first).has_value());
+    EXPECT_FALSE(stored.has_value());
+    EXPECT_FALSE(ai::takePonderResult(stored, root, pondered->first).has_value());
+
+    ai::Search fallback(context, gameModel::TeamSide::LEFT, table);
+    auto result = fallback.computeBestAction(root, ACTION_STATE, stop, 1, 2);
+    EXPECT_EQ(result.depth, 2);
+    EXPECT_TRUE(isPossible(state, result.action));
+}
+
+TEST(search_test, ponder_stops_before_completion){
+    auto state = setup::createState(true);
+    ai::SearchContext context(state.env);
+    auto root = ai::SearchState::fromState(state);
+    ai::TranspositionTable table;
+    ai::Search search(context, gameModel::TeamSide::RIGHT, table);
+
+    // Stopped before the opponent's action is predicted
+    const std::atomic_bool stopped = true;
+    EXPECT_FALSE(search.ponder(root, ACTION_STATE, stopped, 1, 10).has_value());
+
+    // Stopped after the first iteration of the reply, the aborted second one is discarded
+    std::atomic_bool stop = false;
+    auto pondered = ponderOpponent(search, root, stop);
+    ASSERT_TRUE(pondered.has_value());
+    auto result = search.ponder(root, pondered->first, stop, 1, 10, [&stop](const ai::SearchResult &) {
+        stop = true;
+        return true;
+    });
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(result->result.depth, 1);
+}
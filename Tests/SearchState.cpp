@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include <Game/AI.h>
+#include <Game/SearchState.hpp>
+#include <Game/IncrementalEval.hpp>
+#include <Game/Zobrist.hpp>
+#include "setup.h"
+
+//-------------------------------------conversion-----------------------------------------------------------------------
+
+TEST(search_state_test, cell_position_round_trip){
+    for(std::size_t cell = 0; cell < ai::CELL_COUNT; cell++){
+        EXPECT_EQ(ai::toCell(ai::toPosition(static_cast<ai::Cell>(cell))), cell);
+    }
+
+    EXPECT_EQ(ai::toCell({ai::FIELD_WIDTH, 0}), ai::NO_CELL);
+}
+
+TEST(search_state_test, state_round_trip){
+    auto state = setup::createState();
+    state.env->team1->chasers[1]->knockedOut = true;
+    state.env->team2->beaters[0]->isFined = true;
+    state.env->pileOfShit.emplace_back(std::make_shared<gameModel::CubeOfShit>(gameModel::Position{4, 4}));
+    state.playersUsedLeft.emplace(communication::messages::types::EntityId::LEFT_KEEPER);
+    state.goalScoredThisRound = true;
+    ai::SearchContext context(state.env);
+
+    auto flat = ai::SearchState::fromState(state);
+    auto restored = flat.toState(context);
+    EXPECT_EQ(ai::SearchState::fromState(restored), flat);
+    EXPECT_TRUE(restored.env->team1->chasers[1]->knockedOut);
+    EXPECT_TRUE(restored.env->team2->beaters[0]->isFined);
+    EXPECT_EQ(restored.env->pileOfShit.size(), 1);
+    EXPECT_EQ(restored.playersUsedLeft.size(), 1);
+    EXPECT_TRUE(restored.goalScoredThisRound);
+}
+
+TEST(search_state_test, copy_is_independent){
+    auto flat = ai::SearchState::fromState(setup::createState());
+    auto copy = flat;
+    copy.players[0] = 0;
+    copy.scores[1] = 30;
+    EXPECT_NE(flat, copy);
+}
+
+//-------------------------------------eval-----------------------------------------------------------------------------
+
+TEST(search_state_test, simple_eval_matches_environment){
+    auto state = setup::createState();
+    ai::SearchContext context(state.env);
+    for(auto side : {gameModel::TeamSide::LEFT, gameModel::TeamSide::RIGHT}){
+        auto flat = ai::SearchState::fromState(state);
+        EXPECT_DOUBLE_EQ(ai::simpleEval(flat, context, side), ai::simpleEval(state, side));
+    }
+}
+
+TEST(search_state_test, simple_eval_matches_environment_with_quaffle_held){
+    auto state = setup::createState();
+    state.env->quaffle->position = state.env->team2->keeper->position;
+    state.env->team1->score = 40;
+    ai::SearchContext context(state.env);
+    for(auto side : {gameModel::TeamSide::LEFT, gameModel::TeamSide::RIGHT}){
+        auto flat = ai::SearchState::fromState(state);
+        EXPECT_DOUBLE_EQ(ai::simpleEval(flat, context, side), ai::simpleEval(state, side));
+    }
+}
+
+TEST(search_state_test, incremental_eval_matches_full){
+    auto state = setup::createState();
+    ai::SearchContext context(state.env);
+    auto parent = ai::SearchState::fromState(state);
+    state.env->team1->chasers[0]->position = state.env->quaffle->position;
+    state.env->team1->seeker->position = {8, 2};
+    state.env->snitch->position = {9, 2};
+    state.env->team2->beaters[1]->knockedOut = true;
+    state.env->team1->keeper->isFined = true;
+    auto child = ai::SearchState::fromState(state, parent);
+    for(auto side : {gameModel::TeamSide::LEFT, gameModel::TeamSide::RIGHT}){
+        ai::IncrementalEval eval(parent, context, side);
+        eval.update(parent, child);
+        EXPECT_TRUE(eval == ai::IncrementalEval(child, context, side));
+        EXPECT_DOUBLE_EQ(eval.value(child), ai::simpleEval(state, side));
+    }
+}
+
+TEST(search_state_test, incremental_eval_matches_full_in_overtime){
+    auto state = setup::createState();
+    state.overtimeState = gameController::ExcessLength::Stage3;
+    state.env->snitch->exists = true;
+    state.env->snitch->position = {8, 6};
+    ai::SearchContext context(state.env);
+    auto parent = ai::SearchState::fromState(state);
+    state.env->team1->seeker->knockedOut = true;
+    state.env->team2->seeker->position = {10, 8};
+    auto child = ai::SearchState::fromState(state, parent);
+    for(auto side : {gameModel::TeamSide::LEFT, gameModel::TeamSide::RIGHT}){
+        ai::IncrementalEval eval(parent, context, side);
+        eval.update(parent, child);
+        EXPECT_TRUE(eval == ai::IncrementalEval(child, context, side));
+        EXPECT_DOUBLE_EQ(eval.value(child), ai::simpleEval(state, side));
+    }
+}
+
+//-------------------------------------zobrist--------------------------------------------------------------------------
+
+TEST(search_state_test, zobrist_incremental_matches_full){
+    auto state = setup::createState();
+    auto parent = ai::SearchState::fromState(state);
+    state.env->team1->chasers[0]->position = {3, 10};
+    state.env->quaffle->position = {3, 10};
+    state.env->team2->seeker->knockedOut = true;
+    state.playersUsedRight.emplace(communication::messages::types::EntityId::RIGHT_SEEKER);
+    state.env->pileOfShit.emplace_back(std::make_shared<gameModel::CubeOfShit>(gameModel::Position{8, 8}));
+    auto child = ai::SearchState::fromState(state, parent);
+    EXPECT_EQ(child.key, ai::zobristKey(child));
+    EXPECT_NE(child.key, parent.key);
+}
+
+TEST(search_state_test, zobrist_key_depends_on_turn){
+    using ID = communication::messages::types::EntityId;
+    auto flat = ai::SearchState::fromState(setup::createState());
+    aiTools::ActionState first(ID::LEFT_CHASER1, aiTools::ActionState::TurnState::FirstMove);
+    aiTools::ActionState second(ID::LEFT_CHASER1, aiTools::ActionState::TurnState::SecondMove);
+    EXPECT_NE(ai::nodeKey(flat, first), ai::nodeKey(flat, second));
+}
@@ -0,0 +1,42 @@
+#include <gtest/gtest.h>
+#include <Game/AI.h>
+#include <Game/ShotTable.hpp>
+#include "setup.h"
+
+TEST(shot_table_test, highest_goal_rate_matches_simulation){
+    auto env = setup::createEnv();
+    ai::ShotTable shots(env->config);
+    for(const auto &player : {std::shared_ptr<gameModel::Player>(env->team1->chasers[1]),
+                              std::shared_ptr<gameModel::Player>(env->team2->keeper)}){
+        env->quaffle->position = player->position;
+        EXPECT_DOUBLE_EQ(ai::getHighestGoalRate(shots, env, player), ai::getHighestGoalRate(env, player));
+    }
+}
+
+TEST(shot_table_test, hypothetical_shot_matches_simulation){
+    auto env = setup::createEnv();
+    ai::ShotTable shots(env->config);
+    for(const auto &position : {gameModel::Position{8, 6}, gameModel::Position{3, 6}, gameModel::Position{14, 4}}){
+        env->quaffle->position = position;
+        for(auto side : {gameModel::TeamSide::LEFT, gameModel::TeamSide::RIGHT}){
+            EXPECT_DOUBLE_EQ(ai::hypotheticalShotSuccessProb(shots, env, side), ai::hypotheticalShotSuccessProb(env, side));
+        }
+    }
+}
+
+TEST(shot_table_test, shot_from_goal_ring){
+    auto env = setup::createEnv();
+    ai::ShotTable shots(env->config);
+    auto goal = ai::toCell(gameModel::Environment::getGoalsRight()[1]);
+    EXPECT_DOUBLE_EQ(shots.hypotheticalShot(gameModel::TeamSide::LEFT, goal, {}), 1);
+}
+
+TEST(shot_table_test, interceptors_reduce_success){
+    auto env = setup::createEnv();
+    ai::ShotTable shots(env->config);
+    auto source = ai::toCell({8, 6});
+    const auto &entry = shots.entry(gameModel::TeamSide::LEFT, source, ai::GOAL_COUNT - 1);
+    ai::CellSet opponents = entry.interceptCells;
+    EXPECT_LE(shots.successProb(gameModel::TeamSide::LEFT, source, ai::GOAL_COUNT - 1, opponents), entry.baseProb);
+    EXPECT_DOUBLE_EQ(shots.successProb(gameModel::TeamSide::LEFT, source, ai::GOAL_COUNT - 1, {}), entry.baseProb);
+}
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <Game/StateDiff.hpp>
+#include "setup.h"
+
+namespace {
+    constexpr unsigned int SEED = 7;
+    constexpr unsigned int SAMPLES = 50;
+
+    auto frameOf(const aiTools::State &state, communication::messages::types::DeltaType deltaType) ->
+            communication::SnapshotFrame {
+        return communication::SnapshotFrame::fromSnapshot(
+                setup::createSnapshot(state, deltaType, communication::messages::types::EntityId::LEFT_CHASER1));
+    }
+}
+
+TEST(state_diff_test, apply_matches_snapshot){
+    using namespace communication::messages::types;
+    std::mt19937 random(SEED);
+    for (unsigned int i = 0; i < SAMPLES; i++) {
+        auto state = setup::createRandomState(random);
+        auto target = setup::createRandomState(random);
+        ai::StateDiff diff;
+        diff.apply(state, frameOf(target, DeltaType::MOVE));
+        auto result = ai::SearchState::fromState(state);
+        auto expected = ai::SearchState::fromState(target);
+        EXPECT_EQ(result.players, expected.players);
+        EXPECT_EQ(result.knockedOut, expected.knockedOut);
+        EXPECT_EQ(result.banned, expected.banned);
+        EXPECT_EQ(result.quaffle, expected.quaffle);
+        EXPECT_EQ(result.bludgers, expected.bludgers);
+        EXPECT_EQ(bool{result.snitchExists}, bool{expected.snitchExists});
+        if (expected.snitchExists) {
+            EXPECT_EQ(result.snitch, expected.snitch);
+        }
+
+        EXPECT_EQ(result.cubes.bits, expected.cubes.bits);
+        EXPECT_EQ(result.scores, expected.scores);
+        EXPECT_EQ(result.roundNumber, expected.roundNumber);
+        EXPECT_EQ(int{result.phase}, int{expected.phase});
+        EXPECT_EQ(bool{result.goalScoredThisRound}, bool{expected.goalScoredThisRound});
+    }
+}
+
+TEST(state_diff_test, undo_restores_state){
+    using namespace communication::messages::types;
+    std::mt19937 random(SEED);
+    for (auto deltaType : {DeltaType::MOVE, DeltaType::TURN_USED, DeltaType::ROUND_CHANGE}) {
+        for (unsigned int i = 0; i < SAMPLES; i++) {
+            auto original = setup::createRandomState(random);
+            auto state = original.clone();
+            ai::StateDiff diff;
+            diff.apply(state, frameOf(setup::createRandomState(random), deltaType));
+            diff.undo(state);
+            EXPECT_EQ(ai::SearchState::fromState(state), ai::SearchState::fromState(original));
+            EXPECT_EQ(state.playersUsedLeft, original.playersUsedLeft);
+            EXPECT_EQ(state.playersUsedRight, original.playersUsedRight);
+            EXPECT_EQ(state.env->pileOfShit.size(), original.env->pileOfShit.size());
+        }
+    }
+}
+
+TEST(state_diff_test, entities_are_updated_in_place){
+    using namespace communication::messages::types;
+    std::mt19937 random(SEED);
+    auto state = setup::createRandomState(random);
+    state.env->snitch->exists = true;
+    auto seeker = state.env->team1->seeker;
+    auto quaffle = state.env->quaffle;
+    ai::StateDiff diff;
+    diff.apply(state, frameOf(state, DeltaType::MOVE));
+    EXPECT_EQ(diff.changedEntities(), 0u);
+    EXPECT_EQ(diff.getPreviousScore(gameModel::TeamSide::LEFT), state.env->team1->score);
+
+    auto target = state.clone();
+    target.env->team1->seeker->position = {8, 6};
+    target.env->team2->score += 10;
+    diff.apply(state, frameOf(target, DeltaType::MOVE));
+    EXPECT_EQ(diff.changedEntities(), 1u);
+    EXPECT_EQ(state.env->team1->seeker, seeker);
+    EXPECT_EQ(state.env->quaffle, quaffle);
+    EXPECT_EQ(seeker->position, (gameModel::Position{8, 6}));
+    EXPECT_EQ(diff.getPreviousScore(gameModel::TeamSide::RIGHT) + 10, state.env->team2->score);
+}
@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+#include <Util/TelemetryWriter.hpp>
+#include <filesystem>
+#include <fstream>
+
+TEST(telemetry_writer_test, writes_one_line_per_record){
+    auto path = std::filesystem::temp_directory_path() / "ki_telemetry_test.ndjson";
+    std::filesystem::remove(path);
+    {
+        util::TelemetryWriter writer(path.string());
+        for(int i = 0; i < 3; i++){
+            nlohmann::json record;
+            record["depth"] = i;
+            writer.write(record);
+        }
+    }
+
+    std::ifstream file(path);
+    std::string line;
+    int lines = 0;
+    while(std::getline(file, line)){
+        EXPECT_EQ(nlohmann::json::parse(line)["depth"].get<int>(), lines);
+        lines++;
+    }
+
+    EXPECT_EQ(lines, 3);
+    std::filesystem::remove(path);
+}
+
+TEST(telemetry_writer_test, throws_on_missing_socket){
+    EXPECT_THROW(util::TelemetryWriter("unix:/nonexistent/ki.sock"), std::runtime_error);
+}
+
+TEST(telemetry_writer_test, flush_writes_queued_records){
+    auto path = std::filesystem::temp_directory_path() / "ki_telemetry_flush_test.ndjson";
+    std::filesystem::remove(path);
+    util::TelemetryWriter writer(path.string(), 4);
+    for(int i = 0; i < 3; i++){
+        nlohmann::json record;
+        record["depth"] = i;
+        writer.write(record);
+    }
+
+    writer.flush();
+    std::ifstream file(path);
+    std::string line;
+    int lines = 0;
+    while(std::getline(file, line)){
+        lines++;
+    }
+
+    EXPECT_EQ(lines, 3);
+    EXPECT_EQ(writer.getDropped(), 0);
+    std::filesystem::remove(path);
+}
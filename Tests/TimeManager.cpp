@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include <Game/TimeManager.hpp>
+#include "setup.h"
+
+namespace {
+    auto createState() -> aiTools::State {
+        aiTools::State state;
+        state.env = setup::createEnv();
+        state.env->quaffle->position = {8, 6};
+        state.env->snitch->exists = false;
+        return state;
+    }
+
+    auto createResult(int x, double score, bool endsGame = false) -> ai::SearchResult {
+        using namespace communication::messages;
+        request::DeltaRequest action{types::DeltaType::MOVE, std::nullopt, std::nullopt, std::nullopt, x, 6,
+                                     types::EntityId::LEFT_CHASER1, std::nullopt, std::nullopt, std::nullopt,
+                                     std::nullopt, std::nullopt, std::nullopt};
+        return ai::SearchResult{action, 2, 0, score, {}, {}, endsGame};
+    }
+}
+
+TEST(time_manager_test, budget_depends_on_difficulty){
+    auto state = createState();
+    ai::TimeManager strong(0);
+    ai::TimeManager weak(2);
+    auto strongBudget = strong.start(state, 12000);
+    auto weakBudget = weak.start(state, 12000);
+    EXPECT_GT(strongBudget.maximum, weakBudget.maximum);
+    EXPECT_LE(strongBudget.maximum.count(), 12000 - ai::TimeManager::TIMEOUT_TOLERANCE);
+    EXPECT_LE(strongBudget.optimum, strongBudget.maximum);
+}
+
+TEST(time_manager_test, default_difficulty_uses_whole_timeout){
+    ai::TimeManager timeManager(1);
+    auto budget = timeManager.start(createState(), 12000);
+    EXPECT_EQ(budget.maximum.count(), 12000 - ai::TimeManager::TIMEOUT_TOLERANCE);
+    EXPECT_EQ(budget.optimum, budget.maximum);
+}
+
+TEST(time_manager_test, critical_turns_get_more_time){
+    auto state = createState();
+    ai::TimeManager timeManager(2);
+    auto normal = timeManager.start(state, 12000);
+    state.env->quaffle->position = gameModel::Environment::getGoalsRight()[1];
+    EXPECT_TRUE(ai::TimeManager::isCritical(state));
+    auto critical = timeManager.start(state, 12000);
+    EXPECT_GT(critical.maximum, normal.maximum);
+}
+
+TEST(time_manager_test, timeout_below_tolerance){
+    ai::TimeManager timeManager(0);
+    auto budget = timeManager.start(createState(), ai::TimeManager::TIMEOUT_TOLERANCE - 1);
+    EXPECT_EQ(budget.maximum.count(), 0);
+}
+
+TEST(time_manager_test, stops_when_best_action_is_stable){
+    ai::TimeManager timeManager(2);
+    timeManager.start(createState(), 60000);
+    EXPECT_TRUE(timeManager.keepSearching(createResult(9, 1)));
+    EXPECT_TRUE(timeManager.keepSearching(createResult(10, 1)));
+    EXPECT_FALSE(timeManager.keepSearching(createResult(10, 1)));
+}
+
+TEST(time_manager_test, stops_when_game_is_decided){
+    ai::TimeManager timeManager(0);
+    timeManager.start(createState(), 60000);
+    // A large score difference, e.g. from a ban, does not decide the match
+    EXPECT_TRUE(timeManager.keepSearching(createResult(9, gameController::SNITCH_POINTS)));
+    EXPECT_TRUE(timeManager.keepSearching(createResult(10, -gameController::SNITCH_POINTS)));
+    EXPECT_FALSE(timeManager.keepSearching(createResult(11, 1, true)));
+}
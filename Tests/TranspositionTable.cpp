@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+#include <Game/TranspositionTable.hpp>
+
+using Bound = ai::TranspositionTable::Bound;
+
+TEST(transposition_table_test, probe_empty){
+    ai::TranspositionTable table(4);
+    EXPECT_FALSE(table.probe(42).has_value());
+}
+
+TEST(transposition_table_test, store_and_probe){
+    ai::TranspositionTable table(4);
+    table.store(42, {1.5, 3, Bound::Lower, 7});
+    auto entry = table.probe(42);
+    ASSERT_TRUE(entry.has_value());
+    EXPECT_DOUBLE_EQ(entry->score, 1.5);
+    EXPECT_EQ(entry->depth, 3);
+    EXPECT_EQ(entry->bound, Bound::Lower);
+    EXPECT_EQ(entry->bestMove, 7);
+    EXPECT_FALSE(table.probe(42 + 16).has_value());
+}
+
+TEST(transposition_table_test, replace_by_depth){
+    ai::TranspositionTable table(4);
+    table.store(1, {1, 5, Bound::Exact, 0});
+    table.store(17, {2, 2, Bound::Exact, 0});
+    EXPECT_TRUE(table.probe(1).has_value());
+    EXPECT_FALSE(table.probe(17).has_value());
+    table.store(17, {2, 6, Bound::Exact, 0});
+    EXPECT_FALSE(table.probe(1).has_value());
+    EXPECT_TRUE(table.probe(17).has_value());
+}
+
+TEST(transposition_table_test, old_entries_get_replaced){
+    ai::TranspositionTable table(4);
+    table.store(1, {1, 5, Bound::Exact, 0});
+    table.newSearch();
+    table.store(17, {2, 2, Bound::Exact, 0});
+    EXPECT_FALSE(table.probe(1).has_value());
+    EXPECT_TRUE(table.probe(17).has_value());
+}
+
+TEST(transposition_table_test, clear){
+    ai::TranspositionTable table(4);
+    table.store(1, {1, 5, Bound::Exact, 0});
+    table.clear();
+    EXPECT_FALSE(table.probe(1).has_value());
+}
@@ -3,6 +3,66 @@
 //
 
 #include "setup.h"
+#include <nlohmann/json.hpp>
+#include <SopraGameLogic/conversions.h>
+
+namespace {
+    auto position(const gameModel::Position &position) -> nlohmann::json {
+        nlohmann::json ret;
+        ret["xPos"] = position.x;
+        ret["yPos"] = position.y;
+        return ret;
+    }
+
+    auto player(const std::shared_ptr<const gameModel::Player> &player, const aiTools::State &state) -> nlohmann::json {
+        auto ret = position(player->position);
+        const auto &used = gameLogic::conversions::idToSide(player->getId()) == gameModel::TeamSide::LEFT ?
+                           state.playersUsedLeft : state.playersUsedRight;
+        ret["banned"] = player->isFined;
+        ret["knockout"] = player->knockedOut;
+        ret["turnUsed"] = used.find(player->getId()) != used.end();
+        return ret;
+    }
+
+    auto team(const std::shared_ptr<const gameModel::Team> &team, const aiTools::State &state) -> nlohmann::json {
+        constexpr std::array<const char *, 5> fanTypes = {"goblin", "troll", "elf", "niffler", "wombat"};
+        const auto &fanCount = team->getSide() == gameModel::TeamSide::LEFT ?
+                               state.availableFansLeft : state.availableFansRight;
+        std::vector<nlohmann::json> fans;
+        for (std::size_t type = 0; type < fanTypes.size(); type++) {
+            for (unsigned int i = 0; i < fanCount[type]; i++) {
+                nlohmann::json fan;
+                fan["fanType"] = fanTypes[type];
+                fan["banned"] = false;
+                fan["turnUsed"] = false;
+                fans.emplace_back(fan);
+            }
+        }
+
+        const auto &quaffle = state.env->quaffle->position;
+        nlohmann::json players;
+        players["seeker"] = player(team->seeker, state);
+        players["keeper"] = player(team->keeper, state);
+        players["keeper"]["holdsQuaffle"] = team->keeper->position == quaffle;
+        for (std::size_t i = 0; i < team->chasers.size(); i++) {
+            auto name = "chaser" + std::to_string(i + 1);
+            players[name] = player(team->chasers[i], state);
+            players[name]["holdsQuaffle"] = team->chasers[i]->position == quaffle;
+        }
+
+        for (std::size_t i = 0; i < team->beaters.size(); i++) {
+            auto name = "beater" + std::to_string(i + 1);
+            players[name] = player(team->beaters[i], state);
+            players[name]["holdsBludger"] = false;
+        }
+
+        nlohmann::json ret;
+        ret["points"] = team->score;
+        ret["fans"] = fans;
+        ret["players"] = players;
+        return ret;
+    }
+}
 
 auto setup::createEnv() -> std::shared_ptr<gameModel::Environment> {
     return createEnv({0, {}, {}, {}});
@@ -61,4 +121,112 @@ auto setup::createSymmetricEnv() -> std::shared_ptr<gameModel::Environment> {
     return env;
 }
 
+auto setup::createSnapshot(const aiTools::State &state, communication::messages::types::DeltaType deltaType,
+                           std::optional<communication::messages::types::EntityId> activeEntity) ->
+        communication::messages::broadcast::Snapshot {
+    return createSnapshotJson(state, deltaType, activeEntity).get<communication::messages::broadcast::Snapshot>();
+}
+
+auto setup::createSnapshotJson(const aiTools::State &state, communication::messages::types::DeltaType deltaType,
+                               std::optional<communication::messages::types::EntityId> activeEntity) -> nlohmann::json {
+    using namespace communication::messages::types;
+    nlohmann::json delta;
+    delta["deltaType"] = toString(deltaType);
+    if (activeEntity.has_value()) {
+        delta["activeEntity"] = toString(*activeEntity);
+    }
+
+    if (deltaType == DeltaType::ROUND_CHANGE) {
+        delta["round"] = state.roundNumber;
+        delta["phase"] = toString(PhaseType::BALL_PHASE);
+    }
+
+    nlohmann::json balls;
+    balls["quaffle"] = position(state.env->quaffle->position);
+    balls["bludger1"] = position(state.env->bludgers[0]->position);
+    balls["bludger2"] = position(state.env->bludgers[1]->position);
+    balls["snitch"] = position(state.env->snitch->position);
+    if (!state.env->snitch->exists) {
+        balls["snitch"]["xPos"] = nullptr;
+        balls["snitch"]["yPos"] = nullptr;
+    }
+
+    std::vector<nlohmann::json> cubes;
+    for (const auto &cube : state.env->pileOfShit) {
+        cubes.emplace_back(position(cube->position));
+    }
+
+    nlohmann::json snapshot;
+    snapshot["lastDeltaBroadcast"] = delta;
+    snapshot["phase"] = toString(state.currentPhase);
+    snapshot["spectatorUserName"] = std::vector<std::string>{};
+    snapshot["round"] = state.roundNumber;
+    snapshot["leftTeam"] = team(state.env->team1, state);
+    snapshot["rightTeam"] = team(state.env->team2, state);
+    snapshot["balls"] = balls;
+    snapshot["wombatCubes"] = cubes;
+    snapshot["goalWasThrownThisRound"] = state.goalScoredThisRound;
+    return snapshot;
+}
 
+auto setup::createState(bool quaffleHeld) -> aiTools::State {
+    aiTools::State state;
+    state.env = createEnv();
+    if (quaffleHeld) {
+        state.env->quaffle->position = state.env->team1->chasers[1]->position;
+    }
+
+    state.availableFansLeft = {};
+    state.availableFansRight = {};
+    state.playersUsedLeft = {};
+    state.playersUsedRight = {};
+    return state;
+}
+
+auto setup::createRandomState(std::mt19937 &random) -> aiTools::State {
+    using namespace communication::messages::types;
+    std::uniform_int_distribution<int> x(0, 16);
+    std::uniform_int_distribution<int> y(0, 12);
+    std::bernoulli_distribution coin(0.5);
+    std::bernoulli_distribution rare(0.1);
+    std::uniform_int_distribution<unsigned int> fans(0, 3);
+    std::uniform_int_distribution<int> points(0, 120);
+
+    aiTools::State state;
+    state.env = createEnv();
+    for (const auto &player : state.env->getAllPlayers()) {
+        player->position = {x(random), y(random)};
+        player->isFined = rare(random);
+        player->knockedOut = rare(random);
+        if (coin(random)) {
+            (gameLogic::conversions::idToSide(player->getId()) == gameModel::TeamSide::LEFT ?
+             state.playersUsedLeft : state.playersUsedRight).emplace(player->getId());
+        }
+    }
+
+    state.env->quaffle->position = coin(random) ? state.env->team1->chasers[0]->position :
+                                   gameModel::Position{x(random), y(random)};
+    state.env->bludgers[0]->position = {x(random), y(random)};
+    state.env->bludgers[1]->position = {x(random), y(random)};
+    state.env->snitch->exists = coin(random);
+    state.env->snitch->position = {x(random), y(random)};
+    for (unsigned int i = fans(random); i > 0; i--) {
+        state.env->pileOfShit.emplace_back(std::make_shared<gameModel::CubeOfShit>(
+                gameModel::Position{x(random), y(random)}));
+    }
+
+    state.env->team1->score = points(random);
+    state.env->team2->score = points(random);
+    state.roundNumber = std::uniform_int_distribution<unsigned int>(1, 100)(random);
+    state.currentPhase = coin(random) ? PhaseType::PLAYER_PHASE : PhaseType::BALL_PHASE;
+    state.goalScoredThisRound = coin(random);
+    for (auto &fan : state.availableFansLeft) {
+        fan = fans(random);
+    }
+
+    for (auto &fan : state.availableFansRight) {
+        fan = fans(random);
+    }
+
+    return state;
+}
@@ -6,11 +6,47 @@
 #define KI_SETUP_H
 
 #include <SopraGameLogic/GameModel.h>
+#include <SopraAITools/AITools.h>
+#include <SopraMessages/Snapshot.hpp>
+#include <nlohmann/json.hpp>
+#include <random>
 
 namespace setup{
     auto createEnv() -> std::shared_ptr<gameModel::Environment>;
     auto createEnv(const gameModel::Config &config) -> std::shared_ptr<gameModel::Environment>;
     auto createSymmetricEnv() -> std::shared_ptr<gameModel::Environment>;
+
+    /**
+     * Creates the snapshot the server would send for a state
+     * @param state the current state
+     * @param deltaType type of the last delta broadcast
+     * @param activeEntity active entity of the last delta broadcast
+     * @return the snapshot describing state
+     */
+    auto createSnapshot(const aiTools::State &state, communication::messages::types::DeltaType deltaType,
+                        std::optional<communication::messages::types::EntityId> activeEntity = std::nullopt) ->
+            communication::messages::broadcast::Snapshot;
+
+    /**
+     * Same as createSnapshot but returns the json payload as it is sent by the server
+     */
+    auto createSnapshotJson(const aiTools::State &state, communication::messages::types::DeltaType deltaType,
+                            std::optional<communication::messages::types::EntityId> activeEntity = std::nullopt) ->
+            nlohmann::json;
+
+    /**
+     * Creates a state based on createEnv without available fans or used players
+     * @param quaffleHeld whether the quaffle is placed on the second left chaser
+     * @return the state
+     */
+    auto createState(bool quaffleHeld = false) -> aiTools::State;
+
+    /**
+     * Creates a state with random positions, flags, scores and fans based on createEnv
+     * @param random the random number generator to use
+     * @return the random state
+     */
+    auto createRandomState(std::mt19937 &random) -> aiTools::State;
 }
 
 #endif //KI_SETUP_H
@@ -0,0 +1,248 @@
+/**
+ * @file LocalServer.cpp
+ * @brief Implements the in-process stand-in for the game server used for self-play
+ */
+
+#include "LocalServer.hpp"
+#include <iostream>
+#include <setup.h>
+#include <SopraGameLogic/conversions.h>
+
+namespace selfplay {
+    constexpr unsigned int SNITCH_ROUND = 10;
+
+    LocalServer::LocalServer(communication::messages::broadcast::MatchStart matchStart, const MatchSettings &settings,
+                             unsigned long seed) :
+            matchStart(std::move(matchStart)), settings(settings), random(seed),
+            left(settings.difficulty, settings.threads, false, settings.leftEngine, nullptr, nullptr,
+                 this->matchStart.getLeftTeamConfig(), util::AsyncLog{std::cout, 0}),
+            right(settings.difficulty, settings.threads, false, settings.rightEngine, nullptr, nullptr,
+                  this->matchStart.getRightTeamConfig(), util::AsyncLog{std::cout, 0}) {}
+
+    auto LocalServer::run() -> MatchResult {
+        using namespace communication::messages;
+        auto leftFormation = left.getTeamFormation(matchStart);
+        auto rightFormation = right.getTeamFormation(matchStart);
+        brooms = ai::OpeningBook::broomsOf(matchStart.getLeftTeamConfig(), matchStart.getRightTeamConfig());
+        formations = {leftFormation, rightFormation};
+        bookMoves.clear();
+
+        state.env = std::make_shared<gameModel::Environment>(gameModel::Config{matchStart.getMatchConfig()},
+                createTeam(leftFormation, matchStart.getLeftTeamConfig(), gameModel::TeamSide::LEFT),
+                createTeam(rightFormation, matchStart.getRightTeamConfig(), gameModel::TeamSide::RIGHT));
+        state.env->snitch->exists = false;
+        state.roundNumber = 0;
+        state.availableFansLeft = {};
+        state.availableFansRight = {};
+
+        MatchResult result;
+        startRound();
+        auto turn = nextTurn();
+        while (state.roundNumber <= settings.maxRounds) {
+            if (!turn.has_value()) {
+                startRound();
+                turn = nextTurn();
+                if (!turn.has_value()) {
+                    break;
+                }
+
+                continue;
+            }
+
+            result.turns++;
+            auto bookKey = state.roundNumber <= settings.bookRounds ?
+                    std::optional{ai::OpeningBook::moveKey(ai::SearchState::fromState(state), *turn, brooms)} :
+                    std::nullopt;
+            auto action = request(*turn);
+            if (bookKey.has_value() && action.has_value()) {
+                bookMoves.emplace_back(BookMove{gameLogic::conversions::idToSide(turn->id), *bookKey, *action});
+            }
+
+            auto successors = aiTools::expandState(state, *turn);
+            auto chosen = std::find_if(successors.begin(), successors.end(), [&action](const auto &successor) {
+                return action.has_value() && successor.first == *action;
+            });
+
+            auto &used = gameLogic::conversions::idToSide(turn->id) == gameModel::TeamSide::LEFT ?
+                         state.playersUsedLeft : state.playersUsedRight;
+            if (chosen == successors.end() || chosen->second.empty()) {
+                // Illegal or missing actions end the turn of the player
+                result.illegalActions++;
+                used.emplace(turn->id);
+                broadcast(types::DeltaType::TURN_USED, turn->id);
+                turn = nextTurn();
+                continue;
+            }
+
+            std::vector<double> probabilities;
+            for (const auto &outcome : chosen->second) {
+                probabilities.emplace_back(std::get<2>(outcome));
+            }
+
+            std::discrete_distribution<std::size_t> distribution(probabilities.begin(), probabilities.end());
+            auto [nextState, nextTurnState, probability] = chosen->second[distribution(random)];
+            auto scores = std::make_pair(state.env->team1->score, state.env->team2->score);
+            auto snitchExisted = state.env->snitch->exists;
+            auto currentId = turn->id;
+            state = nextState;
+
+            if (snitchExisted && (state.env->team1->score - scores.first >= gameController::SNITCH_POINTS ||
+                                  state.env->team2->score - scores.second >= gameController::SNITCH_POINTS)) {
+                result.snitchCaught = true;
+                break;
+            }
+
+            if (nextTurnState.has_value() && nextTurnState->id == currentId) {
+                broadcast(types::DeltaType::MOVE, currentId);
+                turn = nextTurnState;
+            } else {
+                auto &nextUsed = gameLogic::conversions::idToSide(currentId) == gameModel::TeamSide::LEFT ?
+                                 state.playersUsedLeft : state.playersUsedRight;
+                nextUsed.emplace(currentId);
+                broadcast(types::DeltaType::TURN_USED, currentId);
+                turn = nextTurnState.has_value() ? nextTurnState : nextTurn();
+            }
+        }
+
+        result.leftScore = state.env->team1->score;
+        result.rightScore = state.env->team2->score;
+        result.rounds = std::min(state.roundNumber, settings.maxRounds);
+        for (const auto *game : {&left, &right}) {
+            auto [actions, states] = game->getSearchStatistics();
+            result.searchedActions += actions;
+            result.exploredStates += states;
+        }
+
+        return result;
+    }
+
+    void LocalServer::addToBook(ai::OpeningBook::Builder &builder, const MatchResult &result) const {
+        auto resultOf = [&result](gameModel::TeamSide side) {
+            auto difference = static_cast<double>(result.leftScore - result.rightScore);
+            return side == gameModel::TeamSide::LEFT ? difference : -difference;
+        };
+
+        if (settings.bookRounds == 0) {
+            return;
+        }
+
+        for (auto side : {gameModel::TeamSide::LEFT, gameModel::TeamSide::RIGHT}) {
+            builder.addFormation(ai::OpeningBook::formationKey(side, brooms), formations[ai::sideIndex(side)],
+                                 resultOf(side));
+        }
+
+        for (const auto &move : bookMoves) {
+            builder.addMove(move.key, move.action, resultOf(move.side));
+        }
+    }
+
+    auto LocalServer::createTeam(const communication::messages::request::TeamFormation &formation,
+                                 const communication::messages::request::TeamConfig &config,
+                                 gameModel::TeamSide side) const -> std::shared_ptr<gameModel::Team> {
+        using ID = communication::messages::types::EntityId;
+        bool isLeft = side == gameModel::TeamSide::LEFT;
+        gameModel::Seeker seeker({formation.getSeekerX(), formation.getSeekerY()}, config.getSeeker().getBroom(),
+                                 isLeft ? ID::LEFT_SEEKER : ID::RIGHT_SEEKER);
+        gameModel::Keeper keeper({formation.getKeeperX(), formation.getKeeperY()}, config.getKeeper().getBroom(),
+                                 isLeft ? ID::LEFT_KEEPER : ID::RIGHT_KEEPER);
+        std::array<gameModel::Beater, 2> beaters{
+                gameModel::Beater({formation.getBeater1X(), formation.getBeater1Y()}, config.getBeater1().getBroom(),
+                                  isLeft ? ID::LEFT_BEATER1 : ID::RIGHT_BEATER1),
+                gameModel::Beater({formation.getBeater2X(), formation.getBeater2Y()}, config.getBeater2().getBroom(),
+                                  isLeft ? ID::LEFT_BEATER2 : ID::RIGHT_BEATER2)};
+        std::array<gameModel::Chaser, 3> chasers{
+                gameModel::Chaser({formation.getChaser1X(), formation.getChaser1Y()}, config.getChaser1().getBroom(),
+                                  isLeft ? ID::LEFT_CHASER1 : ID::RIGHT_CHASER1),
+                gameModel::Chaser({formation.getChaser2X(), formation.getChaser2Y()}, config.getChaser2().getBroom(),
+                                  isLeft ? ID::LEFT_CHASER2 : ID::RIGHT_CHASER2),
+                gameModel::Chaser({formation.getChaser3X(), formation.getChaser3Y()}, config.getChaser3().getBroom(),
+                                  isLeft ? ID::LEFT_CHASER3 : ID::RIGHT_CHASER3)};
+        for (auto *player : std::initializer_list<gameModel::Player *>{&seeker, &keeper, &beaters[0], &beaters[1],
+                                                                        &chasers[0], &chasers[1], &chasers[2]}) {
+            player->knockedOut = false;
+            player->isFined = false;
+        }
+
+        return std::make_shared<gameModel::Team>(seeker, keeper, beaters, chasers, 0,
+                                                 gameModel::Fanblock(0, 0, 0, 0, 0), side);
+    }
+
+    auto LocalServer::nextTurn() const -> std::optional<aiTools::ActionState> {
+        // The sides take turns, the team that starts alternates every round
+        auto usedLeft = state.playersUsedLeft.size();
+        auto usedRight = state.playersUsedRight.size();
+        bool leftFirst = state.roundNumber % 2 == 1;
+        bool leftsTurn = usedLeft < usedRight || (usedLeft == usedRight && leftFirst);
+        for (auto side : {leftsTurn, !leftsTurn}) {
+            auto team = state.env->getTeam(side ? gameModel::TeamSide::LEFT : gameModel::TeamSide::RIGHT);
+            const auto &used = side ? state.playersUsedLeft : state.playersUsedRight;
+            for (const auto &player : team->getAllPlayers()) {
+                if (!player->isFined && !player->knockedOut && used.find(player->getId()) == used.end()) {
+                    return aiTools::ActionState{player->getId(), aiTools::ActionState::TurnState::FirstMove};
+                }
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    void LocalServer::startRound() {
+        state.roundNumber++;
+        state.currentPhase = communication::messages::types::PhaseType::PLAYER_PHASE;
+        state.goalScoredThisRound = false;
+        state.playersUsedLeft.clear();
+        state.playersUsedRight.clear();
+        for (const auto &player : state.env->getAllPlayers()) {
+            player->knockedOut = false;
+        }
+
+        if (state.roundNumber >= SNITCH_ROUND && !state.env->snitch->exists) {
+            std::uniform_int_distribution<int> x(0, 16);
+            std::uniform_int_distribution<int> y(0, 12);
+            gameModel::Position position{x(random), y(random)};
+            while (gameModel::Environment::getCell(position) != gameModel::Cell::Standard ||
+                   state.env->getPlayer(position).has_value() || position == state.env->quaffle->position ||
+                   position == state.env->bludgers[0]->position || position == state.env->bludgers[1]->position) {
+                position = {x(random), y(random)};
+            }
+
+            state.env->snitch->position = position;
+            state.env->snitch->exists = true;
+        }
+
+        broadcast(communication::messages::types::DeltaType::ROUND_CHANGE);
+    }
+
+    void LocalServer::broadcast(communication::messages::types::DeltaType deltaType,
+                                std::optional<communication::messages::types::EntityId> activeEntity) {
+        auto snapshot = setup::createSnapshot(state, deltaType, activeEntity);
+        left.onSnapshot(snapshot);
+        right.onSnapshot(snapshot);
+    }
+
+    auto LocalServer::request(const aiTools::ActionState &turn)
+        -> std::optional<communication::messages::request::DeltaRequest> {
+        using namespace communication::messages;
+        auto turnType = types::TurnType::MOVE;
+        if (turn.turnState == aiTools::ActionState::TurnState::Action) {
+            turnType = types::TurnType::ACTION;
+        } else if (turn.turnState == aiTools::ActionState::TurnState::PlayerFan) {
+            turnType = types::TurnType::FAN;
+        }
+
+        broadcast::Next next(turn.id, turnType, settings.timeout);
+        std::optional<request::DeltaRequest> ret;
+        for (auto [game, timer] : {std::make_pair(&left, &leftTimer), std::make_pair(&right, &rightTimer)}) {
+            try {
+                auto action = game->getNextAction(next, *timer);
+                if (action.has_value()) {
+                    ret = action;
+                }
+            } catch (std::runtime_error &e) {
+                std::cerr << "Game failed to compute an action: " << e.what() << std::endl;
+            }
+        }
+
+        return ret;
+    }
+}
@@ -0,0 +1,119 @@
+/**
+ * @file LocalServer.hpp
+ * @brief Declares the in-process stand-in for the game server used for self-play
+ */
+
+#ifndef KI_LOCALSERVER_HPP
+#define KI_LOCALSERVER_HPP
+
+#include <random>
+#include <Game/Game.hpp>
+#include <Game/OpeningBook.hpp>
+#include <SopraMessages/MatchStart.hpp>
+
+namespace selfplay {
+    /**
+     * Settings of a self-play match
+     */
+    struct MatchSettings {
+        unsigned int difficulty;
+        unsigned int threads;
+        unsigned int maxRounds;
+        int timeout;
+
+        /**
+         * Formations and actions of the first bookRounds rounds are recorded for the opening book
+         */
+        unsigned int bookRounds = 0;
+
+        /**
+         * Search engines of the left and the right team
+         */
+        ai::Engine leftEngine = ai::Engine::AlphaBeta;
+        ai::Engine rightEngine = ai::Engine::AlphaBeta;
+    };
+
+    /**
+     * Outcome and statistics of a finished match
+     */
+    struct MatchResult {
+        int leftScore = 0;
+        int rightScore = 0;
+        unsigned int rounds = 0;
+        unsigned long turns = 0;
+        unsigned long illegalActions = 0;
+        unsigned long searchedActions = 0;
+        unsigned long exploredStates = 0;
+        bool snitchCaught = false;
+    };
+
+    /**
+     * Plays a match between two Game instances without any network. The rules are applied with
+     * aiTools::expandState, the outcome of an action is drawn according to its probability. Both games get the
+     * same Snapshot and Next messages a server would broadcast.
+     *
+     * Only the player phase is simulated: the ball phase and fan turns are skipped, the snitch appears in a fixed
+     * round and the match ends when the snitch is caught or after a maximum number of rounds.
+     */
+    class LocalServer {
+    public:
+        /**
+         * CTor
+         * @param matchStart the MatchStart message sent to both games, the left team config is used for the left game
+         * @param settings settings of the match
+         * @param seed seed for all random decisions of the match
+         */
+        LocalServer(communication::messages::broadcast::MatchStart matchStart, const MatchSettings &settings,
+                    unsigned long seed);
+
+        /**
+         * Plays the match
+         * @return the result of the match
+         */
+        auto run() -> MatchResult;
+
+        /**
+         * Adds the formations and the actions of the first rounds of the played match to an opening book
+         * @param builder the book
+         * @param result the result returned by run
+         */
+        void addToBook(ai::OpeningBook::Builder &builder, const MatchResult &result) const;
+
+    private:
+        /**
+         * An action played in the first rounds
+         */
+        struct BookMove {
+            gameModel::TeamSide side;
+            std::uint64_t key;
+            communication::messages::request::DeltaRequest action;
+        };
+
+        auto createTeam(const communication::messages::request::TeamFormation &formation,
+                        const communication::messages::request::TeamConfig &config,
+                        gameModel::TeamSide side) const -> std::shared_ptr<gameModel::Team>;
+
+        auto nextTurn() const -> std::optional<aiTools::ActionState>;
+
+        void startRound();
+
+        void broadcast(communication::messages::types::DeltaType deltaType,
+                       std::optional<communication::messages::types::EntityId> activeEntity = std::nullopt);
+
+        auto request(const aiTools::ActionState &turn) -> std::optional<communication::messages::request::DeltaRequest>;
+
+        communication::messages::broadcast::MatchStart matchStart;
+        MatchSettings settings;
+        std::mt19937_64 random;
+        Game left;
+        Game right;
+        util::Timer leftTimer;
+        util::Timer rightTimer;
+        aiTools::State state;
+        ai::OpeningBook::Brooms brooms{};
+        std::array<communication::messages::request::TeamFormation, 2> formations;
+        std::vector<BookMove> bookMoves;
+    };
+}
+
+#endif //KI_LOCALSERVER_HPP
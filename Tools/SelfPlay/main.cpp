@@ -0,0 +1,249 @@
+/**
+ * @file main.cpp
+ * @brief Runs self-play matches between two instances of the ki and prints the results as JSON
+ */
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <getopt.h>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include "LocalServer.hpp"
+
+namespace {
+    constexpr unsigned int GAMES_DEFAULT = 10;
+    constexpr unsigned int DIFFICULTY_DEFAULT = 1;
+    constexpr unsigned int ROUNDS_DEFAULT = 50;
+    constexpr int TIMEOUT_DEFAULT = 3000;
+    constexpr unsigned int BOOK_ROUNDS_DEFAULT = 2;
+    constexpr auto TEAM_DEFAULT = "teamConfig.json";
+
+    void printHelp() {
+        std::cout << "Usage: SelfPlay --match <path> [options]\n"
+                  << "Options:\n"
+                  << "\t-m, --match <path>\t\tmatch config (required)\n"
+                  << "\t-t, --team <path>\t\tteam config used by both teams (default: " << TEAM_DEFAULT << ")\n"
+                  << "\t-g, --games <n>\t\t\tnumber of matches (default: " << GAMES_DEFAULT << ")\n"
+                  << "\t-j, --parallel <n>\t\tnumber of matches played at the same time (default: number of cores)\n"
+                  << "\t-d, --difficulty <n>\t\tdifficulty of both teams (default: " << DIFFICULTY_DEFAULT << ")\n"
+                  << "\t-s, --seed <n>\t\t\tseed of the first match, match i uses seed + i (default: 0)\n"
+                  << "\t-r, --rounds <n>\t\tmaximum number of rounds per match (default: " << ROUNDS_DEFAULT << ")\n"
+                  << "\t-T, --timeout <ms>\t\ttime per turn (default: " << TIMEOUT_DEFAULT << ")\n"
+                  << "\t-b, --book <path>\t\twrite an opening book from the played matches\n"
+                  << "\t-B, --book-rounds <n>\t\trounds per match recorded for the book (default: "
+                  << BOOK_ROUNDS_DEFAULT << ")\n"
+                  << "\t-e, --left-engine <name>\tsearch engine of the left team: alphabeta, star1, star2 or mcts "
+                  << "(default: alphabeta)\n"
+                  << "\t-E, --right-engine <name>\tsearch engine of the right team (default: alphabeta)\n"
+                  << "\t-h, --help\t\t\tprint this message" << std::endl;
+    }
+
+    auto readJson(const std::string &path) -> nlohmann::json {
+        std::ifstream ifstream{path};
+        if (!ifstream) {
+            throw std::runtime_error{"Can't open " + path};
+        }
+
+        nlohmann::json json;
+        ifstream >> json;
+        return json;
+    }
+
+    auto toJson(unsigned long index, unsigned long seed, const selfplay::MatchResult &result) -> nlohmann::json {
+        nlohmann::json json;
+        json["game"] = index;
+        json["seed"] = seed;
+        json["leftScore"] = result.leftScore;
+        json["rightScore"] = result.rightScore;
+        json["rounds"] = result.rounds;
+        json["turns"] = result.turns;
+        json["illegalActions"] = result.illegalActions;
+        json["snitchCaught"] = result.snitchCaught;
+        json["nodesPerMove"] = result.searchedActions == 0 ? 0.0 :
+                static_cast<double>(result.exploredStates) / static_cast<double>(result.searchedActions);
+        return json;
+    }
+}
+
+/**
+ * Plays a number of matches of the ki against itself, distributed over several threads. Prints one JSON object
+ * per finished match and a summary with games per hour, nodes per move and the results.
+ */
+int main(int argc, char *argv[]) {
+    option longopts[] = {
+            {"match", required_argument, nullptr, 'm'},
+            {"team", required_argument, nullptr, 't'},
+            {"games", required_argument, nullptr, 'g'},
+            {"parallel", required_argument, nullptr, 'j'},
+            {"difficulty", required_argument, nullptr, 'd'},
+            {"seed", required_argument, nullptr, 's'},
+            {"rounds", required_argument, nullptr, 'r'},
+            {"timeout", required_argument, nullptr, 'T'},
+            {"book", required_argument, nullptr, 'b'},
+            {"book-rounds", required_argument, nullptr, 'B'},
+            {"left-engine", required_argument, nullptr, 'e'},
+            {"right-engine", required_argument, nullptr, 'E'},
+            {"help", no_argument, nullptr, 'h'},
+            {}
+    };
+
+    std::string matchPath;
+    std::string teamPath = TEAM_DEFAULT;
+    std::string bookPath;
+    unsigned int bookRounds = BOOK_ROUNDS_DEFAULT;
+    unsigned long games = GAMES_DEFAULT;
+    unsigned long seed = 0;
+    unsigned int parallel = std::max(1u, std::thread::hardware_concurrency());
+    selfplay::MatchSettings settings{DIFFICULTY_DEFAULT, 1, ROUNDS_DEFAULT, TIMEOUT_DEFAULT};
+
+    try {
+        int c;
+        while ((c = getopt_long(argc, argv, "m:t:g:j:d:s:r:T:b:B:e:E:h", longopts, nullptr)) != -1) {
+            switch (c) {
+                case 'm':
+                    matchPath = optarg;
+                    break;
+                case 't':
+                    teamPath = optarg;
+                    break;
+                case 'g':
+                    games = std::stoul(optarg);
+                    break;
+                case 'j':
+                    parallel = std::max(1ul, std::stoul(optarg));
+                    break;
+                case 'd':
+                    settings.difficulty = static_cast<unsigned int>(std::stoul(optarg));
+                    break;
+                case 's':
+                    seed = std::stoul(optarg);
+                    break;
+                case 'r':
+                    settings.maxRounds = static_cast<unsigned int>(std::stoul(optarg));
+                    break;
+                case 'T':
+                    settings.timeout = std::stoi(optarg);
+                    break;
+                case 'b':
+                    bookPath = optarg;
+                    break;
+                case 'B':
+                    bookRounds = static_cast<unsigned int>(std::stoul(optarg));
+                    break;
+                case 'e':
+                    settings.leftEngine = ai::engineFromString(optarg);
+                    break;
+                case 'E':
+                    settings.rightEngine = ai::engineFromString(optarg);
+                    break;
+                case 'h':
+                    printHelp();
+                    return 0;
+                default:
+                    printHelp();
+                    return 1;
+            }
+        }
+    } catch (std::logic_error &e) {
+        std::cerr << "Invalid argument: " << e.what() << std::endl;
+        return 1;
+    }
+
+    if (matchPath.empty()) {
+        printHelp();
+        return 1;
+    }
+
+    if (!bookPath.empty()) {
+        settings.bookRounds = bookRounds;
+    }
+
+    communication::messages::broadcast::MatchStart matchStart;
+    try {
+        auto teamConfig = readJson(teamPath);
+        auto rightTeamConfig = teamConfig;
+        rightTeamConfig["name"] = teamConfig["name"].get<std::string>() + " (right)";
+        nlohmann::json json;
+        json["matchConfig"] = readJson(matchPath);
+        json["leftTeamConfig"] = teamConfig;
+        json["rightTeamConfig"] = rightTeamConfig;
+        json["leftTeamUserName"] = "left";
+        json["rightTeamUserName"] = "right";
+        matchStart = json.get<communication::messages::broadcast::MatchStart>();
+    } catch (nlohmann::json::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    } catch (std::runtime_error &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    std::atomic_ulong nextGame = 0;
+    std::mutex outputMutex;
+    std::vector<selfplay::MatchResult> results;
+    ai::OpeningBook::Builder book;
+    auto start = std::chrono::steady_clock::now();
+    auto worker = [&]() {
+        for (auto game = nextGame++; game < games; game = nextGame++) {
+            selfplay::LocalServer server{matchStart, settings, seed + game};
+            auto result = server.run();
+            std::lock_guard<std::mutex> lock{outputMutex};
+            std::cout << toJson(game, seed + game, result).dump() << std::endl;
+            results.emplace_back(result);
+            server.addToBook(book, result);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned int i = 0; i < std::min<unsigned long>(parallel, games); i++) {
+        threads.emplace_back(worker);
+    }
+
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    auto hours = std::chrono::duration<double, std::ratio<3600>>(std::chrono::steady_clock::now() - start).count();
+    unsigned long leftWins = 0, rightWins = 0, draws = 0, searchedActions = 0, exploredStates = 0, rounds = 0,
+            illegalActions = 0;
+    long scoreDifference = 0;
+    for (const auto &result : results) {
+        leftWins += result.leftScore > result.rightScore;
+        rightWins += result.leftScore < result.rightScore;
+        draws += result.leftScore == result.rightScore;
+        searchedActions += result.searchedActions;
+        exploredStates += result.exploredStates;
+        rounds += result.rounds;
+        illegalActions += result.illegalActions;
+        scoreDifference += result.leftScore - result.rightScore;
+    }
+
+    auto average = [&results](auto value) {
+        return results.empty() ? 0.0 : static_cast<double>(value) / static_cast<double>(results.size());
+    };
+
+    nlohmann::json summary;
+    summary["games"] = results.size();
+    summary["leftWins"] = leftWins;
+    summary["rightWins"] = rightWins;
+    summary["draws"] = draws;
+    summary["illegalActions"] = illegalActions;
+    summary["gamesPerHour"] = hours > 0 ? static_cast<double>(results.size()) / hours : 0.0;
+    summary["nodesPerMove"] = searchedActions == 0 ? 0.0 :
+            static_cast<double>(exploredStates) / static_cast<double>(searchedActions);
+    summary["averageRounds"] = average(rounds);
+    summary["averageScoreDifference"] = average(scoreDifference);
+    if (!bookPath.empty()) {
+        try {
+            summary["bookEntries"] = book.write(bookPath);
+        } catch (std::runtime_error &e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+    }
+
+    std::cout << summary.dump() << std::endl;
+    return 0;
+}
@@ -10,15 +10,29 @@
 namespace communication {
     constexpr auto RECONNECT_INTERVAL = 1000;
 
+    /**
+     * Number of jobs that may wait for the compute thread before a Next request is dropped, snapshots are always
+     * queued as the game state is updated from every one of them
+     */
+    constexpr std::size_t JOB_QUEUE_CAPACITY = 64;
+
     Communicator::Communicator(const std::string &lobbyName, const std::string &userName,
                                 const std::string &password,
-                                unsigned int difficulty, const messages::request::TeamConfig &teamConfig,
-                                const std::string &server, uint16_t port, util::Logging &log)
-            : messageHandler{}, server{server}, port{port}, lobbyName{lobbyName}, userName{userName}, password{password},
-                game{difficulty, teamConfig, log}, teamConfig{teamConfig}, log{log}, teamConfigSent{false} {
-        messageHandler.emplace(server, port, log);
+                                unsigned int difficulty, unsigned int threads, bool ponder, ai::Engine engine,
+                                std::shared_ptr<util::TelemetryWriter> telemetry,
+                                std::shared_ptr<const ai::OpeningBook> openingBook, bool prettyJson,
+                                const messages::request::TeamConfig &teamConfig,
+                                const std::string &server, uint16_t port, util::AsyncLog &log)
+            : messageHandler{}, server{server}, port{port}, prettyJson{prettyJson}, lobbyName{lobbyName}, userName{userName}, password{password},
+                game{difficulty, threads, ponder, engine, std::move(telemetry), std::move(openingBook), teamConfig, log}, teamConfig{teamConfig}, log{log}, teamConfigSent{false},
+                executor{JOB_QUEUE_CAPACITY, [&log](const std::exception &e){
+                    log.error(std::string{"Compute job failed: "} + e.what());
+                }} {
+        messageHandler.emplace(server, port, log, prettyJson);
         messageHandler->receiveListener(
                 std::bind(&Communicator::onMessageReceive, this, std::placeholders::_1));
+        messageHandler->snapshotListener(
+                std::bind(&Communicator::onSnapshotReceive, this, std::placeholders::_1));
         messageHandler->closeListener(std::bind(&Communicator::onClose, this));
         send(messages::request::JoinRequest{lobbyName, userName, password, true});
         log.info("Send JoinRequest");
@@ -47,65 +61,57 @@ namespace communication {
             const messages::broadcast::MatchFinish &matchFinish) {
         log.info("Got MatchFinish, exiting");
         log.info("Winner: " + matchFinish.getWinnerUserName());
+        log.info("Jobs dropped: " + std::to_string(executor.getDropped()));
+        log.flush();
         std::exit(0);
     }
 
     template <>
     void Communicator::onPayloadReceive<messages::broadcast::Snapshot>(
             const messages::broadcast::Snapshot &payload) {
-        if(updateMutex.try_lock()){
-            log.info("Got Snapshot, updating");
-            game.onSnapshot(payload);
-            updateMutex.unlock();
-        }
+        onSnapshotReceive(SnapshotFrame::fromSnapshot(payload));
     }
 
     template <>
     void Communicator::onPayloadReceive<messages::broadcast::Next>(const messages::broadcast::Next &next) {
         using namespace communication::messages;
         log.info("Got Next request");
-        auto computeNextAsync = [this, next](){
-            std::optional<request::DeltaRequest> request;
-
-            {
-                std::lock_guard lock(updateMutex);
-                request = game.getNextAction(next, timer);
-            }
-
+        auto received = std::chrono::steady_clock::now();
+        auto ticket = ++latestNext;
+        auto computeNext = [this, next, received, ticket](){
+            auto request = game.getNextAction(next, timer);
             if(!request.has_value()){
                 return;
             }
 
+            // The compute thread never waits for the pause to end, the answer is sent by the PauseResponse handler
+            std::lock_guard<std::mutex> lock(pauseMutex);
+            PendingAnswer answer{ticket, std::move(*request), received};
             if(paused){
-                std::unique_lock<std::mutex> lock(pauseMutex);
-                cvMainToWorker.wait(lock, [this] { return !static_cast<bool>(paused); });
+                log.info("Paused, answer is sent when the pause ends");
+                pendingAnswer = std::move(answer);
+                return;
             }
 
-            log.info("Sending ->");
-            send(*request);
-            log.debug("Type sent: " + types::toString(request->getDeltaType()));
-            if(request->getActiveEntity().has_value()){
-                log.debug("ID sent: " + types::toString(request->getActiveEntity().value()));
-            }
+            sendAnswer(answer);
         };
 
-        if(worker.joinable()){
-            worker.join();
+        // A new request means the server no longer waits for the answer to an older one
+        game.abortSearch();
+        if(!executor.submit(computeNext, true)){
+            log.error("Compute queue full, dropping Next request");
         }
-
-        log.debug("Starting worker...");
-        worker = std::thread(computeNextAsync);
     }
 
     template <>
     void Communicator::onPayloadReceive<messages::broadcast::PauseResponse>(const messages::broadcast::PauseResponse &pauseResponse){
-        {
-            std::lock_guard<std::mutex> lock(pauseMutex);
-            log.info("Pause response received");
-            paused = pauseResponse.isPause();
+        std::lock_guard<std::mutex> lock(pauseMutex);
+        log.info("Pause response received");
+        paused = pauseResponse.isPause();
+        if(!paused && pendingAnswer.has_value()){
+            sendAnswer(*pendingAnswer);
+            pendingAnswer.reset();
         }
-
-        cvMainToWorker.notify_all();
     }
 
     template <>
@@ -129,12 +135,40 @@ namespace communication {
         }, message.getPayload());
     }
 
+    void Communicator::onSnapshotReceive(const SnapshotFrame &snapshot) {
+        isConnected = true;
+        log.info("Got Snapshot, updating");
+        executor.submit([this, snapshot](){ game.onSnapshot(snapshot); });
+    }
+
     void Communicator::send(const messages::Payload &payload) {
         if (isConnected) {
             messageHandler.value().send(messages::Message{payload});
         }
     }
 
+    void Communicator::sendAnswer(const PendingAnswer &answer) {
+        using namespace communication::messages;
+        if(answer.ticket != latestNext){
+            log.warn("Next request was superseded, dropping answer");
+            return;
+        }
+
+        log.info("Sending ->");
+        send(answer.request);
+        nextLatency.add(std::chrono::steady_clock::now() - answer.received);
+        log.debug([&]{ return "Type sent: " + types::toString(answer.request.getDeltaType()); });
+        if(answer.request.getActiveEntity().has_value()){
+            log.debug([&]{ return "ID sent: " + types::toString(answer.request.getActiveEntity().value()); });
+        }
+
+        log.debug([this]{
+            return "Next -> DeltaRequest latency: mean " + std::to_string(nextLatency.getMean()) + "ms, max " +
+                   std::to_string(nextLatency.getMax()) + "ms over " + std::to_string(nextLatency.getCount()) +
+                   " requests";
+        });
+    }
+
     void Communicator::onClose() {
         log.error("Closed");
         isConnected = false;
@@ -145,9 +179,11 @@ namespace communication {
         while (!isConnected) {
             messageHandler.reset();
             log.info("Trying reconnect");
-            messageHandler.emplace(server, port, log);
+            messageHandler.emplace(server, port, log, prettyJson);
             messageHandler->receiveListener(
                     std::bind(&Communicator::onMessageReceive, this, std::placeholders::_1));
+            messageHandler->snapshotListener(
+                    std::bind(&Communicator::onSnapshotReceive, this, std::placeholders::_1));
             std::this_thread::sleep_for(std::chrono::milliseconds{RECONNECT_INTERVAL});
         }
 
@@ -8,19 +8,23 @@
 #ifndef KI_COMMUNICATOR_HPP
 #define KI_COMMUNICATOR_HPP
 
+#include <chrono>
+#include <optional>
 #include <string>
 #include <queue>
-#include <SopraUtil/Logging.hpp>
+#include <Util/AsyncLog.hpp>
 #include <SopraMessages/Message.hpp>
 #include <SopraMessages/TeamConfig.hpp>
 #include <Game/Game.hpp>
 #include <SopraUtil/Timer.h>
+#include <Util/ComputeExecutor.hpp>
 #include "MessageHandler.hpp"
 
 namespace communication {
     /**
      * This module is responsible for sending and receiving messages according to the protocol
-     * defined in the standard.
+     * defined in the standard. Snapshots and Next requests are handed to a single compute thread in the
+     * order they arrive, the thread receiving messages never waits for the game.
      */
     class Communicator {
     public:
@@ -30,6 +34,12 @@ namespace communication {
          * @param userName the username to use
          * @param password the password to use
          * @param difficulty the difficulty of the AI
+         * @param threads the number of threads used for the search
+         * @param ponder whether to search while the opponent is thinking
+         * @param engine the search engine
+         * @param telemetry output for search statistics, may be null
+         * @param openingBook book consulted before searching, may be null
+         * @param prettyJson send indented json, intended for debugging only
          * @param teamConfig the teamConfig to use
          * @param server the server to use for the WebSocketClient
          * @param port the port to use for the WebSocketClient
@@ -37,13 +47,26 @@ namespace communication {
          * @see Game, MessageHandler
          */
         Communicator(const std::string &lobbyName, const std::string &userName,
-                const std::string &password, unsigned int difficulty,
+                const std::string &password, unsigned int difficulty, unsigned int threads, bool ponder,
+                ai::Engine engine, std::shared_ptr<util::TelemetryWriter> telemetry,
+                std::shared_ptr<const ai::OpeningBook> openingBook, bool prettyJson,
                 const messages::request::TeamConfig &teamConfig,
-                const std::string &server, uint16_t port, util::Logging &log);
+                const std::string &server, uint16_t port, util::AsyncLog &log);
 
     private:
+        /**
+         * Answer to a Next request that was computed during a pause
+         */
+        struct PendingAnswer {
+            std::uint64_t ticket;
+            messages::request::DeltaRequest request;
+            std::chrono::steady_clock::time_point received;
+        };
+
         void onMessageReceive(const messages::Message& message);
+        void onSnapshotReceive(const SnapshotFrame &snapshot);
         void send(const messages::Payload &payload);
+        void sendAnswer(const PendingAnswer &answer);
 
         template <typename T>
         void onPayloadReceive(const T &payload);
@@ -55,19 +78,21 @@ namespace communication {
         std::optional<MessageHandler> messageHandler;
         std::string server;
         uint16_t port;
+        bool prettyJson;
         std::string lobbyName, userName, password;
         Game game;
         messages::request::TeamConfig teamConfig;
-        util::Logging &log;
+        util::AsyncLog &log;
         std::atomic_bool paused = false;
         util::Timer timer;
-        std::condition_variable cvMainToWorker;
         std::mutex pauseMutex;
-        std::mutex updateMutex;
-        std::thread worker;
+        std::optional<PendingAnswer> pendingAnswer;
         std::atomic_bool isConnected = true;
         std::future<void> reconnectThread;
         bool teamConfigSent;
+        std::atomic_uint64_t latestNext = 0;
+        util::LatencyStats nextLatency;
+        util::ComputeExecutor executor;
     };
 }
 
@@ -8,17 +8,17 @@
 #include "MessageHandler.hpp"
 
 namespace communication {
-    MessageHandler::MessageHandler(const std::string &server, uint16_t port, util::Logging &log)
-        : log{log}, socketClient{server, "/", port, ""} {
+    MessageHandler::MessageHandler(const std::string &server, uint16_t port, util::AsyncLog &log, bool prettyPrint)
+        : log{log}, writer{prettyPrint}, socketClient{server, "/", port, ""} {
         socketClient.receiveListener(
                 std::bind(&MessageHandler::receiveEvent, this, std::placeholders::_1));
         socketClient.closeListener(closeListener);
     }
 
     void MessageHandler::send(messages::Message message) {
-        nlohmann::json jsonMessage = message;
+        std::lock_guard<std::mutex> lock{sendMutex};
         try {
-            socketClient.send(jsonMessage.dump(4));
+            socketClient.send(writer.write(message));
         } catch (std::runtime_error &e) {
             log.error("Connection already closed!");
         }
@@ -27,6 +27,17 @@ namespace communication {
     void MessageHandler::receiveEvent(const std::string& msg) {
         if (!msg.empty()) {
             try {
+                switch (parser.parse(msg)) {
+                    case MessageParser::Result::Snapshot:
+                        snapshotListener(parser.getSnapshot());
+                        return;
+                    case MessageParser::Result::Next:
+                        receiveListener(messages::Message{parser.getNext()});
+                        return;
+                    case MessageParser::Result::Other:
+                        break;
+                }
+
                 nlohmann::json json = nlohmann::json::parse(msg);
                 auto message = json.get<messages::Message>();
                 receiveListener(message);
@@ -10,8 +10,11 @@
 
 #include <SopraNetwork/WebSocketClient.hpp>
 #include <SopraMessages/Message.hpp>
+#include <mutex>
+#include "MessageParser.hpp"
+#include "MessageWriter.hpp"
 
-#include <SopraUtil/Logging.hpp>
+#include <Util/AsyncLog.hpp>
 
 namespace communication {
     /**
@@ -24,8 +27,9 @@ namespace communication {
          * @param server the address (either IP or URL) of the server
          * @param port the port of the server
          * @param log a log object used for logging
+         * @param prettyPrint send indented json, intended for debugging only
          */
-        MessageHandler(const std::string &server, uint16_t port, util::Logging &log);
+        MessageHandler(const std::string &server, uint16_t port, util::AsyncLog &log, bool prettyPrint = false);
 
         /**
          * Send a message to the server
@@ -34,17 +38,27 @@ namespace communication {
         void send(messages::Message message);
 
         /**
-         * Event that gets called when a new message is received
+         * Event that gets called when a new message is received, except for snapshots handled by the streaming
+         * parser
          */
         const util::Listener<messages::Message> receiveListener;
 
+        /**
+         * Event that gets called when a snapshot was parsed by the streaming parser, the frame is only valid during
+         * the call
+         */
+        const util::Listener<const SnapshotFrame &> snapshotListener;
+
         /**
          * Event that is called when the connection gets closed
          */
         const util::Listener<> closeListener;
     private:
         void receiveEvent(const std::string& msg);
-        util::Logging &log;
+        util::AsyncLog &log;
+        std::mutex sendMutex;
+        MessageWriter writer;
+        MessageParser parser;
         network::WebSocketClient socketClient;
     };
 }
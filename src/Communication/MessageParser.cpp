@@ -0,0 +1,499 @@
+/**
+ * @file MessageParser.cpp
+ * @brief Implements the streaming parser for incoming Snapshot and Next messages
+ */
+
+#include "MessageParser.hpp"
+#include <limits>
+
+namespace communication {
+    namespace {
+        constexpr std::size_t RESERVED_FANS = 7;
+        constexpr std::size_t RESERVED_CUBES = 16;
+        constexpr unsigned int X_SEEN = 1;
+        constexpr unsigned int Y_SEEN = 2;
+        constexpr unsigned int XY_SEEN = X_SEEN | Y_SEEN;
+
+        // Members that need to be present for a complete message
+        constexpr std::uint64_t DELTA_TYPE = 1ull << 0;
+        constexpr std::uint64_t PHASE = 1ull << 1;
+        constexpr std::uint64_t ROUND = 1ull << 2;
+        constexpr std::uint64_t GOAL_THROWN = 1ull << 3;
+        constexpr std::uint64_t WOMBAT_CUBES = 1ull << 4;
+        constexpr std::uint64_t QUAFFLE = 1ull << 5;
+        constexpr std::uint64_t BLUDGER1 = 1ull << 6;
+        constexpr std::uint64_t BLUDGER2 = 1ull << 7;
+        constexpr std::uint64_t SNITCH = 1ull << 8;
+        constexpr unsigned int TEAM_BITS = 9;
+        constexpr unsigned int PLAYERS_PER_TEAM = 7;
+        constexpr std::uint64_t NEXT_ENTITY = 1ull << 30;
+        constexpr std::uint64_t NEXT_TYPE = 1ull << 31;
+        constexpr std::uint64_t NEXT_TIMEOUT = 1ull << 32;
+        constexpr std::uint64_t SNAPSHOT_MEMBERS = (1ull << (TEAM_BITS + 2 * (PLAYERS_PER_TEAM + 2))) - 1;
+        constexpr std::uint64_t NEXT_MEMBERS = NEXT_ENTITY | NEXT_TYPE | NEXT_TIMEOUT;
+
+        constexpr auto teamPoints(unsigned int team) -> std::uint64_t {
+            return 1ull << (TEAM_BITS + team * (PLAYERS_PER_TEAM + 2));
+        }
+
+        constexpr auto teamFans(unsigned int team) -> std::uint64_t {
+            return teamPoints(team) << 1;
+        }
+
+        constexpr auto teamPlayer(unsigned int team, unsigned int player) -> std::uint64_t {
+            return teamPoints(team) << (2 + player);
+        }
+
+        constexpr auto teamMembers(unsigned int team) -> std::uint64_t {
+            return ((1ull << (PLAYERS_PER_TEAM + 2)) - 1) * teamPoints(team);
+        }
+
+        /**
+         * Assigns an optional member of a delta, null resets it
+         */
+        template<typename T, typename Convert>
+        bool assignOptional(std::optional<T> &target, bool isNull, bool typeMatches, const Convert &convert) {
+            if (isNull) {
+                target.reset();
+                return true;
+            }
+
+            if (!typeMatches) {
+                return false;
+            }
+
+            target = convert();
+            return true;
+        }
+    }
+
+    MessageParser::MessageParser() {
+        snapshot.leftTeam.fans.reserve(RESERVED_FANS);
+        snapshot.rightTeam.fans.reserve(RESERVED_FANS);
+        snapshot.wombatCubes.reserve(RESERVED_CUBES);
+    }
+
+    auto MessageParser::parse(const std::string &message) -> Result {
+        static const auto snapshotName = messages::broadcast::Snapshot::getName();
+        static const auto nextName = messages::broadcast::Next::getName();
+        depth = 0;
+        seen = 0;
+        snitchNull = false;
+        payloadType.clear();
+        snapshot.leftTeam.fans.clear();
+        snapshot.rightTeam.fans.clear();
+        snapshot.wombatCubes.clear();
+        try {
+            if (!nlohmann::json::sax_parse(message, this)) {
+                return Result::Other;
+            }
+        } catch (std::exception &) {
+            // Unknown enum values, the json conversion reports them
+            return Result::Other;
+        }
+
+        if (payloadType == snapshotName && (seen & SNAPSHOT_MEMBERS) == SNAPSHOT_MEMBERS) {
+            return Result::Snapshot;
+        }
+
+        if (payloadType == nextName && (seen & NEXT_MEMBERS) == NEXT_MEMBERS) {
+            next = messages::broadcast::Next{nextEntity, nextTurnType, nextTimeout};
+            return Result::Next;
+        }
+
+        return Result::Other;
+    }
+
+    auto MessageParser::getSnapshot() const -> const SnapshotFrame & {
+        return snapshot;
+    }
+
+    auto MessageParser::getNext() const -> const messages::broadcast::Next & {
+        return next;
+    }
+
+    bool MessageParser::null() {
+        return value({Value::Type::Null});
+    }
+
+    bool MessageParser::boolean(bool value) {
+        Value ret{Value::Type::Boolean};
+        ret.boolean = value;
+        return this->value(ret);
+    }
+
+    bool MessageParser::number_integer(nlohmann::json::number_integer_t value) {
+        if (value < std::numeric_limits<int>::min() || value > std::numeric_limits<int>::max()) {
+            return this->value({Value::Type::Float});
+        }
+
+        Value ret{Value::Type::Integer};
+        ret.integer = static_cast<long>(value);
+        return this->value(ret);
+    }
+
+    bool MessageParser::number_unsigned(nlohmann::json::number_unsigned_t value) {
+        if (value > static_cast<nlohmann::json::number_unsigned_t>(std::numeric_limits<int>::max())) {
+            return this->value({Value::Type::Float});
+        }
+
+        Value ret{Value::Type::Integer};
+        ret.integer = static_cast<long>(value);
+        return this->value(ret);
+    }
+
+    bool MessageParser::number_float(nlohmann::json::number_float_t, const nlohmann::json::string_t &) {
+        return value({Value::Type::Float});
+    }
+
+    bool MessageParser::string(nlohmann::json::string_t &value) {
+        Value ret{Value::Type::String};
+        ret.string = &value;
+        return this->value(ret);
+    }
+
+    bool MessageParser::start_object(std::size_t) {
+        return enter(depth == 0 ? Scope::Root : objectScope(scopes[depth - 1]));
+    }
+
+    bool MessageParser::key(nlohmann::json::string_t &value) {
+        currentKey = value;
+        return true;
+    }
+
+    bool MessageParser::end_object() {
+        auto scope = scopes[--depth];
+        if (scope == Scope::Player || scope == Scope::Position) {
+            if (snitchNull) {
+                snapshot.snitch.reset();
+                snitchNull = false;
+            } else if (coordinatesSeen != XY_SEEN) {
+                return false;
+            }
+
+            seen |= pendingFlag;
+        }
+
+        return true;
+    }
+
+    bool MessageParser::start_array(std::size_t) {
+        return depth > 0 && enter(arrayScope(scopes[depth - 1]));
+    }
+
+    bool MessageParser::end_array() {
+        depth--;
+        return true;
+    }
+
+    bool MessageParser::parse_error(std::size_t, const std::string &, const nlohmann::json::exception &) {
+        return false;
+    }
+
+    bool MessageParser::enter(Scope scope) {
+        if (depth >= MAX_DEPTH) {
+            return false;
+        }
+
+        scopes[depth++] = scope;
+        return true;
+    }
+
+    auto MessageParser::objectScope(Scope parent) -> Scope {
+        switch (parent) {
+            // A member that appears twice replaces the first one, as it does in a json object
+            case Scope::Root:
+                if (currentKey == "payload") {
+                    seen &= ~(SNAPSHOT_MEMBERS | NEXT_MEMBERS);
+                    return Scope::Payload;
+                }
+
+                return Scope::Skip;
+            case Scope::Payload:
+                if (currentKey == "lastDeltaBroadcast") {
+                    snapshot.lastDelta = {};
+                    seen &= ~DELTA_TYPE;
+                    return Scope::Delta;
+                } else if (currentKey == "leftTeam" || currentKey == "rightTeam") {
+                    team = currentKey == "leftTeam" ? 0 : 1;
+                    seen &= ~teamMembers(team);
+                    return Scope::Team;
+                } else if (currentKey == "balls") {
+                    seen &= ~(QUAFFLE | BLUDGER1 | BLUDGER2 | SNITCH);
+                    return Scope::Balls;
+                }
+
+                return Scope::Skip;
+            case Scope::Team:
+                return currentKey == "players" ? Scope::Players : Scope::Skip;
+            case Scope::Players: {
+                auto &teamFrame = team == 0 ? snapshot.leftTeam : snapshot.rightTeam;
+                std::array<std::pair<const char *, PlayerFrame *>, PLAYERS_PER_TEAM> players{{
+                        {"seeker", &teamFrame.seeker}, {"keeper", &teamFrame.keeper},
+                        {"chaser1", &teamFrame.chasers[0]}, {"chaser2", &teamFrame.chasers[1]},
+                        {"chaser3", &teamFrame.chasers[2]}, {"beater1", &teamFrame.beaters[0]},
+                        {"beater2", &teamFrame.beaters[1]}}};
+                for (unsigned int i = 0; i < players.size(); i++) {
+                    if (currentKey == players[i].first) {
+                        player = players[i].second;
+                        *player = {};
+                        position = &player->position;
+                        coordinatesSeen = 0;
+                        pendingFlag = teamPlayer(team, i);
+                        inSnitch = false;
+                        return Scope::Player;
+                    }
+                }
+
+                return Scope::Skip;
+            }
+            case Scope::Fans:
+                (team == 0 ? snapshot.leftTeam : snapshot.rightTeam).fans.emplace_back();
+                return Scope::Fan;
+            case Scope::Balls:
+                coordinatesSeen = 0;
+                inSnitch = currentKey == "snitch";
+                if (currentKey == "quaffle") {
+                    position = &snapshot.quaffle;
+                    pendingFlag = QUAFFLE;
+                } else if (currentKey == "bludger1") {
+                    position = &snapshot.bludger1;
+                    pendingFlag = BLUDGER1;
+                } else if (currentKey == "bludger2") {
+                    position = &snapshot.bludger2;
+                    pendingFlag = BLUDGER2;
+                } else if (currentKey == "snitch") {
+                    position = &snapshot.snitch.emplace();
+                    pendingFlag = SNITCH;
+                } else {
+                    return Scope::Skip;
+                }
+
+                return Scope::Position;
+            case Scope::Cubes:
+                position = &snapshot.wombatCubes.emplace_back();
+                coordinatesSeen = 0;
+                pendingFlag = 0;
+                inSnitch = false;
+                return Scope::Position;
+            default:
+                return Scope::Skip;
+        }
+    }
+
+    auto MessageParser::arrayScope(Scope parent) -> Scope {
+        if (parent == Scope::Payload && currentKey == "wombatCubes") {
+            snapshot.wombatCubes.clear();
+            seen |= WOMBAT_CUBES;
+            return Scope::Cubes;
+        }
+
+        if (parent == Scope::Team && currentKey == "fans") {
+            (team == 0 ? snapshot.leftTeam : snapshot.rightTeam).fans.clear();
+            seen |= teamFans(team);
+            return Scope::Fans;
+        }
+
+        return Scope::Skip;
+    }
+
+    bool MessageParser::value(const Value &value) {
+        using namespace messages::types;
+        if (depth == 0) {
+            return false;
+        }
+
+        bool isNull = value.type == Value::Type::Null;
+        bool isBool = value.type == Value::Type::Boolean;
+        bool isInt = value.type == Value::Type::Integer;
+        bool isString = value.type == Value::Type::String;
+        auto toInt = [&value]() { return static_cast<int>(value.integer); };
+        auto toBool = [&value]() { return value.boolean; };
+        switch (scopes[depth - 1]) {
+            case Scope::Root:
+                if (currentKey == "payloadType") {
+                    if (!isString) {
+                        return false;
+                    }
+
+                    payloadType = *value.string;
+                }
+
+                return true;
+            case Scope::Payload:
+                if (currentKey == "phase") {
+                    if (!isString) {
+                        return false;
+                    }
+
+                    snapshot.phase = fromStringPhaseType(*value.string);
+                    seen |= PHASE;
+                } else if (currentKey == "round") {
+                    if (!isInt) {
+                        return false;
+                    }
+
+                    snapshot.round = toInt();
+                    seen |= ROUND;
+                } else if (currentKey == "goalWasThrownThisRound") {
+                    if (!isBool) {
+                        return false;
+                    }
+
+                    snapshot.goalWasThrownThisRound = value.boolean;
+                    seen |= GOAL_THROWN;
+                } else if (currentKey == "entityId") {
+                    if (!isString) {
+                        return false;
+                    }
+
+                    nextEntity = fromStringEntityId(*value.string);
+                    seen |= NEXT_ENTITY;
+                } else if (currentKey == "type") {
+                    if (!isString) {
+                        return false;
+                    }
+
+                    nextTurnType = fromStringTurnType(*value.string);
+                    seen |= NEXT_TYPE;
+                } else if (currentKey == "timeout") {
+                    if (!isInt) {
+                        return false;
+                    }
+
+                    nextTimeout = toInt();
+                    seen |= NEXT_TIMEOUT;
+                } else if (currentKey == "lastDeltaBroadcast" || currentKey == "leftTeam" ||
+                           currentKey == "rightTeam" || currentKey == "balls" || currentKey == "wombatCubes") {
+                    return false;
+                }
+
+                return true;
+            case Scope::Delta: {
+                auto &delta = snapshot.lastDelta;
+                auto text = [&value]() { return *value.string; };
+                if (currentKey == "deltaType") {
+                    if (!isString) {
+                        return false;
+                    }
+
+                    delta.deltaType = fromStringDeltaType(*value.string);
+                    seen |= DELTA_TYPE;
+                    return true;
+                } else if (currentKey == "success") {
+                    return assignOptional(delta.success, isNull, isBool, toBool);
+                } else if (currentKey == "xPosOld") {
+                    return assignOptional(delta.xPosOld, isNull, isInt, toInt);
+                } else if (currentKey == "yPosOld") {
+                    return assignOptional(delta.yPosOld, isNull, isInt, toInt);
+                } else if (currentKey == "xPosNew") {
+                    return assignOptional(delta.xPosNew, isNull, isInt, toInt);
+                } else if (currentKey == "yPosNew") {
+                    return assignOptional(delta.yPosNew, isNull, isInt, toInt);
+                } else if (currentKey == "leftPoints") {
+                    return assignOptional(delta.leftPoints, isNull, isInt, toInt);
+                } else if (currentKey == "rightPoints") {
+                    return assignOptional(delta.rightPoints, isNull, isInt, toInt);
+                } else if (currentKey == "round") {
+                    return assignOptional(delta.round, isNull, isInt, toInt);
+                } else if (currentKey == "activeEntity") {
+                    return assignOptional(delta.activeEntity, isNull, isString,
+                                          [&]() { return fromStringEntityId(text()); });
+                } else if (currentKey == "passiveEntity") {
+                    return assignOptional(delta.passiveEntity, isNull, isString,
+                                          [&]() { return fromStringEntityId(text()); });
+                } else if (currentKey == "phase") {
+                    return assignOptional(delta.phase, isNull, isString,
+                                          [&]() { return fromStringPhaseType(text()); });
+                } else if (currentKey == "banReason") {
+                    return assignOptional(delta.banReason, isNull, isString,
+                                          [&]() { return fromStringBanReason(text()); });
+                }
+
+                return true;
+            }
+            case Scope::Team:
+                if (currentKey == "points") {
+                    if (!isInt) {
+                        return false;
+                    }
+
+                    (team == 0 ? snapshot.leftTeam : snapshot.rightTeam).points = toInt();
+                    seen |= teamPoints(team);
+                } else if (currentKey == "fans" || currentKey == "players") {
+                    return false;
+                }
+
+                return true;
+            case Scope::Player:
+            case Scope::Position:
+                if (currentKey == "xPos" || currentKey == "yPos") {
+                    if (isNull && inSnitch) {
+                        snitchNull = true;
+                        return true;
+                    }
+
+                    if (!isInt) {
+                        return false;
+                    }
+
+                    (currentKey == "xPos" ? position->first : position->second) = toInt();
+                    coordinatesSeen |= currentKey == "xPos" ? X_SEEN : Y_SEEN;
+                    return true;
+                }
+
+                if (scopes[depth - 1] == Scope::Player) {
+                    std::array<std::pair<const char *, bool *>, 5> flags{{
+                            {"banned", &player->banned}, {"knockout", &player->knockout},
+                            {"turnUsed", &player->turnUsed}, {"holdsQuaffle", &player->holdsQuaffle},
+                            {"holdsBludger", &player->holdsBludger}}};
+                    for (const auto &flag : flags) {
+                        if (currentKey == flag.first) {
+                            if (!isBool) {
+                                return false;
+                            }
+
+                            *flag.second = value.boolean;
+                        }
+                    }
+                }
+
+                return true;
+            case Scope::Fan: {
+                auto &fan = (team == 0 ? snapshot.leftTeam : snapshot.rightTeam).fans.back();
+                if (currentKey == "fanType") {
+                    if (!isString) {
+                        return false;
+                    }
+
+                    fan.fanType = fromStringFanType(*value.string);
+                } else if (currentKey == "banned" || currentKey == "turnUsed") {
+                    if (!isBool) {
+                        return false;
+                    }
+
+                    (currentKey == "banned" ? fan.banned : fan.turnUsed) = value.boolean;
+                }
+
+                return true;
+            }
+            case Scope::Balls:
+                if (currentKey == "snitch" && isNull) {
+                    snapshot.snitch.reset();
+                    seen |= SNITCH;
+                    return true;
+                }
+
+                return currentKey != "quaffle" && currentKey != "bludger1" && currentKey != "bludger2" &&
+                       currentKey != "snitch";
+            case Scope::Players:
+            case Scope::Fans:
+            case Scope::Cubes:
+                return false;
+            case Scope::Skip:
+                return true;
+        }
+
+        return false;
+    }
+}
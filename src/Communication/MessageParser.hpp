@@ -0,0 +1,113 @@
+/**
+ * @file MessageParser.hpp
+ * @brief Declares the streaming parser for incoming Snapshot and Next messages
+ */
+
+#ifndef KI_MESSAGEPARSER_HPP
+#define KI_MESSAGEPARSER_HPP
+
+#include <cstdint>
+#include <string>
+#include <SopraMessages/Message.hpp>
+#include "SnapshotFrame.hpp"
+
+namespace communication {
+    /**
+     * Parses Snapshot and Next messages with the SAX interface of nlohmann::json directly into a SnapshotFrame
+     * and a Next object that are reused for every message, no json object is built.
+     *
+     * The parser only reports a message if it is complete and every value has the expected type, everything else
+     * (other payload types, missing members, values that need a conversion) is left to the json conversions of
+     * the message library.
+     */
+    class MessageParser {
+    public:
+        enum class Result {
+            Snapshot, Next, Other
+        };
+
+        MessageParser();
+
+        /**
+         * Parses a message
+         * @param message the message as received from the server
+         * @return Snapshot or Next if the message is one of them and the respective getter returns its content,
+         * Other if the message needs to be parsed with nlohmann::json
+         */
+        auto parse(const std::string &message) -> Result;
+
+        /**
+         * The last parsed snapshot, valid until the next call to parse
+         */
+        auto getSnapshot() const -> const SnapshotFrame &;
+
+        /**
+         * The last parsed Next
+         */
+        auto getNext() const -> const messages::broadcast::Next &;
+
+        // SAX interface, called by nlohmann::json::sax_parse
+        bool null();
+        bool boolean(bool value);
+        bool number_integer(nlohmann::json::number_integer_t value);
+        bool number_unsigned(nlohmann::json::number_unsigned_t value);
+        bool number_float(nlohmann::json::number_float_t value, const nlohmann::json::string_t &string);
+        bool string(nlohmann::json::string_t &value);
+        bool start_object(std::size_t elements);
+        bool key(nlohmann::json::string_t &value);
+        bool end_object();
+        bool start_array(std::size_t elements);
+        bool end_array();
+        bool parse_error(std::size_t position, const std::string &token, const nlohmann::json::exception &exception);
+
+        template<typename Binary>
+        bool binary(Binary &) {
+            return false;
+        }
+
+    private:
+        enum class Scope : std::uint8_t {
+            Root, Payload, Delta, Team, Players, Player, Fans, Fan, Balls, Position, Cubes, Skip
+        };
+
+        /**
+         * A scalar value of the json input
+         */
+        struct Value {
+            enum class Type {
+                Null, Boolean, Integer, Float, String
+            } type;
+
+            bool boolean = false;
+            long integer = 0;
+            const std::string *string = nullptr;
+        };
+
+        static constexpr std::size_t MAX_DEPTH = 8;
+
+        bool enter(Scope scope);
+        bool value(const Value &value);
+        auto objectScope(Scope parent) -> Scope;
+        auto arrayScope(Scope parent) -> Scope;
+
+        std::array<Scope, MAX_DEPTH> scopes{};
+        std::size_t depth = 0;
+        std::string currentKey;
+        std::string payloadType;
+        std::uint64_t seen = 0;
+        unsigned int team = 0;
+        PlayerFrame *player = nullptr;
+        Coordinates *position = nullptr;
+        unsigned int coordinatesSeen = 0;
+        std::uint64_t pendingFlag = 0;
+        bool inSnitch = false;
+        bool snitchNull = false;
+        SnapshotFrame snapshot;
+        messages::types::EntityId nextEntity = messages::types::EntityId::SNITCH;
+        messages::types::TurnType nextTurnType = messages::types::TurnType::MOVE;
+        int nextTimeout = 0;
+        messages::broadcast::Next next;
+    };
+}
+
+#endif //KI_MESSAGEPARSER_HPP
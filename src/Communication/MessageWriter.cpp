@@ -0,0 +1,131 @@
+/**
+ * @file MessageWriter.cpp
+ * @brief Implements the serializer for outgoing messages
+ */
+
+#include "MessageWriter.hpp"
+#include <charconv>
+#include <ctime>
+
+namespace communication {
+    constexpr std::size_t INITIAL_BUFFER_SIZE = 512;
+    constexpr int PRETTY_INDENT = 4;
+
+    MessageWriter::MessageWriter(bool prettyPrint) : prettyPrint(prettyPrint) {
+        buffer.reserve(INITIAL_BUFFER_SIZE);
+    }
+
+    auto MessageWriter::write(const messages::Message &message) -> const std::string & {
+        buffer.clear();
+        auto payload = message.getPayload();
+        const auto *deltaRequest = std::get_if<messages::request::DeltaRequest>(&payload);
+        if (prettyPrint || deltaRequest == nullptr) {
+            nlohmann::json json = message;
+            buffer.append(json.dump(prettyPrint ? PRETTY_INDENT : -1));
+            return buffer;
+        }
+
+        // Same keys in the same order as nlohmann::json would produce them
+        buffer.push_back('{');
+        writeKey("payload");
+        writeDeltaRequest(*deltaRequest);
+        buffer.push_back(',');
+        writeKey("payloadType");
+        writeString(message.getPayloadType());
+        buffer.push_back(',');
+        writeKey("timestamp");
+        writeTimestamp(message.getTimestamp());
+        buffer.push_back('}');
+        return buffer;
+    }
+
+    void MessageWriter::writeDeltaRequest(const messages::request::DeltaRequest &deltaRequest) {
+        using namespace messages::types;
+        auto toOptionalString = [](const auto &value) -> std::optional<std::string> {
+            if (value.has_value()) {
+                return toString(*value);
+            }
+
+            return std::nullopt;
+        };
+
+        buffer.push_back('{');
+        writeOptional("activeEntity", toOptionalString(deltaRequest.getActiveEntity()));
+        buffer.push_back(',');
+        writeOptional("banReason", toOptionalString(deltaRequest.getBanReason()));
+        buffer.push_back(',');
+        writeKey("deltaType");
+        writeString(toString(deltaRequest.getDeltaType()));
+        buffer.push_back(',');
+        writeOptional("leftPoints", deltaRequest.getLeftPoints());
+        buffer.push_back(',');
+        writeOptional("passiveEntity", toOptionalString(deltaRequest.getPassiveEntity()));
+        buffer.push_back(',');
+        writeOptional("phase", toOptionalString(deltaRequest.getPhase()));
+        buffer.push_back(',');
+        writeOptional("rightPoints", deltaRequest.getRightPoints());
+        buffer.push_back(',');
+        writeOptional("round", deltaRequest.getRound());
+        buffer.push_back(',');
+        writeOptional("success", deltaRequest.getSuccess());
+        buffer.push_back(',');
+        writeOptional("xPosNew", deltaRequest.getXPosNew());
+        buffer.push_back(',');
+        writeOptional("xPosOld", deltaRequest.getXPosOld());
+        buffer.push_back(',');
+        writeOptional("yPosNew", deltaRequest.getYPosNew());
+        buffer.push_back(',');
+        writeOptional("yPosOld", deltaRequest.getYPosOld());
+        buffer.push_back('}');
+    }
+
+    void MessageWriter::writeTimestamp(std::chrono::system_clock::time_point timestamp) {
+        // Format of the standard: yyyy-MM-dd HH:mm:ss.SSS
+        auto time = std::chrono::system_clock::to_time_t(timestamp);
+        auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(timestamp.time_since_epoch()).count() % 1000;
+        std::tm tm{};
+        localtime_r(&time, &tm);
+        char formatted[sizeof("yyyy-MM-dd HH:mm:ss.SSS")];
+        auto length = std::strftime(formatted, sizeof(formatted), "%Y-%m-%d %H:%M:%S", &tm);
+        buffer.push_back('"');
+        buffer.append(formatted, length);
+        buffer.push_back('.');
+        buffer.push_back(static_cast<char>('0' + millis / 100));
+        buffer.push_back(static_cast<char>('0' + millis / 10 % 10));
+        buffer.push_back(static_cast<char>('0' + millis % 10));
+        buffer.push_back('"');
+    }
+
+    void MessageWriter::writeKey(const char *key) {
+        buffer.push_back('"');
+        buffer.append(key);
+        buffer.append("\":");
+    }
+
+    void MessageWriter::writeString(const std::string &value) {
+        // Only identifiers of the standard are written, none of them needs to be escaped
+        buffer.push_back('"');
+        buffer.append(value);
+        buffer.push_back('"');
+    }
+
+    void MessageWriter::writeInt(int value) {
+        char digits[16];
+        auto result = std::to_chars(std::begin(digits), std::end(digits), value);
+        buffer.append(digits, result.ptr);
+    }
+
+    template<typename T>
+    void MessageWriter::writeOptional(const char *key, const std::optional<T> &value) {
+        writeKey(key);
+        if (!value.has_value()) {
+            buffer.append("null");
+        } else if constexpr (std::is_same_v<T, bool>) {
+            buffer.append(*value ? "true" : "false");
+        } else if constexpr (std::is_same_v<T, int>) {
+            writeInt(*value);
+        } else {
+            writeString(*value);
+        }
+    }
+}
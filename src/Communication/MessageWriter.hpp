@@ -0,0 +1,48 @@
+/**
+ * @file MessageWriter.hpp
+ * @brief Declares the serializer for outgoing messages
+ */
+
+#ifndef KI_MESSAGEWRITER_HPP
+#define KI_MESSAGEWRITER_HPP
+
+#include <string>
+#include <SopraMessages/Message.hpp>
+
+namespace communication {
+    /**
+     * Serializes outgoing messages into a buffer that is reused for every message. DeltaRequests, which are sent
+     * right after every search, are written directly without building a json object and without any whitespace.
+     * All other messages are only sent once per match and are converted via nlohmann::json.
+     */
+    class MessageWriter {
+    public:
+        /**
+         * CTor
+         * @param prettyPrint indent the output with 4 spaces, intended for debugging only
+         */
+        explicit MessageWriter(bool prettyPrint = false);
+
+        /**
+         * Serializes a message
+         * @param message the message to serialize
+         * @return the serialized message, the reference is valid until the next call
+         */
+        auto write(const messages::Message &message) -> const std::string &;
+
+    private:
+        void writeDeltaRequest(const messages::request::DeltaRequest &deltaRequest);
+        void writeTimestamp(std::chrono::system_clock::time_point timestamp);
+        void writeKey(const char *key);
+        void writeString(const std::string &value);
+        void writeInt(int value);
+
+        template<typename T>
+        void writeOptional(const char *key, const std::optional<T> &value);
+
+        bool prettyPrint;
+        std::string buffer;
+    };
+}
+
+#endif //KI_MESSAGEWRITER_HPP
@@ -0,0 +1,80 @@
+/**
+ * @file SnapshotFrame.cpp
+ * @brief Implements the plain representation of a Snapshot filled by the streaming parser
+ */
+
+#include "SnapshotFrame.hpp"
+#include <algorithm>
+
+namespace communication {
+    namespace {
+        auto teamFromSnapshot(const messages::broadcast::TeamSnapshot &team) -> TeamFrame {
+            TeamFrame ret;
+            ret.points = team.getPoints();
+            ret.fans = team.getFans();
+#define KI_PLAYER_FRAME(NAME) PlayerFrame{{team.get##NAME##X(), team.get##NAME##Y()}, team.is##NAME##Banned(), \
+        team.is##NAME##Knockout(), team.is##NAME##TurnUsed(), team.is##NAME##HoldsQuaffle(), \
+        team.is##NAME##HoldsBludger()}
+            ret.seeker = KI_PLAYER_FRAME(Seeker);
+            ret.keeper = KI_PLAYER_FRAME(Keeper);
+            ret.chasers = {KI_PLAYER_FRAME(Chaser1), KI_PLAYER_FRAME(Chaser2), KI_PLAYER_FRAME(Chaser3)};
+            ret.beaters = {KI_PLAYER_FRAME(Beater1), KI_PLAYER_FRAME(Beater2)};
+#undef KI_PLAYER_FRAME
+            return ret;
+        }
+    }
+
+    bool PlayerFrame::operator==(const PlayerFrame &other) const {
+        return position == other.position && banned == other.banned && knockout == other.knockout &&
+               turnUsed == other.turnUsed && holdsQuaffle == other.holdsQuaffle && holdsBludger == other.holdsBludger;
+    }
+
+    bool TeamFrame::operator==(const TeamFrame &other) const {
+        auto fanEquals = [](const messages::broadcast::Fan &a, const messages::broadcast::Fan &b) {
+            return a.fanType == b.fanType && a.banned == b.banned && a.turnUsed == b.turnUsed;
+        };
+
+        return points == other.points &&
+               std::equal(fans.begin(), fans.end(), other.fans.begin(), other.fans.end(), fanEquals) &&
+               seeker == other.seeker && keeper == other.keeper && chasers == other.chasers &&
+               beaters == other.beaters;
+    }
+
+    bool DeltaFrame::operator==(const DeltaFrame &other) const {
+        return deltaType == other.deltaType && success == other.success && xPosOld == other.xPosOld &&
+               yPosOld == other.yPosOld && xPosNew == other.xPosNew && yPosNew == other.yPosNew &&
+               activeEntity == other.activeEntity && passiveEntity == other.passiveEntity && phase == other.phase &&
+               leftPoints == other.leftPoints && rightPoints == other.rightPoints && round == other.round &&
+               banReason == other.banReason;
+    }
+
+    auto SnapshotFrame::fromSnapshot(const messages::broadcast::Snapshot &snapshot) -> SnapshotFrame {
+        SnapshotFrame ret;
+        auto delta = snapshot.getLastDeltaBroadcast();
+        ret.lastDelta = {delta.getDeltaType(), delta.isSuccess(), delta.getXPosOld(), delta.getYPosOld(),
+                         delta.getXPosNew(), delta.getYPosNew(), delta.getActiveEntity(), delta.getPassiveEntity(),
+                         delta.getPhase(), delta.getLeftPoints(), delta.getRightPoints(), delta.getRound(),
+                         delta.getBanReason()};
+        ret.phase = snapshot.getPhase();
+        ret.round = snapshot.getRound();
+        ret.leftTeam = teamFromSnapshot(snapshot.getLeftTeam());
+        ret.rightTeam = teamFromSnapshot(snapshot.getRightTeam());
+        if (snapshot.getSnitchX().has_value() && snapshot.getSnitchY().has_value()) {
+            ret.snitch = Coordinates{*snapshot.getSnitchX(), *snapshot.getSnitchY()};
+        }
+
+        ret.quaffle = {snapshot.getQuaffleX(), snapshot.getQuaffleY()};
+        ret.bludger1 = {snapshot.getBludger1X(), snapshot.getBludger1Y()};
+        ret.bludger2 = {snapshot.getBludger2X(), snapshot.getBludger2Y()};
+        ret.wombatCubes = snapshot.getWombatCubes();
+        ret.goalWasThrownThisRound = snapshot.isGoalWasThrownThisRound();
+        return ret;
+    }
+
+    bool SnapshotFrame::operator==(const SnapshotFrame &other) const {
+        return lastDelta == other.lastDelta && phase == other.phase && round == other.round &&
+               leftTeam == other.leftTeam && rightTeam == other.rightTeam && snitch == other.snitch &&
+               quaffle == other.quaffle && bludger1 == other.bludger1 && bludger2 == other.bludger2 &&
+               wombatCubes == other.wombatCubes && goalWasThrownThisRound == other.goalWasThrownThisRound;
+    }
+}
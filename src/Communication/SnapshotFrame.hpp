@@ -0,0 +1,89 @@
+/**
+ * @file SnapshotFrame.hpp
+ * @brief Declares the plain representation of a Snapshot filled by the streaming parser
+ */
+
+#ifndef KI_SNAPSHOTFRAME_HPP
+#define KI_SNAPSHOTFRAME_HPP
+
+#include <array>
+#include <optional>
+#include <utility>
+#include <vector>
+#include <SopraMessages/Snapshot.hpp>
+
+namespace communication {
+    using Coordinates = std::pair<int, int>;
+
+    struct PlayerFrame {
+        Coordinates position;
+        bool banned = false;
+        bool knockout = false;
+        bool turnUsed = false;
+        bool holdsQuaffle = false;
+        bool holdsBludger = false;
+
+        bool operator==(const PlayerFrame &other) const;
+    };
+
+    struct TeamFrame {
+        int points = 0;
+        std::vector<messages::broadcast::Fan> fans;
+        PlayerFrame seeker;
+        PlayerFrame keeper;
+        std::array<PlayerFrame, 3> chasers;
+        std::array<PlayerFrame, 2> beaters;
+
+        bool operator==(const TeamFrame &other) const;
+    };
+
+    /**
+     * Same members as messages::broadcast::DeltaBroadcast
+     */
+    struct DeltaFrame {
+        messages::types::DeltaType deltaType = messages::types::DeltaType::SKIP;
+        std::optional<bool> success;
+        std::optional<int> xPosOld;
+        std::optional<int> yPosOld;
+        std::optional<int> xPosNew;
+        std::optional<int> yPosNew;
+        std::optional<messages::types::EntityId> activeEntity;
+        std::optional<messages::types::EntityId> passiveEntity;
+        std::optional<messages::types::PhaseType> phase;
+        std::optional<int> leftPoints;
+        std::optional<int> rightPoints;
+        std::optional<int> round;
+        std::optional<messages::types::BanReason> banReason;
+
+        bool operator==(const DeltaFrame &other) const;
+    };
+
+    /**
+     * Everything the KI uses from a Snapshot as plain members. The streaming parser fills a single instance
+     * for every snapshot, the vectors keep their capacity between snapshots.
+     */
+    struct SnapshotFrame {
+        DeltaFrame lastDelta;
+        messages::types::PhaseType phase = messages::types::PhaseType::BALL_PHASE;
+        int round = 0;
+        TeamFrame leftTeam;
+        TeamFrame rightTeam;
+        std::optional<Coordinates> snitch;
+        Coordinates quaffle;
+        Coordinates bludger1;
+        Coordinates bludger2;
+        std::vector<Coordinates> wombatCubes;
+        bool goalWasThrownThisRound = false;
+
+        /**
+         * Converts a Snapshot obtained from a json object
+         * @param snapshot the snapshot to convert
+         * @return the frame with the same content
+         */
+        static auto fromSnapshot(const messages::broadcast::Snapshot &snapshot) -> SnapshotFrame;
+
+        bool operator==(const SnapshotFrame &other) const;
+    };
+}
+
+#endif //KI_SNAPSHOTFRAME_HPP
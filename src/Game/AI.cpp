@@ -3,323 +3,468 @@
 //
 
 #include "AI.h"
+#include "IncrementalEval.hpp"
+#include "EvalCache.hpp"
+#include "OvertimeTable.hpp"
+#include "PathTable.hpp"
 #include <SopraGameLogic/GameModel.h>
 #include <SopraGameLogic/GameController.h>
 #include <SopraGameLogic/conversions.h>
 #include <SopraAITools/AITools.h>
+#include <algorithm>
+#include <bitset>
 #include <iostream>
 
 namespace ai{
 
-    double evalState(const std::shared_ptr<const gameModel::Environment> &env, gameModel::TeamSide mySide,
-                     bool goalScoredThisRound) {
-
-        constexpr auto disqPenalty = 2000;
-        constexpr auto unbanDiscountFactor = 150;
-        constexpr auto maxBanCount = 3;
-        constexpr auto farBehindPenalty = 3000;
-        constexpr auto leadBonus = 1000;
-        constexpr auto scoreDiffFarBehindDiscountFactor = 300;
-        constexpr auto scoreDiffDiscountFactor = 200;
-        constexpr auto scoreDiffInLeadDiscountFactor = 100;
-
-        double val = 0;
-        auto localEnv = env->clone();
-        auto valTeam1 = evalTeam(localEnv->getTeam(gameModel::TeamSide::LEFT), localEnv);
-        auto valTeam2 = evalTeam(localEnv->getTeam(gameModel::TeamSide::RIGHT), localEnv);
-        auto valBludgers = evalBludgers(localEnv, mySide);
-
-        //Assume the KI plays left
-        val = valTeam1 - valTeam2;
-        val += mySide == gameModel::TeamSide::LEFT ? valBludgers : -valBludgers;
-
-        int bannedTeam1 = localEnv->getTeam(gameModel::TeamSide::LEFT)->numberOfBannedMembers();
-        int bannedTeam2 = localEnv->getTeam(gameModel::TeamSide::RIGHT)->numberOfBannedMembers();
-
-        if(bannedTeam1 >= maxBanCount) {
-            val -= disqPenalty;
-        } else if(goalScoredThisRound) {
-            val += bannedTeam1 * unbanDiscountFactor;
+    namespace {
+        auto scoreDiffOf(gameModel::TeamSide side, int leftScore, int rightScore) -> int {
+            return side == gameModel::TeamSide::LEFT ? leftScore - rightScore : rightScore - leftScore;
         }
 
-        if(bannedTeam2 >= maxBanCount) {
-            val += disqPenalty;
-        } else if(goalScoredThisRound) {
-            val -= bannedTeam2 * unbanDiscountFactor;
+        bool isInOwnRestrictedZone(gameModel::TeamSide side, const gameModel::Position &position) {
+            return gameModel::Environment::getCell(position) ==
+                   (side == gameModel::TeamSide::LEFT ? gameModel::Cell::RestrictedLeft : gameModel::Cell::RestrictedRight);
         }
 
-        int scoreDiff = localEnv->getTeam(gameModel::TeamSide::LEFT)->score -
-                            localEnv->getTeam(gameModel::TeamSide::RIGHT)->score;
-        if(scoreDiff < -gameController::SNITCH_POINTS) {
-            val += -farBehindPenalty + scoreDiff * scoreDiffFarBehindDiscountFactor;
-        } else if(scoreDiff > gameController::SNITCH_POINTS) {
-            val += leadBonus + scoreDiff * scoreDiffInLeadDiscountFactor;
-        } else {
-            val += scoreDiff * scoreDiffDiscountFactor;
+        auto sideOf(std::size_t player) -> gameModel::TeamSide {
+            return player < PLAYERS_PER_TEAM ? gameModel::TeamSide::LEFT : gameModel::TeamSide::RIGHT;
         }
 
-        //If the KI does not play left, return negative val
-        return mySide == gameModel::TeamSide::LEFT ? val : -val;
-    }
+        /**
+         * Team of the player standing on the quaffle, banned players are not on the pitch. Checks the players directly,
+         * building an OccupancyGrid only pays off for more than a single lookup.
+         */
+        auto quaffleHolderSide(const gameModel::Environment &env) -> std::optional<gameModel::TeamSide> {
+            const auto &quaffle = env.quaffle->position;
+            auto holdsQuaffle = [&quaffle](const auto &player) { return !player->isFined && player->position == quaffle; };
+            for (const auto *team : {env.team1.get(), env.team2.get()}) {
+                if (holdsQuaffle(team->keeper) || holdsQuaffle(team->seeker) ||
+                    std::any_of(team->chasers.begin(), team->chasers.end(), holdsQuaffle) ||
+                    std::any_of(team->beaters.begin(), team->beaters.end(), holdsQuaffle)) {
+                    return team->getSide();
+                }
+            }
 
-    double evalTeam(const std::shared_ptr<const gameModel::Team> &team, const std::shared_ptr<gameModel::Environment> &env) {
-        double val = 0;
-        val += evalSeeker(team->seeker, env);
-        val += evalKeeper(team->keeper, env);
-        for(const auto &chaser : team->chasers){
-            val += evalChaser(chaser, env);
+            return std::nullopt;
         }
 
-        return val;
-
-    }
+        /**
+         * Same as getHighestGoalRate(const ShotTable &, ...) for a player of the given side
+         */
+        auto goalRateOf(const ShotTable &shots, const gameModel::Environment &env, gameModel::TeamSide side) -> double {
+            auto otherSide = side == gameModel::TeamSide::LEFT ? gameModel::TeamSide::RIGHT : gameModel::TeamSide::LEFT;
+            return shots.highestGoalRate(side, toCell(env.quaffle->position), ShotTable::occupancy(env, otherSide));
+        }
 
-    double evalSeeker(const std::shared_ptr<const gameModel::Seeker> &seeker,
-                      const std::shared_ptr<const gameModel::Environment> &env) {
-        constexpr auto optimalPathThreshold = 5;
-        constexpr auto gameLosePenalty = 2000;
-        constexpr auto baseSnitchdistanceDiscount = 200.0;
-        constexpr auto winSnitchDistanceDiscount = 1000.0;
-        constexpr auto nearCenterDiscount = 10.0;
-        constexpr auto baseVal = 500;
-        constexpr auto knockoutPenalty = 500;
+        /**
+         * Everything the per player terms of evalState depend on, taken from either an Environment or a SearchState
+         */
+        struct PlayerTerms {
+            gameModel::TeamSide side;
+            gameModel::Position position;
+            bool knockedOut;
+            bool banned;
+            int scoreDiff;
+        };
 
-        constexpr auto centerX = 8;
-        constexpr auto centerY = 6;
+        auto seekerValue(const PlayerTerms &seeker, bool snitchExists, const gameModel::Position &snitch,
+                         double catchSnitch, const CellSet &cubes) -> double {
+            constexpr auto optimalPathThreshold = 5;
+            constexpr auto gameLosePenalty = 2000;
+            constexpr auto baseSnitchdistanceDiscount = 200.0;
+            constexpr auto winSnitchDistanceDiscount = 1000.0;
+            constexpr auto nearCenterDiscount = 10.0;
+            constexpr auto baseVal = 500;
+            constexpr auto knockoutPenalty = 500;
 
-        double val = 0;
+            constexpr auto centerX = 8;
+            constexpr auto centerY = 6;
 
-        if(seeker->isFined) {
-            return val;
-        } else {
-            val += baseVal;
-        }
-        if(seeker->knockedOut){
-            val -= knockoutPenalty;
-        }
+            double val = 0;
 
-        int scoreDiff = 0;
-        if(env->team1->hasMember(seeker)) {
-            scoreDiff = env->team1->score - env->team2->score;
-        } else {
-            scoreDiff = env->team2->score - env->team1->score;
-        }
+            if(seeker.banned) {
+                return val;
+            } else {
+                val += baseVal;
+            }
+            if(seeker.knockedOut){
+                val -= knockoutPenalty;
+            }
 
-        if(env->snitch->exists){
-            if(scoreDiff < -gameController::SNITCH_POINTS){
-                if(seeker->position == env->snitch->position){
-                    val = -gameLosePenalty * env->config.getGameDynamicsProbs().catchSnitch;
-                }
-                else{
-                    val = baseSnitchdistanceDiscount / gameController::getDistance(seeker->position, env->snitch->position);
+            if(snitchExists){
+                auto snitchDistance = gameController::getDistance(seeker.position, snitch);
+                if(seeker.scoreDiff < -gameController::SNITCH_POINTS){
+                    if(seeker.position == snitch){
+                        val = -gameLosePenalty * catchSnitch;
+                    }
+                    else{
+                        val = baseSnitchdistanceDiscount / snitchDistance;
+                    }
                 }
-            }
-            else {
-                if(gameController::getDistance(seeker->position, env->snitch->position) > optimalPathThreshold) {
-                    val = winSnitchDistanceDiscount / (gameController::getDistance(seeker->position, env->snitch->position) + 1);
-                } else {
-                    val = winSnitchDistanceDiscount / (aiTools::computeOptimalPath(seeker, env->snitch->position, env).size() + 1);
+                else {
+                    if(snitchDistance > optimalPathThreshold) {
+                        val = winSnitchDistanceDiscount / (snitchDistance + 1);
+                    } else {
+                        auto length = PathTable::shortestDistance(toCell(seeker.position), toCell(snitch), cubes);
+                        // Same value as the length of the path returned by aiTools::computeOptimalPath plus one
+                        val = winSnitchDistanceDiscount / (length == PathTable::UNREACHABLE ? 1 : length + 2);
+                    }
                 }
+            } else{
+                val += nearCenterDiscount / (gameController::getDistance(seeker.position, gameModel::Position(centerX, centerY)) + 1);
             }
-        } else{
-            val += nearCenterDiscount / (gameController::getDistance(seeker->position, gameModel::Position(centerX, centerY)) + 1);
-        }
-
-        return val;
-    }
-
-    double
-    evalKeeper(const std::shared_ptr<gameModel::Keeper> &keeper, const std::shared_ptr<gameModel::Environment> &env) {
-        constexpr auto holdsQuaffleBaseDiscount = 450;
-        constexpr auto keeperBonusEvenWinChance = 20;
-        constexpr auto keeperBonusHighWinChance = 500;
-        constexpr auto goalChanceDiscountFactorBehind = 1000;
-        constexpr auto goalChanceDiscountFactorInLead = 200;
-        constexpr auto goalChanceDiscountFactorEven = 500;
-        constexpr auto baseQuaffleDistanceDiscount = 150.0;
-        constexpr auto goalPotentialChanceDiscountFactorBehind = 500;
-        constexpr auto goalPotentialChanceDiscountFactorInLead = 100;
-        constexpr auto goalPotentialChanceDiscountFactorEven = 200;
-        constexpr auto baseVal = 450;
-        constexpr auto keeperBonusPotentialEvenWinChance = 10;
-        constexpr auto keeperBonusPotentialHighWinChance = 200;
-        constexpr auto knockoutPenalty = 500;
 
-        double val = 0;
-        int scoreDiff = 0;
-        if(env->team1->hasMember(keeper)) {
-            scoreDiff = env->team1->score - env->team2->score;
-        } else {
-            scoreDiff = env->team2->score - env->team1->score;
-        }
-
-        if (keeper->isFined || keeper->knockedOut) {
             return val;
-        } else{
-            val += baseVal;
-        }
-        if(keeper->knockedOut){
-            val -= knockoutPenalty;
         }
 
-        //If keeper has quaffle
-        if (keeper->position == env->quaffle->position) {
-            val += holdsQuaffleBaseDiscount;
-            if (env->isPlayerInOwnRestrictedZone(keeper)) {
-                if (scoreDiff >= -gameController::SNITCH_POINTS) {
-                    val += keeperBonusEvenWinChance;
-                } else if (scoreDiff > gameController::SNITCH_POINTS) {
-                    val += keeperBonusHighWinChance;
-                }
-            } else {
-                if(scoreDiff < -gameController::SNITCH_POINTS) {
-                    val += getHighestGoalRate(env, keeper) * goalChanceDiscountFactorBehind;
-                } else if(scoreDiff > gameController::SNITCH_POINTS) {
-                    val += getHighestGoalRate(env, keeper) * goalChanceDiscountFactorInLead;
-                } else {
-                    val += getHighestGoalRate(env, keeper) * goalChanceDiscountFactorEven;
-                }
+        template<typename GoalRate>
+        auto keeperValue(const PlayerTerms &keeper, const gameModel::Position &quaffle, bool teamHasQuaffle,
+                         const GoalRate &goalRate) -> double {
+            constexpr auto holdsQuaffleBaseDiscount = 450;
+            constexpr auto keeperBonusEvenWinChance = 20;
+            constexpr auto keeperBonusHighWinChance = 500;
+            constexpr auto goalChanceDiscountFactorBehind = 1000;
+            constexpr auto goalChanceDiscountFactorInLead = 200;
+            constexpr auto goalChanceDiscountFactorEven = 500;
+            constexpr auto baseQuaffleDistanceDiscount = 150.0;
+            constexpr auto goalPotentialChanceDiscountFactorBehind = 500;
+            constexpr auto goalPotentialChanceDiscountFactorInLead = 100;
+            constexpr auto goalPotentialChanceDiscountFactorEven = 200;
+            constexpr auto baseVal = 450;
+            constexpr auto keeperBonusPotentialEvenWinChance = 10;
+            constexpr auto keeperBonusPotentialHighWinChance = 200;
+            constexpr auto knockoutPenalty = 500;
+
+            double val = 0;
+            auto scoreDiff = keeper.scoreDiff;
+            if (keeper.banned || keeper.knockedOut) {
+                return val;
+            } else{
+                val += baseVal;
+            }
+            if(keeper.knockedOut){
+                val -= knockoutPenalty;
             }
-        } else {
-            if(teamHasQuaffle(env, keeper)) {
-                if(scoreDiff < -gameController::SNITCH_POINTS) {
-                    val += getHighestGoalRate(env, keeper) * goalPotentialChanceDiscountFactorBehind;
-                } else if(scoreDiff > gameController::SNITCH_POINTS) {
-                    val += getHighestGoalRate(env, keeper) * goalPotentialChanceDiscountFactorInLead;
-                } else {
-                    val += getHighestGoalRate(env, keeper) * goalPotentialChanceDiscountFactorEven;
-                }
 
-                if (env->isPlayerInOwnRestrictedZone(keeper)) {
-                    if(scoreDiff > gameController::SNITCH_POINTS) {
-                        val += keeperBonusPotentialHighWinChance;
-                    } else if(scoreDiff >= -gameController::SNITCH_POINTS) {
-                        val += keeperBonusPotentialEvenWinChance;
+            //If keeper has quaffle
+            if (keeper.position == quaffle) {
+                val += holdsQuaffleBaseDiscount;
+                if (isInOwnRestrictedZone(keeper.side, keeper.position)) {
+                    if (scoreDiff >= -gameController::SNITCH_POINTS) {
+                        val += keeperBonusEvenWinChance;
+                    } else if (scoreDiff > gameController::SNITCH_POINTS) {
+                        val += keeperBonusHighWinChance;
+                    }
+                } else {
+                    if(scoreDiff < -gameController::SNITCH_POINTS) {
+                        val += goalRate() * goalChanceDiscountFactorBehind;
+                    } else if(scoreDiff > gameController::SNITCH_POINTS) {
+                        val += goalRate() * goalChanceDiscountFactorInLead;
+                    } else {
+                        val += goalRate() * goalChanceDiscountFactorEven;
                     }
                 }
             } else {
-                val += baseQuaffleDistanceDiscount / gameController::getDistance(keeper->position, env->quaffle->position);
-            }
-
-        }
-
-        return val;
-    }
+                if(teamHasQuaffle) {
+                    if(scoreDiff < -gameController::SNITCH_POINTS) {
+                        val += goalRate() * goalPotentialChanceDiscountFactorBehind;
+                    } else if(scoreDiff > gameController::SNITCH_POINTS) {
+                        val += goalRate() * goalPotentialChanceDiscountFactorInLead;
+                    } else {
+                        val += goalRate() * goalPotentialChanceDiscountFactorEven;
+                    }
 
-    double evalChaser(const std::shared_ptr<gameModel::Chaser> &chaser,
-                      const std::shared_ptr<gameModel::Environment> &env) {
-        constexpr auto goalChanceDiscountFactorBehind = 1000;
-        constexpr auto goalChanceDiscountFactorInLead = 200;
-        constexpr auto goalChanceDiscountFactorEven = 600;
-        constexpr auto baseQuaffleDistanceDiscount = 150.0;
-        constexpr auto holdsQuaffleBaseDiscount = 450;
-        constexpr auto goalPotentialChanceDiscountFactorBehind = 500;
-        constexpr auto goalPotentialChanceDiscountFactorInLead = 100;
-        constexpr auto goalPotentialChanceDiscountFactorEven = 200;
-        constexpr auto goalVirtualChanceDiscountFactorBehind = 200;
-        constexpr auto goalVirtualChanceDiscountFactorInLead = 0;
-        constexpr auto goalVirtualChanceDiscountFactorEven = 100;
-        constexpr auto baseVal = 300;
-        constexpr auto knockoutPenalty = 500;
+                    if (isInOwnRestrictedZone(keeper.side, keeper.position)) {
+                        if(scoreDiff > gameController::SNITCH_POINTS) {
+                            val += keeperBonusPotentialHighWinChance;
+                        } else if(scoreDiff >= -gameController::SNITCH_POINTS) {
+                            val += keeperBonusPotentialEvenWinChance;
+                        }
+                    }
+                } else {
+                    val += baseQuaffleDistanceDiscount / gameController::getDistance(keeper.position, quaffle);
+                }
 
-        double val = 0;
-        int scoreDiff = 0;
+            }
 
-        if (chaser->isFined || chaser->knockedOut) {
             return val;
-        } else {
-            val += baseVal;
-        }
-        if(chaser->knockedOut){
-            val -= knockoutPenalty;
         }
 
-        if(env->team1->hasMember(chaser)){
-            scoreDiff = env->team1->score - env->team2->score;
-        } else {
-            scoreDiff = env->team2->score - env->team1->score;
-        }
+        template<typename GoalRate>
+        auto chaserValue(const PlayerTerms &chaser, const gameModel::Position &quaffle, bool teamHasQuaffle,
+                         const GoalRate &goalRate) -> double {
+            constexpr auto goalChanceDiscountFactorBehind = 1000;
+            constexpr auto goalChanceDiscountFactorInLead = 200;
+            constexpr auto goalChanceDiscountFactorEven = 600;
+            constexpr auto baseQuaffleDistanceDiscount = 150.0;
+            constexpr auto holdsQuaffleBaseDiscount = 450;
+            constexpr auto goalPotentialChanceDiscountFactorBehind = 500;
+            constexpr auto goalPotentialChanceDiscountFactorInLead = 100;
+            constexpr auto goalPotentialChanceDiscountFactorEven = 200;
+            constexpr auto goalVirtualChanceDiscountFactorBehind = 200;
+            constexpr auto goalVirtualChanceDiscountFactorInLead = 0;
+            constexpr auto goalVirtualChanceDiscountFactorEven = 100;
+            constexpr auto baseVal = 300;
+            constexpr auto knockoutPenalty = 500;
 
-        //If Chaser holds quaffle
-        if (chaser->position == env->quaffle->position) {
-            val += holdsQuaffleBaseDiscount;
-            if(scoreDiff < -gameController::SNITCH_POINTS) {
-                val += getHighestGoalRate(env, chaser) * goalChanceDiscountFactorBehind;
-            } else if(scoreDiff > gameController::SNITCH_POINTS) {
-                val += getHighestGoalRate(env, chaser) * goalChanceDiscountFactorInLead;
+            double val = 0;
+            auto scoreDiff = chaser.scoreDiff;
+
+            if (chaser.banned || chaser.knockedOut) {
+                return val;
             } else {
-                val += getHighestGoalRate(env, chaser) * goalChanceDiscountFactorEven;
+                val += baseVal;
             }
-        } else {
-            if(teamHasQuaffle(env, chaser)) {
+            if(chaser.knockedOut){
+                val -= knockoutPenalty;
+            }
+
+            //If Chaser holds quaffle
+            if (chaser.position == quaffle) {
+                val += holdsQuaffleBaseDiscount;
                 if(scoreDiff < -gameController::SNITCH_POINTS) {
-                    val += getHighestGoalRate(env, chaser) * goalPotentialChanceDiscountFactorBehind;
+                    val += goalRate() * goalChanceDiscountFactorBehind;
                 } else if(scoreDiff > gameController::SNITCH_POINTS) {
-                    val += getHighestGoalRate(env, chaser) * goalPotentialChanceDiscountFactorInLead;
+                    val += goalRate() * goalChanceDiscountFactorInLead;
                 } else {
-                    val += getHighestGoalRate(env, chaser) * goalPotentialChanceDiscountFactorEven;
+                    val += goalRate() * goalChanceDiscountFactorEven;
                 }
             } else {
-                val += baseQuaffleDistanceDiscount / gameController::getDistance(chaser->position, env->quaffle->position);
-                if(scoreDiff < -gameController::SNITCH_POINTS) {
-                    val += getHighestGoalRate(env, chaser) * goalVirtualChanceDiscountFactorBehind;
-                } else if(scoreDiff > gameController::SNITCH_POINTS) {
-                    val += getHighestGoalRate(env, chaser) * goalVirtualChanceDiscountFactorInLead;
+                if(teamHasQuaffle) {
+                    if(scoreDiff < -gameController::SNITCH_POINTS) {
+                        val += goalRate() * goalPotentialChanceDiscountFactorBehind;
+                    } else if(scoreDiff > gameController::SNITCH_POINTS) {
+                        val += goalRate() * goalPotentialChanceDiscountFactorInLead;
+                    } else {
+                        val += goalRate() * goalPotentialChanceDiscountFactorEven;
+                    }
                 } else {
-                    val += getHighestGoalRate(env, chaser) * goalVirtualChanceDiscountFactorEven;
+                    val += baseQuaffleDistanceDiscount / gameController::getDistance(chaser.position, quaffle);
+                    if(scoreDiff < -gameController::SNITCH_POINTS) {
+                        val += goalRate() * goalVirtualChanceDiscountFactorBehind;
+                    } else if(scoreDiff > gameController::SNITCH_POINTS) {
+                        val += goalRate() * goalVirtualChanceDiscountFactorInLead;
+                    } else {
+                        val += goalRate() * goalVirtualChanceDiscountFactorEven;
+                    }
                 }
             }
+            return val;
         }
-        return val;
-    }
 
-    double evalBludgers(const std::shared_ptr<const gameModel::Environment> &env, gameModel::TeamSide mySide) {
-        constexpr auto keeperBaseThreat = 500.0;
-        constexpr auto seekerBaseThreat = 550.0;
-        constexpr auto chaserBaseThreat = 500.0;
-        constexpr auto beaterBaseThreat = 400.0;
-        constexpr auto beaterHoldsBludgerDiscount = 500;
+        /**
+         * Threat of the bludgers for a team, positions of players that are banned are NO_CELL
+         */
+        auto bludgerThreat(const std::array<Cell, PLAYERS_PER_TEAM> &players, const std::array<Cell, 2> &bludgers,
+                           bool snitchExists) -> double {
+            constexpr auto keeperBaseThreat = 500.0;
+            constexpr auto seekerBaseThreat = 550.0;
+            constexpr auto chaserBaseThreat = 500.0;
+            constexpr auto beaterBaseThreat = 400.0;
+            constexpr auto beaterHoldsBludgerDiscount = 500;
 
-        auto calcThreat = [&env, &mySide](const std::shared_ptr<const gameModel::Team> &team){
             double val = 0;
-            for(const auto &bludger : env->bludgers){
-                const auto &bPos = bludger->position;
-                //eval team1
-                if (!team->keeper->isFined && gameController::getDistance(team->keeper->position, bPos) == 1) {
+            for(auto bludger : bludgers){
+                if (players[KEEPER_OFFSET] != NO_CELL && distance(players[KEEPER_OFFSET], bludger) == 1) {
                     val -= keeperBaseThreat;
                 }
 
-                if (!team->seeker->isFined && gameController::getDistance(team->seeker->position, bPos) == 1 && env->snitch->exists) {
+                if (players[SEEKER_OFFSET] != NO_CELL && distance(players[SEEKER_OFFSET], bludger) == 1 && snitchExists) {
                     val -= seekerBaseThreat;
                 }
 
-                for (const auto &chaser : team->chasers) {
-                    if (!chaser->isFined && gameController::getDistance(bPos, chaser->position) == 1) {
+                for (auto chaser = CHASER_OFFSET; chaser < BEATER_OFFSET; chaser++) {
+                    if (players[chaser] != NO_CELL && distance(bludger, players[chaser]) == 1) {
                         val -= chaserBaseThreat;
                     }
                 }
-
-
             }
 
-            for (const auto &beater : team->beaters) {
-                auto bPos = env->bludgers[0]->position;
-
-                if(gameController::getDistance(beater->position, env->bludgers[1]->position) < gameController::getDistance(beater->position, bPos)){
-                    bPos = env->bludgers[1]->position;
+            for (auto beater = BEATER_OFFSET; beater < PLAYERS_PER_TEAM; beater++) {
+                auto bPos = bludgers[0];
+                if(distance(players[beater], bludgers[1]) < distance(players[beater], bPos)){
+                    bPos = bludgers[1];
                 }
-                if (beater->position != bPos) {
-                    val += beaterBaseThreat / gameController::getDistance(bPos, beater->position);
+                if (players[beater] != bPos) {
+                    val += beaterBaseThreat / distance(bPos, players[beater]);
                 } else {
                     val += beaterHoldsBludgerDiscount;
                 }
             }
 
-            return team->getSide() == mySide ? val : -val;
-        };
+            return val;
+        }
 
+        /**
+         * Terms of evalState that only depend on bans and scores
+         */
+        auto metaValue(int bannedLeft, int bannedRight, int leftScore, int rightScore, bool goalScoredThisRound) -> double {
+            constexpr auto disqPenalty = 2000;
+            constexpr auto unbanDiscountFactor = 150;
+            constexpr auto maxBanCount = 3;
+            constexpr auto farBehindPenalty = 3000;
+            constexpr auto leadBonus = 1000;
+            constexpr auto scoreDiffFarBehindDiscountFactor = 300;
+            constexpr auto scoreDiffDiscountFactor = 200;
+            constexpr auto scoreDiffInLeadDiscountFactor = 100;
 
-        return calcThreat(env->team1) + calcThreat(env->team2);
+            double val = 0;
+            if(bannedLeft >= maxBanCount) {
+                val -= disqPenalty;
+            } else if(goalScoredThisRound) {
+                val += bannedLeft * unbanDiscountFactor;
+            }
+
+            if(bannedRight >= maxBanCount) {
+                val += disqPenalty;
+            } else if(goalScoredThisRound) {
+                val -= bannedRight * unbanDiscountFactor;
+            }
+
+            int scoreDiff = leftScore - rightScore;
+            if(scoreDiff < -gameController::SNITCH_POINTS) {
+                val += -farBehindPenalty + scoreDiff * scoreDiffFarBehindDiscountFactor;
+            } else if(scoreDiff > gameController::SNITCH_POINTS) {
+                val += leadBonus + scoreDiff * scoreDiffInLeadDiscountFactor;
+            } else {
+                val += scoreDiff * scoreDiffDiscountFactor;
+            }
+
+            return val;
+        }
+
+        auto termsOf(const gameModel::Player &player, const gameModel::Environment &env) -> PlayerTerms {
+            auto side = gameLogic::conversions::idToSide(player.getId());
+            return {side, player.position, player.knockedOut, player.isFined,
+                    scoreDiffOf(side, env.team1->score, env.team2->score)};
+        }
+
+        auto termsOf(const SearchState &state, std::size_t player) -> PlayerTerms {
+            auto side = sideOf(player);
+            return {side, toPosition(state.players[player]), state.isKnockedOut(player), state.isBanned(player),
+                    scoreDiffOf(side, state.scores[0], state.scores[1])};
+        }
+    }
+
+    double evalState(const std::shared_ptr<const gameModel::Environment> &env, const ShotTable &shots,
+                     gameModel::TeamSide mySide, bool goalScoredThisRound) {
+        OccupancyGrid grid(*env);
+        auto valTeam1 = evalTeam(*env->team1, *env, grid, shots);
+        auto valTeam2 = evalTeam(*env->team2, *env, grid, shots);
+        auto valBludgers = evalBludgers(*env, mySide);
+
+        //Assume the KI plays left
+        double val = valTeam1 - valTeam2;
+        val += mySide == gameModel::TeamSide::LEFT ? valBludgers : -valBludgers;
+        val += metaValue(env->team1->numberOfBannedMembers(), env->team2->numberOfBannedMembers(), env->team1->score,
+                         env->team2->score, goalScoredThisRound);
+
+        //If the KI does not play left, return negative val
+        return mySide == gameModel::TeamSide::LEFT ? val : -val;
+    }
+
+    double evalState(const SearchState &state, const SearchContext &context, gameModel::TeamSide mySide) {
+        const OccupancyGrid grid(state);
+        const auto quaffle = toPosition(state.quaffle);
+        const auto snitch = toPosition(state.snitch);
+        const auto catchSnitch = context.config.getGameDynamicsProbs().catchSnitch;
+        std::array<double, 2> teams{};
+        std::array<std::array<Cell, PLAYERS_PER_TEAM>, 2> onPitch{};
+        for (std::size_t side = 0; side < 2; side++) {
+            const auto teamSide = side == 0 ? gameModel::TeamSide::LEFT : gameModel::TeamSide::RIGHT;
+            const auto first = side * PLAYERS_PER_TEAM;
+            const auto hasQuaffle = grid.teamHasQuaffle(teamSide, state.quaffle);
+            std::optional<double> goalRate;
+            auto lazyGoalRate = [&]() {
+                if (!goalRate.has_value()) {
+                    goalRate = context.shots->highestGoalRate(teamSide, state.quaffle,
+                            ShotTable::occupancy(state, side == 0 ? gameModel::TeamSide::RIGHT : gameModel::TeamSide::LEFT));
+                }
+
+                return *goalRate;
+            };
+
+            teams[side] += seekerValue(termsOf(state, first + SEEKER_OFFSET), state.snitchExists, snitch, catchSnitch,
+                                       state.cubes);
+            teams[side] += keeperValue(termsOf(state, first + KEEPER_OFFSET), quaffle, hasQuaffle, lazyGoalRate);
+            for (auto chaser = first + CHASER_OFFSET; chaser < first + BEATER_OFFSET; chaser++) {
+                teams[side] += chaserValue(termsOf(state, chaser), quaffle, hasQuaffle, lazyGoalRate);
+            }
+
+            // Beaters are part of the bludger threat even if banned, same as evalBludgers
+            for (std::size_t i = 0; i < PLAYERS_PER_TEAM; i++) {
+                onPitch[side][i] = state.isBanned(first + i) && i < BEATER_OFFSET ? NO_CELL : state.players[first + i];
+            }
+        }
+
+        auto valBludgers = bludgerThreat(onPitch[0], state.bludgers, state.snitchExists) -
+                           bludgerThreat(onPitch[1], state.bludgers, state.snitchExists);
+
+        //Assume the KI plays left
+        double val = teams[0] - teams[1] + valBludgers;
+        auto bannedLeft = static_cast<int>(std::bitset<PLAYER_COUNT>(state.banned & teamMask(gameModel::TeamSide::LEFT)).count());
+        auto bannedRight = static_cast<int>(std::bitset<PLAYER_COUNT>(state.banned & teamMask(gameModel::TeamSide::RIGHT)).count());
+        val += metaValue(bannedLeft, bannedRight, state.scores[0], state.scores[1], state.goalScoredThisRound);
+
+        //If the KI does not play left, return negative val
+        return mySide == gameModel::TeamSide::LEFT ? val : -val;
+    }
+
+    double evalTeam(const gameModel::Team &team, const gameModel::Environment &env, const OccupancyGrid &grid,
+                    const ShotTable &shots) {
+        double val = 0;
+        val += evalSeeker(*team.seeker, env);
+        val += evalKeeper(*team.keeper, env, grid, shots);
+        for(const auto &chaser : team.chasers){
+            val += evalChaser(*chaser, env, grid, shots);
+        }
+
+        return val;
+
+    }
+
+    double evalSeeker(const gameModel::Seeker &seeker, const gameModel::Environment &env) {
+        return seekerValue(termsOf(seeker, env), env.snitch->exists, env.snitch->position,
+                           env.config.getGameDynamicsProbs().catchSnitch, PathTable::obstaclesOf(env));
+    }
+
+    double evalKeeper(const gameModel::Keeper &keeper, const gameModel::Environment &env, const OccupancyGrid &grid,
+                      const ShotTable &shots) {
+        auto terms = termsOf(keeper, env);
+        return keeperValue(terms, env.quaffle->position, teamHasQuaffle(grid, env, terms.side), [&]() {
+            return goalRateOf(shots, env, terms.side);
+        });
+    }
+
+    double evalChaser(const gameModel::Chaser &chaser, const gameModel::Environment &env, const OccupancyGrid &grid,
+                      const ShotTable &shots) {
+        auto terms = termsOf(chaser, env);
+        return chaserValue(terms, env.quaffle->position, teamHasQuaffle(grid, env, terms.side), [&]() {
+            return goalRateOf(shots, env, terms.side);
+        });
+    }
+
+    double evalBludgers(const gameModel::Environment &env, gameModel::TeamSide mySide) {
+        auto cellsOf = [](const gameModel::Team &team) {
+            std::array<Cell, PLAYERS_PER_TEAM> ret{};
+            ret[SEEKER_OFFSET] = team.seeker->isFined ? NO_CELL : toCell(team.seeker->position);
+            ret[KEEPER_OFFSET] = team.keeper->isFined ? NO_CELL : toCell(team.keeper->position);
+            for (std::size_t i = 0; i < team.chasers.size(); i++) {
+                ret[CHASER_OFFSET + i] = team.chasers[i]->isFined ? NO_CELL : toCell(team.chasers[i]->position);
+            }
+
+            for (std::size_t i = 0; i < team.beaters.size(); i++) {
+                ret[BEATER_OFFSET + i] = toCell(team.beaters[i]->position);
+            }
+
+            return ret;
+        };
+
+        std::array<Cell, 2> bludgers{toCell(env.bludgers[0]->position), toCell(env.bludgers[1]->position)};
+        auto val = bludgerThreat(cellsOf(*env.team1), bludgers, env.snitch->exists) -
+                   bludgerThreat(cellsOf(*env.team2), bludgers, env.snitch->exists);
+        return mySide == gameModel::TeamSide::LEFT ? val : -val;
     }
 
     double getHighestGoalRate(const std::shared_ptr<gameModel::Environment> &env,
@@ -327,7 +472,7 @@ namespace ai{
         double chance = 0;
         auto goalPos = gameModel::Environment::getGoalsRight();
 
-        if (env->getTeam(actor)->getSide() == gameModel::TeamSide::LEFT) {
+        if (gameLogic::conversions::idToSide(actor->getId()) == gameModel::TeamSide::LEFT) {
             goalPos = env->getGoalsLeft();
         }
 
@@ -348,13 +493,19 @@ namespace ai{
     }
 
 
+    double getHighestGoalRate(const ShotTable &shots, const std::shared_ptr<const gameModel::Environment> &env,
+            const std::shared_ptr<const gameModel::Player> &actor) {
+        auto side = gameLogic::conversions::idToSide(actor->getId());
+        auto otherSide = side == gameModel::TeamSide::LEFT ? gameModel::TeamSide::RIGHT : gameModel::TeamSide::LEFT;
+        return shots.highestGoalRate(side, toCell(env->quaffle->position), ShotTable::occupancy(env, otherSide));
+    }
+
     bool teamHasQuaffle(const std::shared_ptr<const gameModel::Environment> &env, const std::shared_ptr<const gameModel::Player> &player) {
-        auto playerOnQuaffle = env->getPlayer(env->quaffle->position);
-        if(playerOnQuaffle.has_value()){
-            return env->getTeam(player)->hasMember(*playerOnQuaffle);
-        }
+        return quaffleHolderSide(*env) == gameLogic::conversions::idToSide(player->getId());
+    }
 
-        return false;
+    bool teamHasQuaffle(const OccupancyGrid &grid, const gameModel::Environment &env, gameModel::TeamSide side) {
+        return grid.teamHasQuaffle(side, toCell(env.quaffle->position));
     }
 
     double hypotheticalShotSuccessProb(const std::shared_ptr<gameModel::Environment> &env, gameModel::TeamSide teamSide){
@@ -391,6 +542,12 @@ namespace ai{
         return highestChance;
     }
 
+    double hypotheticalShotSuccessProb(const ShotTable &shots, const std::shared_ptr<const gameModel::Environment> &env,
+            gameModel::TeamSide teamSide) {
+        auto otherSide = teamSide == gameModel::TeamSide::LEFT ? gameModel::TeamSide::RIGHT : gameModel::TeamSide::LEFT;
+        return shots.hypotheticalShot(teamSide, toCell(env->quaffle->position), ShotTable::occupancy(env, otherSide));
+    }
+
     double simpleEval(const aiTools::State &state, gameModel::TeamSide mySide) {
         constexpr auto halfGoal = gameController::GOAL_POINTS / 2;
         constexpr auto disqPenalty = std::numeric_limits<int>::max();
@@ -402,10 +559,11 @@ namespace ai{
         val += scoreDiff;
 
         //Eval quaffle players
-        if(teamHasQuaffle(state.env, state.env->getTeam(mySide)->seeker)){
+        auto quaffleHolder = quaffleHolderSide(*state.env);
+        if(quaffleHolder == mySide){
             //Holding quaffle counts as half a goal
             val += halfGoal;
-        } else if(teamHasQuaffle(state.env, state.env->getTeam(otherSide)->seeker)) {
+        } else if(quaffleHolder == otherSide) {
             //Holding quaffle counts as half a goal
             val -= halfGoal;
         } else {
@@ -466,8 +624,10 @@ namespace ai{
                 }
             }
 
-            auto myDistance = gameController::getDistance(mySeeker->position, state.env->snitch->position);
-            auto opDistance = gameController::getDistance(opponentSeeker->position, state.env->snitch->position);
+            auto snitch = toCell(state.env->snitch->position);
+            auto myDistance = seekerDistance(toCell(mySeeker->position), snitch, mySeeker->knockedOut, state.overtimeState);
+            auto opDistance = seekerDistance(toCell(opponentSeeker->position), snitch, opponentSeeker->knockedOut,
+                                             state.overtimeState);
             auto distDiff = 2 * (opDistance - myDistance);
 
             if(!mySeeker->isFined && !opponentSeeker->isFined) {
@@ -518,5 +678,16 @@ namespace ai{
         return val;
     }
 
+    double simpleEval(const SearchState &state, const SearchContext &context, gameModel::TeamSide mySide) {
+        auto key = EvalCache::keyOf(state, context, mySide);
+        auto &cache = EvalCache::forThread();
+        if (auto value = cache.probe(key)) {
+            return *value;
+        }
+
+        auto value = IncrementalEval(state, context, mySide).value(state);
+        cache.store(key, value);
+        return value;
+    }
 }
 
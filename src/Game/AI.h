@@ -6,6 +6,9 @@
 #define KI_AI_H
 
 #include "Game.hpp"
+#include "SearchState.hpp"
+#include "ShotTable.hpp"
+#include "OccupancyGrid.hpp"
 #include <SopraGameLogic/GameModel.h>
 #include <SopraGameLogic/GameController.h>
 #include <SopraMessages/Message.hpp>
@@ -16,23 +19,49 @@ namespace ai {
     double simpleEval(const aiTools::State &state, gameModel::TeamSide mySide);
 
     /**
-     * Evaluates a game situation
+     * Same as simpleEval(const aiTools::State &, gameModel::TeamSide) but operating on the flat search representation.
+     * Results are kept in the EvalCache of the calling thread, see EvalCache::keyOf.
+     * @param state the state to evaluate, its key has to be up to date
+     * @param context match constants of the state
+     * @param mySide The Side that the KI is playing
+     * @return A number indicating how favorable the state is. The higher the number the better
+     */
+    double simpleEval(const SearchState &state, const SearchContext &context, gameModel::TeamSide mySide);
+
+    /**
+     * Evaluates a game situation. Goal rates are served from the ShotTable, neither env nor any other object is
+     * copied.
      * @param env Environment to evaluate
+     * @param shots shot table built from the config of env
      * @param mySide The Side that the KI is playing
      * @param goalScoredThisRound Whether or not a goal was scored this round
      * @return A number indicating how favorable the current situation is. The higher the number the better
      */
 
-    double evalState(const std::shared_ptr<const gameModel::Environment> &environment, gameModel::TeamSide mySide,
-                     bool goalScoredThisRound);
+    double evalState(const std::shared_ptr<const gameModel::Environment> &environment, const ShotTable &shots,
+                     gameModel::TeamSide mySide, bool goalScoredThisRound);
+
+    /**
+     * Same as evalState(const std::shared_ptr<const gameModel::Environment> &, const ShotTable &, gameModel::TeamSide,
+     * bool) but operating on the flat search representation. Goal rates are served from the ShotTable of the
+     * context, nothing is allocated, so it can be used as the leaf evaluation of a Search.
+     * @param state the state to evaluate
+     * @param context match constants of the state
+     * @param mySide The Side that the KI is playing
+     * @return A number indicating how favorable the state is. The higher the number the better
+     */
+    double evalState(const SearchState &state, const SearchContext &context, gameModel::TeamSide mySide);
 
     /**
      * Evaluates the positioning of players in a single team
      * @param team The team to be evaluated
      * @param env The environment the team is playing in
+     * @param grid occupancy of env
+     * @param shots shot table built from the config of env
      * @return A number indicating the value of the team
      */
-    double evalTeam(const std::shared_ptr<const gameModel::Team> &team, const std::shared_ptr<gameModel::Environment> &env);
+    double evalTeam(const gameModel::Team &team, const gameModel::Environment &env, const OccupancyGrid &grid,
+                    const ShotTable &shots);
 
     /**
      * Evaluates the positioning of a seeker
@@ -40,24 +69,29 @@ namespace ai {
      * @param env Environment the seeker is in
      * @return A number that indicates the value of the seeker
      */
-    double evalSeeker(const std::shared_ptr<const gameModel::Seeker> &seeker,
-                      const std::shared_ptr<const gameModel::Environment> &env);
+    double evalSeeker(const gameModel::Seeker &seeker, const gameModel::Environment &env);
+
     /**
      * Evaluates the positioning of a keeper
      * @param keeper Keeper to be evaluated
      * @param env Environment the keeper is in
+     * @param grid occupancy of env
+     * @param shots shot table built from the config of env
      * @return A number that indicates the value of the keeper
      */
-    double evalKeeper(const std::shared_ptr<gameModel::Keeper> &keeper, const std::shared_ptr<gameModel::Environment> &env);
+    double evalKeeper(const gameModel::Keeper &keeper, const gameModel::Environment &env, const OccupancyGrid &grid,
+                      const ShotTable &shots);
 
     /**
      * Evaluates the positioning of a chaser
      * @param chaser Chaser to be evaluated
      * @param env Environment the chaser is in
+     * @param grid occupancy of env
+     * @param shots shot table built from the config of env
      * @return A number that indicates the value of the chaser
      */
-    double evalChaser(const std::shared_ptr<gameModel::Chaser> &chaser,
-                      const std::shared_ptr<gameModel::Environment> &env);
+    double evalChaser(const gameModel::Chaser &chaser, const gameModel::Environment &env, const OccupancyGrid &grid,
+                      const ShotTable &shots);
 
     /**
      * Evaluates the positioning of the bludgers relative to the players
@@ -65,7 +99,7 @@ namespace ai {
      * @param mySide The side the KI is playing
      * @return A number indicating how good the positions of the bluders are for the KI
      */
-    double evalBludgers(const std::shared_ptr<const gameModel::Environment> &env, gameModel::TeamSide mySide);
+    double evalBludgers(const gameModel::Environment &env, gameModel::TeamSide mySide);
 
     /**
      * Calculates the chance of an actor to score a goal in any enemy goal ring
@@ -76,6 +110,17 @@ namespace ai {
     double getHighestGoalRate(const std::shared_ptr<gameModel::Environment> &env,
             const std::shared_ptr<gameModel::Player> &actor);
 
+    /**
+     * Same as getHighestGoalRate(const std::shared_ptr<gameModel::Environment> &, const std::shared_ptr<gameModel::Player> &)
+     * but served from a precomputed ShotTable
+     * @param shots shot table of the match
+     * @param env The environment where the shots happen
+     * @param actor The player that wants to shoot the quaffle
+     * @return The highest success rate of any shot resulting in a goal
+     */
+    double getHighestGoalRate(const ShotTable &shots, const std::shared_ptr<const gameModel::Environment> &env,
+            const std::shared_ptr<const gameModel::Player> &actor);
+
     /**
      * Checks if the team of the given Player has the Quaffle
      * @param env the current Environment
@@ -84,6 +129,16 @@ namespace ai {
      */
     bool teamHasQuaffle(const std::shared_ptr<const gameModel::Environment> &env, const std::shared_ptr<const gameModel::Player> &player);
 
+    /**
+     * Same as teamHasQuaffle(const std::shared_ptr<const gameModel::Environment> &, const std::shared_ptr<const gameModel::Player> &)
+     * but served from the occupancy of the environment
+     * @param grid occupancy of env
+     * @param env the current Environment
+     * @param side the Team to be checked
+     * @return true if the Team is in possession of the Quaffle, false otherwise
+     */
+    bool teamHasQuaffle(const OccupancyGrid &grid, const gameModel::Environment &env, gameModel::TeamSide side);
+
     /**
      * Calculates the theoretical chance of scoring a goal from the current position of the Quaffle
      * @param env the Environment to operate on
@@ -92,6 +147,17 @@ namespace ai {
      */
     double hypotheticalShotSuccessProb(const std::shared_ptr<gameModel::Environment> &env, gameModel::TeamSide teamSide);
 
+    /**
+     * Same as hypotheticalShotSuccessProb(const std::shared_ptr<gameModel::Environment> &, gameModel::TeamSide) but
+     * served from a precomputed ShotTable
+     * @param shots shot table of the match
+     * @param env the Environment to operate on
+     * @param teamSide side of the team to attempt the shot
+     * @return highest chance of scoring a goal if a non existing player of playing for the team held the Quaffle
+     */
+    double hypotheticalShotSuccessProb(const ShotTable &shots, const std::shared_ptr<const gameModel::Environment> &env,
+            gameModel::TeamSide teamSide);
+
 }
 
 #endif //KI_AI_H
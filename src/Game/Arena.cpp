@@ -0,0 +1,88 @@
+/**
+ * @file Arena.cpp
+ * @brief Implements the bump allocator for the temporary data of a search
+ */
+
+#include "Arena.hpp"
+#include <algorithm>
+#include <cstdint>
+
+namespace ai {
+    Arena::Scope::Scope(Arena &arena) : arena(arena), marker(arena.mark()) {}
+
+    Arena::Scope::~Scope() {
+        arena.rewind(marker);
+    }
+
+    Arena::Arena(std::size_t chunkSize) : chunkSize(chunkSize) {}
+
+    auto Arena::allocate(std::size_t bytes, std::size_t alignment) -> void * {
+        allocations++;
+        if (auto *ret = tryAllocate(bytes, alignment)) {
+            return ret;
+        }
+
+        // Chunks after the current one are left over from before a rewind, the first one that is large enough is
+        // reused, the ones skipped are reused after the next rewind
+        for (auto chunk = current + 1; chunk < chunks.size(); chunk++) {
+            current = chunk;
+            offset = 0;
+            if (auto *ret = tryAllocate(bytes, alignment)) {
+                return ret;
+            }
+        }
+
+        auto size = std::max(chunkSize, bytes + alignment);
+        chunks.push_back({std::make_unique<std::byte[]>(size), size});
+        chunkAllocations++;
+        current = chunks.size() - 1;
+        offset = 0;
+        return tryAllocate(bytes, alignment);
+    }
+
+    auto Arena::mark() const -> Marker {
+        return {current, offset};
+    }
+
+    void Arena::rewind(const Marker &marker) {
+        current = marker.chunk;
+        offset = marker.offset;
+    }
+
+    void Arena::release() {
+        rewind({0, 0});
+    }
+
+    auto Arena::getAllocations() const -> unsigned long {
+        return allocations;
+    }
+
+    auto Arena::getChunkAllocations() const -> unsigned long {
+        return chunkAllocations;
+    }
+
+    auto Arena::capacity() const -> std::size_t {
+        std::size_t ret = 0;
+        for (const auto &chunk : chunks) {
+            ret += chunk.size;
+        }
+
+        return ret;
+    }
+
+    auto Arena::tryAllocate(std::size_t bytes, std::size_t alignment) -> void * {
+        if (current >= chunks.size()) {
+            return nullptr;
+        }
+
+        auto &chunk = chunks[current];
+        auto address = reinterpret_cast<std::uintptr_t>(chunk.memory.get()) + offset;
+        auto start = offset + (alignment - address % alignment) % alignment;
+        if (start + bytes > chunk.size) {
+            return nullptr;
+        }
+
+        offset = start + bytes;
+        return chunk.memory.get() + start;
+    }
+}
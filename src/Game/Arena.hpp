@@ -0,0 +1,175 @@
+/**
+ * @file Arena.hpp
+ * @brief Declares the bump allocator for the temporary data of a search
+ */
+
+#ifndef KI_ARENA_HPP
+#define KI_ARENA_HPP
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace ai {
+    /**
+     * Bump allocator for the successor lists, move orders and converted states of one search thread. Memory is
+     * taken from chunks that are kept until the arena is destroyed, freeing single allocations does nothing.
+     * Everything allocated after a marker is released at once by rewinding to the marker, a depth first search
+     * rewinds when it leaves a node, so the arena only grows to the memory of one path through the tree.
+     */
+    class Arena {
+    public:
+        static constexpr std::size_t DEFAULT_CHUNK_SIZE = 1 << 16;
+
+        /**
+         * Position in the arena, see mark()
+         */
+        struct Marker {
+            std::size_t chunk;
+            std::size_t offset;
+        };
+
+        /**
+         * Releases everything allocated during its lifetime when it goes out of scope
+         */
+        class Scope {
+        public:
+            explicit Scope(Arena &arena);
+            ~Scope();
+
+            Scope(const Scope &) = delete;
+            Scope &operator=(const Scope &) = delete;
+
+        private:
+            Arena &arena;
+            Marker marker;
+        };
+
+        /**
+         * CTor, does not allocate
+         * @param chunkSize size of the chunks the arena requests from the global allocator
+         */
+        explicit Arena(std::size_t chunkSize = DEFAULT_CHUNK_SIZE);
+
+        Arena(const Arena &) = delete;
+        Arena &operator=(const Arena &) = delete;
+
+        /**
+         * Allocates memory, only requests a new chunk if the chunks allocated before are used up
+         * @param bytes size of the memory
+         * @param alignment alignment of the memory, a power of two
+         * @return pointer to the memory
+         */
+        auto allocate(std::size_t bytes, std::size_t alignment) -> void *;
+
+        /**
+         * Current position in the arena
+         */
+        auto mark() const -> Marker;
+
+        /**
+         * Releases everything allocated after a marker in constant time, the chunks are reused
+         * @param marker a marker taken from this arena that has not been released yet
+         */
+        void rewind(const Marker &marker);
+
+        /**
+         * Releases everything, the chunks are reused
+         */
+        void release();
+
+        /**
+         * Number of allocations served by the arena
+         */
+        auto getAllocations() const -> unsigned long;
+
+        /**
+         * Number of chunks requested from the global allocator
+         */
+        auto getChunkAllocations() const -> unsigned long;
+
+        /**
+         * Total size of all chunks
+         */
+        auto capacity() const -> std::size_t;
+
+    private:
+        struct Chunk {
+            std::unique_ptr<std::byte[]> memory;
+            std::size_t size;
+        };
+
+        const std::size_t chunkSize;
+        std::vector<Chunk> chunks;
+        std::size_t current = 0;
+        std::size_t offset = 0;
+        unsigned long allocations = 0;
+        unsigned long chunkAllocations = 0;
+
+        auto tryAllocate(std::size_t bytes, std::size_t alignment) -> void *;
+    };
+
+    /**
+     * Standard allocator that allocates from an Arena, or from the global allocator if it isn't bound to an arena.
+     * Copies of containers are never bound to an arena because they may outlive it, moving a container moves the
+     * arena along.
+     */
+    template<typename T>
+    class ArenaAllocator {
+    public:
+        using value_type = T;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap = std::true_type;
+
+        ArenaAllocator() noexcept = default;
+
+        /**
+         * CTor
+         * @param arena the arena to allocate from, nullptr for the global allocator
+         */
+        explicit ArenaAllocator(Arena *arena) noexcept : arena(arena) {}
+
+        template<typename U>
+        ArenaAllocator(const ArenaAllocator<U> &other) noexcept : arena(other.arena) {}
+
+        auto allocate(std::size_t n) -> T * {
+            if (arena == nullptr) {
+                return std::allocator<T>{}.allocate(n);
+            }
+
+            return static_cast<T *>(arena->allocate(n * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T *pointer, std::size_t n) noexcept {
+            if (arena == nullptr) {
+                std::allocator<T>{}.deallocate(pointer, n);
+            }
+        }
+
+        auto select_on_container_copy_construction() const -> ArenaAllocator {
+            return ArenaAllocator{};
+        }
+
+        template<typename U>
+        bool operator==(const ArenaAllocator<U> &other) const noexcept {
+            return arena == other.arena;
+        }
+
+        template<typename U>
+        bool operator!=(const ArenaAllocator<U> &other) const noexcept {
+            return arena != other.arena;
+        }
+
+    private:
+        template<typename U>
+        friend class ArenaAllocator;
+
+        Arena *arena = nullptr;
+    };
+
+    template<typename T>
+    using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+}
+
+#endif //KI_ARENA_HPP
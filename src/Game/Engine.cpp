@@ -0,0 +1,58 @@
+/**
+ * @file Engine.cpp
+ * @brief Implements the search engines Game can compute actions with
+ */
+
+#include "Engine.hpp"
+#include <stdexcept>
+
+namespace ai {
+    auto engineFromString(const std::string &name) -> Engine {
+        if (name == "alphabeta") {
+            return Engine::AlphaBeta;
+        } else if (name == "star1") {
+            return Engine::Star1;
+        } else if (name == "star2") {
+            return Engine::Star2;
+        } else if (name == "mcts") {
+            return Engine::Mcts;
+        }
+
+        throw std::invalid_argument{"Unknown engine '" + name + "', choose between alphabeta, star1, star2 and mcts"};
+    }
+
+    auto toString(Engine engine) -> std::string {
+        switch (engine) {
+            case Engine::AlphaBeta:
+                return "alphabeta";
+            case Engine::Star1:
+                return "star1";
+            case Engine::Star2:
+                return "star2";
+            case Engine::Mcts:
+                return "mcts";
+        }
+
+        throw std::runtime_error{"Enum out of bounds"};
+    }
+
+    auto chancePruning(Engine engine) -> ChancePruning {
+        switch (engine) {
+            case Engine::AlphaBeta:
+                return ChancePruning::None;
+            case Engine::Star1:
+                return ChancePruning::Star1;
+            case Engine::Star2:
+                return ChancePruning::Star2;
+            case Engine::Mcts:
+                return ChancePruning::None;
+        }
+
+        throw std::runtime_error{"Enum out of bounds"};
+    }
+
+    bool usesMcts(Engine engine, aiTools::ActionState::TurnState turnState) {
+        return engine == Engine::Mcts && (turnState == aiTools::ActionState::TurnState::Action ||
+                                          turnState == aiTools::ActionState::TurnState::PlayerFan);
+    }
+}
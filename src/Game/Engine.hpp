@@ -0,0 +1,68 @@
+/**
+ * @file Engine.hpp
+ * @brief Declares the search engines Game can compute actions with
+ */
+
+#ifndef KI_ENGINE_HPP
+#define KI_ENGINE_HPP
+
+#include <string>
+#include "Search.hpp"
+
+namespace ai {
+    /**
+     * Search engine used for the MOVE, ACTION and FAN turns
+     */
+    enum class Engine {
+        /**
+         * Alpha-beta search, the outcomes of chance nodes are always searched with a full window
+         */
+        AlphaBeta,
+
+        /**
+         * Expectimax with Star1 pruning of chance nodes
+         */
+        Star1,
+
+        /**
+         * Expectimax with Star2 pruning of chance nodes
+         */
+        Star2,
+
+        /**
+         * Monte Carlo tree search for the ACTION and FAN turns, alpha-beta search for the MOVE turns
+         */
+        Mcts
+    };
+
+    /**
+     * Parses the name of an engine as given on the command line
+     * @param name one of "alphabeta", "star1", "star2" and "mcts"
+     * @return the engine
+     * @throws std::invalid_argument if there is no engine with the given name
+     */
+    auto engineFromString(const std::string &name) -> Engine;
+
+    /**
+     * Name of an engine, inverse of engineFromString
+     * @param engine the engine
+     * @return the name
+     */
+    auto toString(Engine engine) -> std::string;
+
+    /**
+     * Pruning of chance nodes used by an engine
+     * @param engine the engine
+     * @return the pruning the Search of the engine is configured with
+     */
+    auto chancePruning(Engine engine) -> ChancePruning;
+
+    /**
+     * Whether an engine computes the actions of a turn with Mcts instead of Search
+     * @param engine the engine
+     * @param turnState the turn
+     */
+    bool usesMcts(Engine engine, aiTools::ActionState::TurnState turnState);
+}
+
+#endif //KI_ENGINE_HPP
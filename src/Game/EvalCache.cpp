@@ -0,0 +1,51 @@
+/**
+ * @file EvalCache.cpp
+ * @brief Implements the per-thread cache of evaluation results
+ */
+
+#include "EvalCache.hpp"
+#include "Zobrist.hpp"
+
+namespace ai {
+    EvalCache::EvalCache(unsigned int sizeLog2) : mask((std::uint64_t{1} << sizeLog2) - 1),
+            entries(std::size_t{1} << sizeLog2, Entry{0, 0, false}) {}
+
+    auto EvalCache::probe(std::uint64_t key) -> std::optional<double> {
+        const auto &entry = entries[key & mask];
+        if (entry.valid && entry.key == key) {
+            hits++;
+            return entry.value;
+        }
+
+        misses++;
+        return std::nullopt;
+    }
+
+    void EvalCache::store(std::uint64_t key, double value) {
+        entries[key & mask] = {key, value, true};
+    }
+
+    void EvalCache::clear() {
+        for (auto &entry : entries) {
+            entry.valid = false;
+        }
+    }
+
+    auto EvalCache::getHits() const -> unsigned long {
+        return hits;
+    }
+
+    auto EvalCache::getMisses() const -> unsigned long {
+        return misses;
+    }
+
+    auto EvalCache::forThread() -> EvalCache & {
+        thread_local EvalCache cache;
+        return cache;
+    }
+
+    auto EvalCache::keyOf(const SearchState &state, const SearchContext &context,
+                          gameModel::TeamSide mySide) -> std::uint64_t {
+        return state.key ^ splitMix(context.id << 1 | (mySide == gameModel::TeamSide::RIGHT ? 1 : 0));
+    }
+}
@@ -0,0 +1,80 @@
+/**
+ * @file EvalCache.hpp
+ * @brief Declares the per-thread cache of evaluation results
+ */
+
+#ifndef KI_EVALCACHE_HPP
+#define KI_EVALCACHE_HPP
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include "SearchState.hpp"
+
+namespace ai {
+    /**
+     * Direct mapped cache of evaluations keyed by a 64 bit position hash. A new result always replaces the one
+     * in its slot. One instance belongs to exactly one thread, so there is no synchronisation.
+     */
+    class EvalCache {
+    public:
+        static constexpr unsigned int DEFAULT_SIZE_LOG2 = 12;
+
+        /**
+         * CTor
+         * @param sizeLog2 the cache holds 2^sizeLog2 entries
+         */
+        explicit EvalCache(unsigned int sizeLog2 = DEFAULT_SIZE_LOG2);
+
+        /**
+         * Looks up an evaluation, counts a hit or a miss
+         * @param key hash of the position
+         * @return the stored value or nothing if the position is not in the cache
+         */
+        auto probe(std::uint64_t key) -> std::optional<double>;
+
+        /**
+         * Stores an evaluation
+         * @param key hash of the position
+         * @param value the value of the position
+         */
+        void store(std::uint64_t key, double value);
+
+        /**
+         * Removes all entries, the counters are kept
+         */
+        void clear();
+
+        auto getHits() const -> unsigned long;
+        auto getMisses() const -> unsigned long;
+
+        /**
+         * Cache of the calling thread
+         */
+        static auto forThread() -> EvalCache &;
+
+        /**
+         * Key of an evaluation, the Zobrist key of the state mixed with the context and the evaluating side
+         * @param state the evaluated state, its key has to be up to date
+         * @param context match constants of the state
+         * @param mySide The Side that the KI is playing
+         * @return hash of the state as seen by mySide in the match of context
+         */
+        static auto keyOf(const SearchState &state, const SearchContext &context,
+                          gameModel::TeamSide mySide) -> std::uint64_t;
+
+    private:
+        struct Entry {
+            std::uint64_t key;
+            double value;
+            bool valid;
+        };
+
+        std::uint64_t mask;
+        std::vector<Entry> entries;
+        unsigned long hits = 0;
+        unsigned long misses = 0;
+    };
+}
+
+#endif //KI_EVALCACHE_HPP
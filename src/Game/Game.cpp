@@ -7,95 +7,95 @@
 
 #include "Game.hpp"
 #include "AI.h"
+#include "Search.hpp"
+#include "Zobrist.hpp"
 #include <utility>
 #include <SopraGameLogic/conversions.h>
 #include <SopraGameLogic/GameController.h>
 
 constexpr unsigned int OVERTIME_INTERVAL = 3;
-constexpr unsigned int TIMEOUT_TOLERANCE = 2000;
 constexpr unsigned int MIN_SEARCH_DEPTH = 2;
 constexpr unsigned int MAX_SEARCH_DEPTH = 10;
 
-Game::Game(unsigned int difficulty, communication::messages::request::TeamConfig ownTeamConfig, util::Logging log) :
-        difficulty(difficulty), myConfig(std::move(ownTeamConfig)), log(std::move(log)) {
+Game::Game(unsigned int difficulty, unsigned int threads, bool ponder, ai::Engine engine,
+        std::shared_ptr<util::TelemetryWriter> telemetry,
+        std::shared_ptr<const ai::OpeningBook> openingBook, communication::messages::request::TeamConfig ownTeamConfig,
+        util::AsyncLog log) :
+        difficulty(difficulty), threads(threads), ponder(ponder), engine(engine), telemetry(std::move(telemetry)),
+        openingBook(std::move(openingBook)),
+        timeManager(difficulty), myConfig(std::move(ownTeamConfig)), log(std::move(log)) {
     currentState.availableFansRight = {};
     currentState.availableFansLeft = {};
     currentState.playersUsedRight = {};
     currentState.playersUsedLeft = {};
 }
 
+Game::~Game() {
+    stopPondering();
+}
+
 auto Game::getTeamFormation(const communication::messages::broadcast::MatchStart &matchStart)
     -> communication::messages::request::TeamFormation {
     matchConfig = matchStart.getMatchConfig();
+    shotTable = std::make_shared<const ai::ShotTable>(gameModel::Config{matchConfig});
     if(matchStart.getLeftTeamConfig().getTeamName() == myConfig.getTeamName()){
         mySide = gameModel::TeamSide::LEFT;
         theirConfig = matchStart.getRightTeamConfig();
-        return aiTools::getTeamFormation(gameModel::TeamSide::LEFT);
     } else {
         mySide = gameModel::TeamSide::RIGHT;
         theirConfig = matchStart.getLeftTeamConfig();
-        return aiTools::getTeamFormation(gameModel::TeamSide::RIGHT);
     }
+
+    brooms = ai::OpeningBook::broomsOf(matchStart.getLeftTeamConfig(), matchStart.getRightTeamConfig());
+    if(openingBook){
+        if(auto formation = openingBook->probeFormation(ai::OpeningBook::formationKey(mySide, brooms))){
+            log.info("Using formation from opening book");
+            return *formation;
+        }
+    }
+
+    return aiTools::getTeamFormation(mySide);
 }
 
 void Game::onSnapshot(const communication::messages::broadcast::Snapshot &snapshot) {
-    using namespace communication::messages::types;
-    std::optional<aiTools::State> lastState;
-    if(gotFirstSnapshot){
-        lastState = currentState.clone();
-    }
+    onSnapshot(communication::SnapshotFrame::fromSnapshot(snapshot));
+}
 
-    currentState.roundNumber = snapshot.getRound();
-    currentState.currentPhase = snapshot.getPhase();
-    currentState.goalScoredThisRound = snapshot.isGoalWasThrownThisRound();
-    auto lastDelta = snapshot.getLastDeltaBroadcast();
-    if(lastDelta.getDeltaType() == DeltaType::TURN_USED){
-        if(!lastDelta.getActiveEntity().has_value()){
-            throw std::runtime_error("Active entity id not set!");
+void Game::onSnapshot(const communication::SnapshotFrame &snapshot) {
+    using namespace communication::messages::types;
+    stopPondering();
+    bool hadSnapshot = gotFirstSnapshot;
+    std::optional<double> oldVal;
+    if(hadSnapshot){
+        // The previous state is only kept as the record of the values the snapshot overwrote, its value is only
+        // needed for a debug message
+        if(log.isEnabled(util::AsyncLog::Level::Debug)){
+            oldVal = currentValue();
         }
 
-        if(gameLogic::conversions::idToSide(*lastDelta.getActiveEntity()) == gameModel::TeamSide::LEFT) {
-            currentState.playersUsedLeft.emplace(*lastDelta.getActiveEntity());
-        } else {
-            currentState.playersUsedRight.emplace(*lastDelta.getActiveEntity());
+        lastSnapshotDiff.apply(currentState, snapshot);
+    } else {
+        gotFirstSnapshot = true;
+        currentState.roundNumber = snapshot.round;
+        currentState.currentPhase = snapshot.phase;
+        currentState.goalScoredThisRound = snapshot.goalWasThrownThisRound;
+        currentState.env = std::make_shared<gameModel::Environment>(gameModel::Config{matchConfig},
+                teamFromSnapshot(snapshot.leftTeam, gameModel::TeamSide::LEFT),
+                teamFromSnapshot(snapshot.rightTeam, gameModel::TeamSide::RIGHT));
+        currentState.env->quaffle->position = {snapshot.quaffle.first, snapshot.quaffle.second};
+        currentState.env->bludgers[0]->position = {snapshot.bludger1.first, snapshot.bludger1.second};
+        currentState.env->bludgers[1]->position = {snapshot.bludger2.first, snapshot.bludger2.second};
+        currentState.env->snitch->exists = snapshot.snitch.has_value();
+        if(snapshot.snitch.has_value()) {
+            currentState.env->snitch->position = {snapshot.snitch->first, snapshot.snitch->second};
         }
-    } else if(lastDelta.getDeltaType() == DeltaType::ROUND_CHANGE) {
-        currentState.playersUsedRight.clear();
-        currentState.playersUsedLeft.clear();
-    }
-
-    auto quaf = std::make_shared<gameModel::Quaffle>(gameModel::Position{snapshot.getQuaffleX(), snapshot.getQuaffleY()});
-    auto bludgers = std::array<std::shared_ptr<gameModel::Bludger>, 2>
-            {std::make_shared<gameModel::Bludger>(gameModel::Position{snapshot.getBludger1X(),
-                                                                      snapshot.getBludger1Y()}, EntityId::BLUDGER1),
-             std::make_shared<gameModel::Bludger>(gameModel::Position{snapshot.getBludger2X(),
-                                                                      snapshot.getBludger2Y()}, EntityId::BLUDGER2)};
-    gameModel::Position snitchPos = {0, 0};
-    if(snapshot.getSnitchX().has_value()) {
-        snitchPos = {*snapshot.getSnitchX(), *snapshot.getSnitchY()};
-    }
 
-    auto snitch = std::make_shared<gameModel::Snitch>(snitchPos);
-    snitch->exists = snapshot.getSnitchX().has_value();
-    std::deque<std::shared_ptr<gameModel::CubeOfShit>> pileOfShit;
-    for(const auto &pieceOfShit : snapshot.getWombatCubes()) {
-        pileOfShit.emplace_back(std::make_shared<gameModel::CubeOfShit>(gameModel::Position{pieceOfShit.first, pieceOfShit.second}));
-    }
-
-    auto team1 = teamFromSnapshot(snapshot.getLeftTeam(), gameModel::TeamSide::LEFT);
-    auto team2 = teamFromSnapshot(snapshot.getRightTeam(), gameModel::TeamSide::RIGHT);
+        for(const auto &pieceOfShit : snapshot.wombatCubes) {
+            currentState.env->pileOfShit.emplace_back(std::make_shared<gameModel::CubeOfShit>(gameModel::Position{pieceOfShit.first, pieceOfShit.second}));
+        }
 
-    if(!gotFirstSnapshot){
-        gotFirstSnapshot = true;
-        currentState.env = std::make_shared<gameModel::Environment>(gameModel::Config{matchConfig}, team1, team2);
         currentState.overTimeCounter = 0;
-    } else {
-        currentState.env->team1 = team1;
-        currentState.env->team2 = team2;
-        currentState.env->quaffle = quaf;
-        currentState.env->bludgers = bludgers;
-        currentState.env->snitch = snitch;
-        currentState.env->pileOfShit = pileOfShit;
+        searchContext.emplace(currentState.env, shotTable);
     }
 
     switch (currentState.overtimeState) {
@@ -122,23 +122,22 @@ void Game::onSnapshot(const communication::messages::broadcast::Snapshot &snapsh
 
     }
 
-    auto players = currentState.env->getAllPlayers();
-    for(const auto &player : players){
-        for(const auto &otherPlayer : players){
-            if(player != otherPlayer){
-                if(player->position == otherPlayer->position && !player->isFined && !otherPlayer->isFined){
-                    throw std::runtime_error("Two players on same position: " + toString(player->getId()) + " and " + toString(otherPlayer->getId()));
-                }
-            }
-        }
+    if(pathTable.update(ai::PathTable::obstaclesOf(*currentState.env))){
+        log.debug("Wombat cubes changed, recomputed path table");
+    }
+
+    if(auto collision = occupancy.update(*currentState.env); collision.has_value()){
+        throw std::runtime_error("Two players on same position: " + toString(ai::playerIds[collision->first]) +
+            " and " + toString(ai::playerIds[collision->second]));
     }
 
-    if(lastState.has_value()){
-        generateShitTalk(snapshot, lastState.value(), currentState);
-        auto oldVal = ai::simpleEval(*lastState, mySide);
-        auto newVal = ai::simpleEval(currentState, mySide);
-        if(newVal != oldVal){
-            log.debug("State value has changed: " + std::to_string(oldVal) + " -> " + std::to_string(newVal));
+    if(hadSnapshot){
+        generateShitTalk(snapshot.lastDelta, lastSnapshotDiff, currentState);
+        if(oldVal.has_value()){
+            auto newVal = currentValue();
+            if(newVal != *oldVal){
+                log.debug([&]{ return "State value has changed: " + std::to_string(*oldVal) + " -> " + std::to_string(newVal); });
+            }
         }
     }
 }
@@ -152,15 +151,33 @@ auto Game::getNextAction(const communication::messages::broadcast::Next &next, u
         throw std::runtime_error("Local environment not set!");
     }
 
-    log.debug("ActiveID: " + types::toString(next.getEntityId()));
-    log.debug("Requested action type: " + types::toString(next.getTurnType()));
+    log.debug([&]{ return "ActiveID: " + types::toString(next.getEntityId()); });
+    log.debug([&]{ return "Requested action type: " + types::toString(next.getTurnType()); });
     if(isBall(next.getEntityId()) || idToSide(next.getEntityId()) != mySide){
         log.info("Not my turn, ignoring request");
+        if(ponder && !isBall(next.getEntityId())){
+            if(next.getTurnType() == types::TurnType::MOVE){
+                aiTools::ActionState actionState(next.getEntityId(), aiTools::ActionState::TurnState::FirstMove);
+                if(next.getEntityId() == lastOpponentId){
+                    actionState.turnState = aiTools::ActionState::TurnState::SecondMove;
+                }
+
+                lastOpponentId = next.getEntityId();
+                startPondering(actionState);
+            } else if(next.getTurnType() == types::TurnType::ACTION){
+                startPondering({next.getEntityId(), aiTools::ActionState::TurnState::Action});
+            }
+        }
+
         return std::nullopt;
     }
 
-    std::atomic_bool abort = false;
-    timer.setTimeout([&abort](){ abort = true; }, next.getTimout() - TIMEOUT_TOLERANCE);
+    stopPondering();
+    searchAborted = false;
+    auto budget = timeManager.start(currentState, next.getTimout());
+    log.debug([&]{ return "Search budget: " + std::to_string(budget.maximum.count()) + "ms"; });
+    timer.setTimeout([this](){ searchAborted = true; }, static_cast<int>(budget.maximum.count()));
+    auto deadline = std::chrono::steady_clock::now() + budget.maximum;
     auto evalFunction = [this](const aiTools::State &state){
         return ai::simpleEval(state, mySide);
     };
@@ -170,22 +187,45 @@ auto Game::getNextAction(const communication::messages::broadcast::Next &next, u
         case communication::messages::types::TurnType::MOVE:{
             auto player = currentState.env->getPlayerById(next.getEntityId());
             if(currentState.env->snitch->exists && INSTANCE_OF(player, gameModel::Seeker)){
-                auto path = aiTools::computeOptimalPath(player, currentState.env->snitch->position, currentState.env);
-                if(path.size() >= 2){
-                    path.pop_back();
-                    for(auto it = path.rbegin(); it != path.rend(); ++it){
-                        log.debug("step to {" + std::to_string(it->x) + " | " + std::to_string(it->y) + "}");
+                std::optional<gameModel::Position> step;
+                if(currentState.overtimeState == gameController::ExcessLength::Stage2 ||
+                   currentState.overtimeState == gameController::ExcessLength::Stage3){
+                    step = overtimeSeekerStep(*player);
+                    log.debug([&]{ return "Overtime table: snitch caught in " + std::to_string(ai::catchDistance(
+                            ai::toCell(player->position), ai::toCell(currentState.env->snitch->position), false)) + " turns"; });
+                } else {
+                    auto from = ai::toCell(player->position);
+                    auto to = ai::toCell(currentState.env->snitch->position);
+                    if(log.isEnabled(util::AsyncLog::Level::Debug)){
+                        auto path = pathTable.path(from, to);
+                        for(auto it = path.rbegin(); it != path.rend(); ++it){
+                            if(it != path.rbegin()){
+                                log.debug("step to {" + std::to_string(it->x) + " | " + std::to_string(it->y) + "}");
+                            }
+                        }
+                    }
+
+                    // Go around players and bludgers if there is another shortest path, otherwise push through
+                    auto stepCell = pathTable.nextStep(from, to, seekerObstacles(*player));
+                    if(!stepCell.has_value()){
+                        stepCell = pathTable.nextStep(from, to);
+                    }
+
+                    if(stepCell.has_value()){
+                        step = ai::toPosition(*stepCell);
                     }
+                }
 
+                if(step.has_value()){
                     auto opSide = mySide == gameModel::TeamSide::LEFT ? gameModel::TeamSide::RIGHT : gameModel::TeamSide::LEFT;
-                    if(path.back() == currentState.env->snitch->position &&
+                    if(*step == currentState.env->snitch->position &&
                         currentState.env->getTeam(mySide)->score - currentState.env->getTeam(opSide)->score < -gameController::SNITCH_POINTS){
                         log.debug("Catching Snitch would result in defeat => Skipping turn");
                         res = request::DeltaRequest{types::DeltaType::SKIP, std::nullopt, std::nullopt, std::nullopt, std::nullopt, std::nullopt, player->getId(),
                                                     std::nullopt, std::nullopt, std::nullopt, std::nullopt, std::nullopt, std::nullopt};
                     } else {
-                        res = request::DeltaRequest{types::DeltaType::MOVE, std::nullopt, std::nullopt, std::nullopt, path.back().x,
-                                                    path.back().y, player->getId(), std::nullopt, std::nullopt, std::nullopt, std::nullopt, std::nullopt, std::nullopt};
+                        res = request::DeltaRequest{types::DeltaType::MOVE, std::nullopt, std::nullopt, std::nullopt, step->x,
+                                                    step->y, player->getId(), std::nullopt, std::nullopt, std::nullopt, std::nullopt, std::nullopt, std::nullopt};
                     }
                 } else {
                     res = request::DeltaRequest{types::DeltaType::SKIP, std::nullopt, std::nullopt, std::nullopt, std::nullopt, std::nullopt, player->getId(),
@@ -197,10 +237,7 @@ auto Game::getNextAction(const communication::messages::broadcast::Next &next, u
                     actionState.turnState = aiTools::ActionState::TurnState::SecondMove;
                 }
 
-                auto [action, depth, expansions, score] = aiTools::computeBestActionAlphaBetaID(currentState, evalFunction, actionState, abort, MIN_SEARCH_DEPTH, MAX_SEARCH_DEPTH);
-                log.info("Calculated action " + std::to_string(depth) + " turns into the future. Total number of explored states: " + std::to_string(expansions));
-                log.debug("Expected future state value: " + std::to_string(score));
-                res = action;
+                res = searchAction(actionState, searchAborted, deadline);
             }
 
             lastId = next.getEntityId();
@@ -208,17 +245,18 @@ auto Game::getNextAction(const communication::messages::broadcast::Next &next, u
         }
         case communication::messages::types::TurnType::ACTION:{
             aiTools::ActionState actionState(next.getEntityId(), aiTools::ActionState::TurnState::Action);
-            auto [action, depth, expansions, score] = aiTools::computeBestActionAlphaBetaID(currentState, evalFunction, actionState, abort, MIN_SEARCH_DEPTH, MAX_SEARCH_DEPTH);
-            log.info("Calculated action " + std::to_string(depth) + " turns into the future. Total number of explored states: " + std::to_string(expansions));
-            log.debug("Expected future state value: " + std::to_string(score));
-            res = action;
+            res = searchAction(actionState, searchAborted, deadline);
             break;
         }
         case communication::messages::types::TurnType::FAN:
-            res = aiTools::getNextFanTurn(currentState, next);
+            if(ai::usesMcts(engine, aiTools::ActionState::TurnState::PlayerFan)){
+                res = searchAction({next.getEntityId(), aiTools::ActionState::TurnState::PlayerFan}, searchAborted, deadline);
+            } else {
+                res = aiTools::getNextFanTurn(currentState, next);
+            }
             break;
         case communication::messages::types::TurnType::REMOVE_BAN:
-            res = aiTools::redeployPlayer(currentState, evalFunction, next.getEntityId(), abort);
+            res = aiTools::redeployPlayer(currentState, evalFunction, next.getEntityId(), searchAborted);
             break;
         default:
             throw std::runtime_error("Enum out of bounds");
@@ -228,95 +266,259 @@ auto Game::getNextAction(const communication::messages::broadcast::Next &next, u
     return res;
 }
 
-auto Game::teamFromSnapshot(const communication::messages::broadcast::TeamSnapshot &teamSnapshot, gameModel::TeamSide teamSide) const ->
+void Game::abortSearch() {
+    searchAborted = true;
+}
+
+auto Game::getSearchStatistics() const -> std::pair<unsigned long, unsigned long> {
+    return {searchedActions, exploredStates};
+}
+
+auto Game::searchAction(const aiTools::ActionState &actionState, const std::atomic_bool &abort,
+                        std::chrono::steady_clock::time_point deadline) -> communication::messages::request::DeltaRequest {
+    auto root = ai::SearchState::fromState(currentState);
+    if(auto result = ai::takePonderResult(ponderResult, root, actionState)){
+        log.info([&]{ return "Ponder hit, using action calculated " + std::to_string(result->depth) + " turns into the future"; });
+        searchedActions++;
+        exploredStates += result->expansions;
+        reportSearch(actionState, *result, deadline, true);
+        return result->action;
+    }
+
+    if(auto action = bookAction(root, actionState)){
+        log.info("Book hit, skipping search");
+        return *action;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    auto keepSearching = [this](const ai::SearchResult &iteration){ return timeManager.keepSearching(iteration); };
+    ai::SearchResult result;
+    if(ai::usesMcts(engine, actionState.turnState)){
+        ai::Mcts mcts(*searchContext, mySide, threads);
+        result = mcts.computeBestAction(root, actionState, abort, std::numeric_limits<unsigned long>::max(), keepSearching);
+    } else {
+        ai::Search search(*searchContext, mySide, transpositionTable, threads, telemetry != nullptr);
+        search.setChancePruning(ai::chancePruning(engine));
+        result = search.computeBestAction(root, actionState, abort, MIN_SEARCH_DEPTH, MAX_SEARCH_DEPTH, keepSearching);
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    auto perSecond = [&elapsed](unsigned long count){
+        return std::to_string(elapsed.count() > 0 ? static_cast<unsigned long>(static_cast<double>(count) / elapsed.count()) : 0);
+    };
+    if(ai::usesMcts(engine, actionState.turnState)){
+        log.info([&]{ return "Ran " + std::to_string(result.stats.playouts) + " playouts (" + perSecond(result.stats.playouts) + " playouts/sec), tree depth " + std::to_string(result.depth) + ". Total number of explored states: " + std::to_string(result.expansions); });
+    } else {
+        log.info([&]{ return "Calculated action " + std::to_string(result.depth) + " turns into the future. Total number of explored states: " + std::to_string(result.expansions) + " (" + perSecond(result.expansions) + " states/sec)"; });
+    }
+
+    log.debug([&]{ return "Expected future state value: " + std::to_string(result.score); });
+    searchedActions++;
+    exploredStates += result.expansions;
+    reportSearch(actionState, result, deadline, false);
+    return result.action;
+}
+
+auto Game::currentValue() const -> double {
+    return ai::simpleEval(ai::SearchState::fromState(currentState), *searchContext, mySide);
+}
+
+auto Game::seekerObstacles(const gameModel::Player &seeker) const -> ai::CellSet {
+    auto ret = ai::PathTable::obstaclesOf(*currentState.env);
+    for(const auto &player : currentState.env->getAllPlayers()){
+        if(!player->isFined && player->getId() != seeker.getId()){
+            ret.set(ai::toCell(player->position));
+        }
+    }
+
+    for(const auto &bludger : currentState.env->bludgers){
+        ret.set(ai::toCell(bludger->position));
+    }
+
+    return ret;
+}
+
+auto Game::overtimeSeekerStep(const gameModel::Player &seeker) const -> std::optional<gameModel::Position> {
+    auto step = ai::catchStep(ai::toCell(seeker.position), ai::toCell(currentState.env->snitch->position),
+            seekerObstacles(seeker));
+    if(!step.has_value()){
+        return std::nullopt;
+    }
+
+    return ai::toPosition(*step);
+}
+
+auto Game::bookAction(const ai::SearchState &root, const aiTools::ActionState &actionState) const
+    -> std::optional<communication::messages::request::DeltaRequest> {
+    if(!openingBook){
+        return std::nullopt;
+    }
+
+    auto bookMove = openingBook->probeMove(ai::OpeningBook::moveKey(root, actionState, brooms));
+    if(!bookMove.has_value()){
+        return std::nullopt;
+    }
+
+    // The book only stores the essentials of an action, the request that is sent has to be one of the legal actions
+    for(auto &successor : aiTools::expandState(currentState, actionState)){
+        if(ai::OpeningBook::sameAction(successor.first, *bookMove)){
+            return std::move(successor.first);
+        }
+    }
+
+    log.warn("Opening book action is not possible, searching instead");
+    return std::nullopt;
+}
+
+void Game::reportSearch(const aiTools::ActionState &actionState, const ai::SearchResult &result,
+                        std::chrono::steady_clock::time_point deadline, bool ponderHit) {
+    if(!telemetry){
+        return;
+    }
+
+    auto ratio = [](unsigned long a, unsigned long b){
+        return b == 0 ? 0.0 : static_cast<double>(a) / static_cast<double>(b);
+    };
+
+    std::string turn;
+    switch(actionState.turnState){
+        case aiTools::ActionState::TurnState::FirstMove:
+            turn = "firstMove";
+            break;
+        case aiTools::ActionState::TurnState::SecondMove:
+            turn = "secondMove";
+            break;
+        case aiTools::ActionState::TurnState::Action:
+            turn = "action";
+            break;
+        case aiTools::ActionState::TurnState::PlayerFan:
+            turn = "playerFan";
+            break;
+    }
+
+    std::vector<unsigned long> nodesPerDepth;
+    std::vector<double> timePerIteration;
+    for(const auto &iteration : result.stats.iterations){
+        nodesPerDepth.emplace_back(iteration.expansions);
+        timePerIteration.emplace_back(iteration.milliseconds);
+    }
+
+    std::vector<nlohmann::json> principalVariation;
+    for(const auto &action : result.principalVariation){
+        principalVariation.emplace_back(action);
+    }
+
+    std::chrono::duration<double, std::milli> timeLeft = deadline - std::chrono::steady_clock::now();
+    nlohmann::json record;
+    record["round"] = currentState.roundNumber;
+    record["entity"] = communication::messages::types::toString(actionState.id);
+    record["turn"] = turn;
+    record["engine"] = ai::toString(engine);
+    record["ponderHit"] = ponderHit;
+    record["depth"] = result.depth;
+    record["score"] = result.score;
+    record["nodes"] = result.expansions;
+    record["minDepth"] = result.stats.iterations.empty() ? 0 : result.stats.iterations.front().depth;
+    record["nodesPerDepth"] = nodesPerDepth;
+    record["timePerIteration"] = timePerIteration;
+    record["branchingFactor"] = ratio(result.stats.children, result.expansions);
+    record["cutoffRate"] = ratio(result.stats.cutoffs, result.expansions);
+    record["chanceCutoffs"] = result.stats.chanceCutoffs;
+    record["ttHitRate"] = ratio(result.stats.tableHits, result.stats.tableProbes);
+    record["evals"] = result.stats.evals;
+    record["playouts"] = result.stats.playouts;
+    record["timeLeft"] = timeLeft.count();
+    record["pv"] = principalVariation;
+    telemetry->write(std::move(record));
+}
+
+void Game::startPondering(const aiTools::ActionState &actionState) {
+    stopPondering();
+    ponderResult.reset();
+    if(!searchContext.has_value()){
+        return;
+    }
+
+    auto root = ai::SearchState::fromState(currentState);
+    ponderThread = std::thread([this, root, actionState](){
+        try {
+            ai::Search search(*searchContext, mySide, transpositionTable, 1, telemetry != nullptr);
+            search.setChancePruning(ai::chancePruning(engine));
+            ponderResult = search.ponder(root, actionState, stopPonder, MIN_SEARCH_DEPTH, MAX_SEARCH_DEPTH);
+        } catch (std::runtime_error &e) {
+            log.warn(std::string{"Pondering failed: "} + e.what());
+        }
+    });
+}
+
+void Game::stopPondering() {
+    stopPonder = true;
+    if(ponderThread.joinable()){
+        ponderThread.join();
+    }
+
+    stopPonder = false;
+}
+
+auto Game::teamFromSnapshot(const communication::TeamFrame &teamSnapshot, gameModel::TeamSide teamSide) const ->
         std::shared_ptr<gameModel::Team> {
     using ID = communication::messages::types::EntityId;
     auto teamConf = teamSide == mySide ? myConfig : theirConfig;
     bool left = teamSide == gameModel::TeamSide::LEFT;
-    gameModel::Seeker seeker(gameModel::Position{teamSnapshot.getSeekerX(), teamSnapshot.getSeekerY()}, teamConf.getSeeker().getBroom(),
+    gameModel::Seeker seeker(gameModel::Position{teamSnapshot.seeker.position.first, teamSnapshot.seeker.position.second}, teamConf.getSeeker().getBroom(),
             left ? ID::LEFT_SEEKER : ID::RIGHT_SEEKER);
-    seeker.knockedOut = teamSnapshot.isSeekerKnockout();
-    seeker.isFined = teamSnapshot.isSeekerBanned();
+    seeker.knockedOut = teamSnapshot.seeker.knockout;
+    seeker.isFined = teamSnapshot.seeker.banned;
 
-    gameModel::Keeper keeper(gameModel::Position{teamSnapshot.getKeeperX(), teamSnapshot.getKeeperY()}, teamConf.getKeeper().getBroom(),
+    gameModel::Keeper keeper(gameModel::Position{teamSnapshot.keeper.position.first, teamSnapshot.keeper.position.second}, teamConf.getKeeper().getBroom(),
             left ? ID::LEFT_KEEPER : ID::RIGHT_KEEPER);
-    keeper.knockedOut = teamSnapshot.isKeeperKnockout();
-    keeper.isFined = teamSnapshot.isKeeperBanned();
+    keeper.knockedOut = teamSnapshot.keeper.knockout;
+    keeper.isFined = teamSnapshot.keeper.banned;
 
     std::array<gameModel::Beater, 2> beaters =
-            {gameModel::Beater(gameModel::Position{teamSnapshot.getBeater1X(), teamSnapshot.getBeater1Y()}, teamConf.getBeater1().getBroom(),
+            {gameModel::Beater(gameModel::Position{teamSnapshot.beaters[0].position.first, teamSnapshot.beaters[0].position.second}, teamConf.getBeater1().getBroom(),
                      left ? ID::LEFT_BEATER1: ID::RIGHT_BEATER1),
-             gameModel::Beater(gameModel::Position{teamSnapshot.getBeater2X(), teamSnapshot.getBeater2Y()}, teamConf.getBeater2().getBroom(),
+             gameModel::Beater(gameModel::Position{teamSnapshot.beaters[1].position.first, teamSnapshot.beaters[1].position.second}, teamConf.getBeater2().getBroom(),
                      left ? ID::LEFT_BEATER2: ID::RIGHT_BEATER2)};
-    beaters[0].knockedOut = teamSnapshot.isBeater1Knockout();
-    beaters[0].isFined = teamSnapshot.isBeater1Banned();
-    beaters[1].knockedOut = teamSnapshot.isBeater2Knockout();
-    beaters[1].isFined = teamSnapshot.isBeater2Banned();
+    beaters[0].knockedOut = teamSnapshot.beaters[0].knockout;
+    beaters[0].isFined = teamSnapshot.beaters[0].banned;
+    beaters[1].knockedOut = teamSnapshot.beaters[1].knockout;
+    beaters[1].isFined = teamSnapshot.beaters[1].banned;
 
     std::array<gameModel::Chaser, 3> chasers=
-            {gameModel::Chaser(gameModel::Position{teamSnapshot.getChaser1X(), teamSnapshot.getChaser1Y()}, teamConf.getChaser1().getBroom(),
+            {gameModel::Chaser(gameModel::Position{teamSnapshot.chasers[0].position.first, teamSnapshot.chasers[0].position.second}, teamConf.getChaser1().getBroom(),
                                left ? ID::LEFT_CHASER1 : ID::RIGHT_CHASER1),
-             gameModel::Chaser(gameModel::Position{teamSnapshot.getChaser2X(), teamSnapshot.getChaser2Y()}, teamConf.getChaser2().getBroom(),
+             gameModel::Chaser(gameModel::Position{teamSnapshot.chasers[1].position.first, teamSnapshot.chasers[1].position.second}, teamConf.getChaser2().getBroom(),
                                left ? ID::LEFT_CHASER2 : ID::RIGHT_CHASER2),
-             gameModel::Chaser(gameModel::Position{teamSnapshot.getChaser3X(), teamSnapshot.getChaser3Y()}, teamConf.getChaser3().getBroom(),
+             gameModel::Chaser(gameModel::Position{teamSnapshot.chasers[2].position.first, teamSnapshot.chasers[2].position.second}, teamConf.getChaser3().getBroom(),
                                left ? ID::LEFT_CHASER3 : ID::RIGHT_CHASER3)};
 
-    chasers[0].knockedOut = teamSnapshot.isChaser1Knockout();
-    chasers[0].isFined = teamSnapshot.isChaser1Banned();
-    chasers[1].knockedOut = teamSnapshot.isChaser2Knockout();
-    chasers[1].isFined = teamSnapshot.isChaser2Banned();
-    chasers[2].knockedOut = teamSnapshot.isChaser3Knockout();
-    chasers[2].isFined = teamSnapshot.isChaser3Banned();
-
-    int teleport = 0;
-    int rangedAttack = 0;
-    int impulse = 0;
-    int snitchPush = 0;
-    int blockCell = 0;
-    for(const auto &fan : teamSnapshot.getFans()) {
-        if(fan.banned){
-            continue;
-        }
-
-        switch(fan.fanType) {
-            case communication::messages::types::FanType::GOBLIN:
-                rangedAttack++;
-                break;
-            case communication::messages::types::FanType::TROLL:
-                impulse++;
-                break;
-            case communication::messages::types::FanType::ELF:
-                teleport++;
-                break;
-            case communication::messages::types::FanType::NIFFLER:
-                snitchPush++;
-                break;
-            case communication::messages::types::FanType::WOMBAT:
-                blockCell++;
-                break;
-        }
-    }
+    chasers[0].knockedOut = teamSnapshot.chasers[0].knockout;
+    chasers[0].isFined = teamSnapshot.chasers[0].banned;
+    chasers[1].knockedOut = teamSnapshot.chasers[1].knockout;
+    chasers[1].isFined = teamSnapshot.chasers[1].banned;
+    chasers[2].knockedOut = teamSnapshot.chasers[2].knockout;
+    chasers[2].isFined = teamSnapshot.chasers[2].banned;
 
-    gameModel::Fanblock fans(teleport, rangedAttack, impulse, snitchPush, blockCell);
-    return std::make_shared<gameModel::Team>(seeker, keeper, beaters, chasers, teamSnapshot.getPoints(), fans, teamSide);
+    auto fans = ai::fanblockFromSnapshot(teamSnapshot);
+    return std::make_shared<gameModel::Team>(seeker, keeper, beaters, chasers, teamSnapshot.points, fans, teamSide);
 }
 
-void Game::generateShitTalk(const communication::messages::broadcast::Snapshot &snapshot, const aiTools::State &lastState,
+void Game::generateShitTalk(const communication::DeltaFrame &delta, const ai::StateDiff &diff,
         const aiTools::State &newState) const {
     using namespace communication::messages::types;
-    auto delta = snapshot.getLastDeltaBroadcast();
-    auto pointsSide = [&lastState, &newState]() -> std::optional<gameModel::TeamSide>{
+    auto pointsSide = [&diff, &newState]() -> std::optional<gameModel::TeamSide>{
 
-        if(lastState.env->getTeam(gameModel::TeamSide::LEFT)->score - newState.env->getTeam(gameModel::TeamSide::LEFT)->score != 0){
+        if(diff.getPreviousScore(gameModel::TeamSide::LEFT) - newState.env->getTeam(gameModel::TeamSide::LEFT)->score != 0){
             return gameModel::TeamSide::LEFT;
-        } else if(lastState.env->getTeam(gameModel::TeamSide::RIGHT)->score - newState.env->getTeam(gameModel::TeamSide::RIGHT)->score != 0){
+        } else if(diff.getPreviousScore(gameModel::TeamSide::RIGHT) - newState.env->getTeam(gameModel::TeamSide::RIGHT)->score != 0){
             return gameModel::TeamSide::RIGHT;
         }
 
         return std::nullopt;
     };
 
-    switch (delta.getDeltaType()){
+    switch (delta.deltaType){
         case DeltaType::SNITCH_CATCH:{
             auto side = pointsSide();
             if(side.has_value()){
@@ -324,43 +526,43 @@ void Game::generateShitTalk(const communication::messages::broadcast::Snapshot &
                     log.shitTalk("Oh baby a triple!");
                 } else {
                     log.shitTalk("FeelsBadMan");
-                    log.shitTalk(std::string("\n") +
-                    "__________████████_____██████\n" +
-                     "_________█░░░░░░░░██_██░░░░░░█\n" +
-                     "________█░░░░░░░░░░░█░░░░░░░░░█\n" +
-                     "_______█░░░░░░░███░░░█░░░░░░░░░█\n" +
-                     "_______█░░░░███░░░███░█░░░████░█\n" +
-                     "______█░░░██░░░░░░░░███░██░░░░██\n" +
-                     "_____█░░░░░░░░░░░░░░░░░█░░░░░░░░███\n" +
-                     "____█░░░░░░░░░░░░░██████░░░░░████░░█\n" +
-                     "____█░░░░░░░░░█████░░░████░░██░░██░░█\n" +
-                     "___██░░░░░░░███░░░░░░░░░░█░░░░░░░░███\n" +
-                     "__█░░░░░░░░░░░░░░█████████░░█████████\n" +
-                     "_█░░░░░░░░░░█████_████___████_█████___█\n" +
-                     "_█░░░░░░░░░░█______█_███__█_____███_█___█\n" +
-                     "█░░░░░░░░░░░░█___████_████____██_██████\n" +
-                     "░░░░░░░░░░░░░█████████░░░████████░░░█\n" +
-                     "░░░░░░░░░░░░░░░░█░░░░░█░░░░░░░░░░░░█\n" +
-                     "░░░░░░░░░░░░░░░░░░░░██░░░░█░░░░░░██\n" +
-                     "░░░░░░░░░░░░░░░░░░██░░░░░░░███████\n" +
-                     "░░░░░░░░░░░░░░░░██░░░░░░░░░░█░░░░░█\n" +
-                     "░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░█\n" +
-                     "░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░█\n" +
-                     "░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░█\n" +
-                     "░░░░░░░░░░░█████████░░░░░░░░░░░░░░██\n" +
-                     "░░░░░░░░░░█▒▒▒▒▒▒▒▒███████████████▒▒█\n" +
-                     "░░░░░░░░░█▒▒███████▒▒▒▒▒▒▒▒▒▒▒▒▒▒▒▒▒█\n" +
-                     "░░░░░░░░░█▒▒▒▒▒▒▒▒▒█████████████████\n" +
-                     "░░░░░░░░░░████████▒▒▒▒▒▒▒▒▒▒▒▒▒▒▒▒▒▒█\n" +
-                     "░░░░░░░░░░░░░░░░░░██████████████████\n" +
-                     "░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░█\n" +
-                     "██░░░░░░░░░░░░░░░░░░░░░░░░░░░██\n" +
-                     "▓██░░░░░░░░░░░░░░░░░░░░░░░░██\n" +
-                     "▓▓▓███░░░░░░░░░░░░░░░░░░░░█\n" +
-                     "▓▓▓▓▓▓███░░░░░░░░░░░░░░░██\n" +
-                     "▓▓▓▓▓▓▓▓▓███████████████▓▓█\n" +
-                     "▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓██\n" +
-                     "▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓█\n" +
+                    log.shitTalk("\n"
+                    "__________████████_____██████\n"
+                     "_________█░░░░░░░░██_██░░░░░░█\n"
+                     "________█░░░░░░░░░░░█░░░░░░░░░█\n"
+                     "_______█░░░░░░░███░░░█░░░░░░░░░█\n"
+                     "_______█░░░░███░░░███░█░░░████░█\n"
+                     "______█░░░██░░░░░░░░███░██░░░░██\n"
+                     "_____█░░░░░░░░░░░░░░░░░█░░░░░░░░███\n"
+                     "____█░░░░░░░░░░░░░██████░░░░░████░░█\n"
+                     "____█░░░░░░░░░█████░░░████░░██░░██░░█\n"
+                     "___██░░░░░░░███░░░░░░░░░░█░░░░░░░░███\n"
+                     "__█░░░░░░░░░░░░░░█████████░░█████████\n"
+                     "_█░░░░░░░░░░█████_████___████_█████___█\n"
+                     "_█░░░░░░░░░░█______█_███__█_____███_█___█\n"
+                     "█░░░░░░░░░░░░█___████_████____██_██████\n"
+                     "░░░░░░░░░░░░░█████████░░░████████░░░█\n"
+                     "░░░░░░░░░░░░░░░░█░░░░░█░░░░░░░░░░░░█\n"
+                     "░░░░░░░░░░░░░░░░░░░░██░░░░█░░░░░░██\n"
+                     "░░░░░░░░░░░░░░░░░░██░░░░░░░███████\n"
+                     "░░░░░░░░░░░░░░░░██░░░░░░░░░░█░░░░░█\n"
+                     "░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░█\n"
+                     "░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░█\n"
+                     "░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░█\n"
+                     "░░░░░░░░░░░█████████░░░░░░░░░░░░░░██\n"
+                     "░░░░░░░░░░█▒▒▒▒▒▒▒▒███████████████▒▒█\n"
+                     "░░░░░░░░░█▒▒███████▒▒▒▒▒▒▒▒▒▒▒▒▒▒▒▒▒█\n"
+                     "░░░░░░░░░█▒▒▒▒▒▒▒▒▒█████████████████\n"
+                     "░░░░░░░░░░████████▒▒▒▒▒▒▒▒▒▒▒▒▒▒▒▒▒▒█\n"
+                     "░░░░░░░░░░░░░░░░░░██████████████████\n"
+                     "░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░░█\n"
+                     "██░░░░░░░░░░░░░░░░░░░░░░░░░░░██\n"
+                     "▓██░░░░░░░░░░░░░░░░░░░░░░░░██\n"
+                     "▓▓▓███░░░░░░░░░░░░░░░░░░░░█\n"
+                     "▓▓▓▓▓▓███░░░░░░░░░░░░░░░██\n"
+                     "▓▓▓▓▓▓▓▓▓███████████████▓▓█\n"
+                     "▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓██\n"
+                     "▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓█\n"
                      "▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓▓█");
                 }
             }
@@ -368,27 +570,27 @@ void Game::generateShitTalk(const communication::messages::broadcast::Snapshot &
         }
         case DeltaType::BLUDGER_BEATING:break;
         case DeltaType::QUAFFLE_THROW:{
-            if(delta.isSuccess().value()){
+            if(delta.success.value()){
                 log.shitTalk("Wow, such throw, much Quaffle, very Quidditch");
-                log.shitTalk(std::string("\n") +
-                             "░░░░░░░░░▄░░░░░░░░░░░░░░▄░░░░\n" +
-                             "░░░░░░░░▌▒█░░░░░░░░░░░▄▀▒▌░░░\n" +
-                             "░░░░░░░░▌▒▒█░░░░░░░░▄▀▒▒▒▐░░░\n" +
-                             "░░░░░░░▐▄▀▒▒▀▀▀▀▄▄▄▀▒▒▒▒▒▐░░░\n" +
-                             "░░░░░▄▄▀▒░▒▒▒▒▒▒▒▒▒█▒▒▄█▒▐░░░\n" +
-                             "░░░▄▀▒▒▒░░░▒▒▒░░░▒▒▒▀██▀▒▌░░░\n" +
-                             "░░▐▒▒▒▄▄▒▒▒▒░░░▒▒▒▒▒▒▒▀▄▒▒▌░░\n" +
-                             "░░▌░░▌█▀▒▒▒▒▒▄▀█▄▒▒▒▒▒▒▒█▒▐░░\n" +
-                             "░▐░░░▒▒▒▒▒▒▒▒▌██▀▒▒░░░▒▒▒▀▄▌░\n" +
-                             "░▌░▒▄██▄▒▒▒▒▒▒▒▒▒░░░░░░▒▒▒▒▌░\n" +
-                             "▀▒▀▐▄█▄█▌▄░▀▒▒░░░░░░░░░░▒▒▒▐░\n" +
-                             "▐▒▒▐▀▐▀▒░▄▄▒▄▒▒▒▒▒▒░▒░▒░▒▒▒▒▌\n" +
-                             "▐▒▒▒▀▀▄▄▒▒▒▄▒▒▒▒▒▒▒▒░▒░▒░▒▒▐░\n" +
-                             "░▌▒▒▒▒▒▒▀▀▀▒▒▒▒▒▒░▒░▒░▒░▒▒▒▌░\n" +
-                             "░▐▒▒▒▒▒▒▒▒▒▒▒▒▒▒░▒░▒░▒▒▄▒▒▐░░\n" +
-                             "░░▀▄▒▒▒▒▒▒▒▒▒▒▒░▒░▒░▒▄▒▒▒▒▌░░\n" +
-                             "░░░░▀▄▒▒▒▒▒▒▒▒▒▒▄▄▄▀▒▒▒▒▄▀░░░\n" +
-                             "░░░░░░▀▄▄▄▄▄▄▀▀▀▒▒▒▒▒▄▄▀░░░░░\n" +
+                log.shitTalk("\n"
+                             "░░░░░░░░░▄░░░░░░░░░░░░░░▄░░░░\n"
+                             "░░░░░░░░▌▒█░░░░░░░░░░░▄▀▒▌░░░\n"
+                             "░░░░░░░░▌▒▒█░░░░░░░░▄▀▒▒▒▐░░░\n"
+                             "░░░░░░░▐▄▀▒▒▀▀▀▀▄▄▄▀▒▒▒▒▒▐░░░\n"
+                             "░░░░░▄▄▀▒░▒▒▒▒▒▒▒▒▒█▒▒▄█▒▐░░░\n"
+                             "░░░▄▀▒▒▒░░░▒▒▒░░░▒▒▒▀██▀▒▌░░░\n"
+                             "░░▐▒▒▒▄▄▒▒▒▒░░░▒▒▒▒▒▒▒▀▄▒▒▌░░\n"
+                             "░░▌░░▌█▀▒▒▒▒▒▄▀█▄▒▒▒▒▒▒▒█▒▐░░\n"
+                             "░▐░░░▒▒▒▒▒▒▒▒▌██▀▒▒░░░▒▒▒▀▄▌░\n"
+                             "░▌░▒▄██▄▒▒▒▒▒▒▒▒▒░░░░░░▒▒▒▒▌░\n"
+                             "▀▒▀▐▄█▄█▌▄░▀▒▒░░░░░░░░░░▒▒▒▐░\n"
+                             "▐▒▒▐▀▐▀▒░▄▄▒▄▒▒▒▒▒▒░▒░▒░▒▒▒▒▌\n"
+                             "▐▒▒▒▀▀▄▄▒▒▒▄▒▒▒▒▒▒▒▒░▒░▒░▒▒▐░\n"
+                             "░▌▒▒▒▒▒▒▀▀▀▒▒▒▒▒▒░▒░▒░▒░▒▒▒▌░\n"
+                             "░▐▒▒▒▒▒▒▒▒▒▒▒▒▒▒░▒░▒░▒▒▄▒▒▐░░\n"
+                             "░░▀▄▒▒▒▒▒▒▒▒▒▒▒░▒░▒░▒▄▒▒▒▒▌░░\n"
+                             "░░░░▀▄▒▒▒▒▒▒▒▒▒▒▄▄▄▀▒▒▒▒▄▀░░░\n"
+                             "░░░░░░▀▄▄▄▄▄▄▀▀▀▒▒▒▒▒▄▄▀░░░░░\n"
                              "░░░░░░░░░▒▒▒▒▒▒▒▒▒▒▀▀░░░░░░░░");
             }
 
@@ -397,61 +599,61 @@ void Game::generateShitTalk(const communication::messages::broadcast::Snapshot &
         case DeltaType::SNITCH_SNATCH:break;
         case DeltaType::TROLL_ROAR:break;
         case DeltaType::ELF_TELEPORTATION:
-            if(gameLogic::conversions::idToSide(delta.getActiveEntity().value()) == mySide){
-                log.shitTalk(std::string("\n") +
-                "░░░░░▓▓▓▓▓▓▓▓▓▓▓░░░░░░░░\n" +
-                 "░░░▓▓▓▓▓▓▒▒▒▒▒▒▓▓░░░░░░░\n" +
-                 "░░▓▓▓▓▒░░▒▒▓▓▒▒▓▓▓▓░░░░░\n" +
-                 "░▓▓▓▓▒░░▓▓▓▒▄▓░▒▄▄▄▓░░░░\n" +
-                 "▓▓▓▓▓▒░░▒▀▀▀▀▒░▄░▄▒▓▓░░░\n" +
-                 "▓▓▓▓▓▒░░▒▒▒▒▒▓▒▀▒▀▒▓▒▓░░\n" +
-                 "▓▓▓▓▓▒▒░░░▒▒▒░░▄▀▀▀▄▓▒▓░\n" +
-                 "▓▓▓▓▓▓▒▒░░░▒▒▓▀▄▄▄▄▓▒▒▒▓\n" +
-                 "░▓█▀▄▒▓▒▒░░░▒▒░░▀▀▀▒▒▒▒\n" +
-                 " ░░▓█▒▒▄▒▒▒▒▒▒▒░░▒▒▒▒▒▒▓░\n" +
-                 "░░░▓▓▓▓▒▒▒▒▒▒▒▒░░░▒▒▒▓▓░\n" +
-                 "░░░░░▓▓▒░░▒▒▒▒▒▒▒▒▒▒▒▓▓\n" +
+            if(gameLogic::conversions::idToSide(delta.activeEntity.value()) == mySide){
+                log.shitTalk("\n"
+                "░░░░░▓▓▓▓▓▓▓▓▓▓▓░░░░░░░░\n"
+                 "░░░▓▓▓▓▓▓▒▒▒▒▒▒▓▓░░░░░░░\n"
+                 "░░▓▓▓▓▒░░▒▒▓▓▒▒▓▓▓▓░░░░░\n"
+                 "░▓▓▓▓▒░░▓▓▓▒▄▓░▒▄▄▄▓░░░░\n"
+                 "▓▓▓▓▓▒░░▒▀▀▀▀▒░▄░▄▒▓▓░░░\n"
+                 "▓▓▓▓▓▒░░▒▒▒▒▒▓▒▀▒▀▒▓▒▓░░\n"
+                 "▓▓▓▓▓▒▒░░░▒▒▒░░▄▀▀▀▄▓▒▓░\n"
+                 "▓▓▓▓▓▓▒▒░░░▒▒▓▀▄▄▄▄▓▒▒▒▓\n"
+                 "░▓█▀▄▒▓▒▒░░░▒▒░░▀▀▀▒▒▒▒\n"
+                 " ░░▓█▒▒▄▒▒▒▒▒▒▒░░▒▒▒▒▒▒▓░\n"
+                 "░░░▓▓▓▓▒▒▒▒▒▒▒▒░░░▒▒▒▓▓░\n"
+                 "░░░░░▓▓▒░░▒▒▒▒▒▒▒▒▒▒▒▓▓\n"
                  " ░░░░░░▓▒▒░░░░▒▒▒▒▒▒▒▓▓░░");
             }
             break;
         case DeltaType::GOBLIN_SHOCK:break;
         case DeltaType::BAN:
-            log.shitTalk(std::string("\n") +
-            "⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⡿⠛⠉⠙⠻⣿\n" +
-             "⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⡇⠂⠂⠂⠂⣿\n" +
-             "⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣷⣤⣀⣠⣴⣿\n" +
-             "⣿⣿⣿⣿⣿⣿⣿⣿⠿⠿⠿⠿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⡿⠿⢿⣿⣿\n" +
-             "⣿⣿⣿⡿⠛⠉⠂⠂⠂⠂⠂⠂⠂⠂⠉⠛⢿⣿⣿⣿⣿⣿⣿⣿⡏⠂⠂⠂⠈⣿\n" +
-             "⣿⣿⠋⠂⠂⠂⠂⠂⣀⣤⣤⣀⡀⠂⠂⠂⠂⠙⣿⣿⣿⣿⣿⣿⡇⠂⠂⠂⠂⣿\n" +
-             "⣿⠃⠂⠂⠂⠂⣰⣿⣿⣿⣿⣿⣿⣦⠂⠂⠂⠂⠘⣿⣿⣿⣿⣿⡇⠂⠂⠂⠂⣿\n" +
-             "⡏⠂⠂⠂⠂⢰⣿⣿⣿⣿⣿⣿⣿⣿⡇⠂⠂⠂⠂⢹⣿⣿⣿⣿⡇⠂⠂⠂⠂⣿\n" +
-             "⡇⠂⠂⠂⠂⢸⣿⣿⣿⣿⣿⣿⣿⣿⡇⠂⠂⠂⠂⢸⣿⣿⣿⣿⡇⠂⠂⠂⠂⣿\n" +
-             "⡇⠂⠂⠂⠂⢸⣿⣿⣿⣿⣿⣿⣿⣿⡇⠂⠂⠂⠂⢸⣿⣿⣿⣿⡇⠂⠂⠂⠂⣿\n" +
-             "⣿⡀⠂⠂⠂⠂⢿⣿⣿⣿⣿⣿⣿⡿⠁⠂⠂⠂⢀⣿⣿⣿⣿⣿⡇⠂⠂⠂⠂⣿\n" +
-             "⣿⣷⡀⠂⠂⠂⠂⠙⠻⠿⠿⠟⠋⠂⠂⠂⠂⢀⣾⣿⣿⣿⣿⣿⡇⠂⠂⠂⠂⣿\n" +
-             "⣿⣿⣿⣦⣀⠂⠂⠂⠂⠂⠂⠂⠂⠂⠂⢀⣴⣿⣿⣿⣿⣿⣿⣿⡇⠂⠂⠂⠂⣿\n" +
+            log.shitTalk("\n"
+            "⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⡿⠛⠉⠙⠻⣿\n"
+             "⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⡇⠂⠂⠂⠂⣿\n"
+             "⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣷⣤⣀⣠⣴⣿\n"
+             "⣿⣿⣿⣿⣿⣿⣿⣿⠿⠿⠿⠿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⡿⠿⢿⣿⣿\n"
+             "⣿⣿⣿⡿⠛⠉⠂⠂⠂⠂⠂⠂⠂⠂⠉⠛⢿⣿⣿⣿⣿⣿⣿⣿⡏⠂⠂⠂⠈⣿\n"
+             "⣿⣿⠋⠂⠂⠂⠂⠂⣀⣤⣤⣀⡀⠂⠂⠂⠂⠙⣿⣿⣿⣿⣿⣿⡇⠂⠂⠂⠂⣿\n"
+             "⣿⠃⠂⠂⠂⠂⣰⣿⣿⣿⣿⣿⣿⣦⠂⠂⠂⠂⠘⣿⣿⣿⣿⣿⡇⠂⠂⠂⠂⣿\n"
+             "⡏⠂⠂⠂⠂⢰⣿⣿⣿⣿⣿⣿⣿⣿⡇⠂⠂⠂⠂⢹⣿⣿⣿⣿⡇⠂⠂⠂⠂⣿\n"
+             "⡇⠂⠂⠂⠂⢸⣿⣿⣿⣿⣿⣿⣿⣿⡇⠂⠂⠂⠂⢸⣿⣿⣿⣿⡇⠂⠂⠂⠂⣿\n"
+             "⡇⠂⠂⠂⠂⢸⣿⣿⣿⣿⣿⣿⣿⣿⡇⠂⠂⠂⠂⢸⣿⣿⣿⣿⡇⠂⠂⠂⠂⣿\n"
+             "⣿⡀⠂⠂⠂⠂⢿⣿⣿⣿⣿⣿⣿⡿⠁⠂⠂⠂⢀⣿⣿⣿⣿⣿⡇⠂⠂⠂⠂⣿\n"
+             "⣿⣷⡀⠂⠂⠂⠂⠙⠻⠿⠿⠟⠋⠂⠂⠂⠂⢀⣾⣿⣿⣿⣿⣿⡇⠂⠂⠂⠂⣿\n"
+             "⣿⣿⣿⣦⣀⠂⠂⠂⠂⠂⠂⠂⠂⠂⠂⢀⣴⣿⣿⣿⣿⣿⣿⣿⡇⠂⠂⠂⠂⣿\n"
              "⣿⣿⣿⣿⣿⣷⣶⣤⣤⣤⣤⣤⣤⣶⣾⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣦⣤⣤⣾⣿");
             break;
         case DeltaType::BLUDGER_KNOCKOUT:
-            if(gameLogic::conversions::idToSide(delta.getPassiveEntity().value()) != mySide){
-                if(delta.isSuccess().value()){
+            if(gameLogic::conversions::idToSide(delta.passiveEntity.value()) != mySide){
+                if(delta.success.value()){
                     log.shitTalk("Immer mitten in die Fresse rein, na na na na na nana na na na na nana nana na...");
                 }
-            } else if(delta.isSuccess().value()){
-                log.shitTalk(std::string("\n") +
-                             "⢀⣠⣾⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⠀⠀⠀⠀⣠⣤⣶⣶\n" +
-                             "⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⠀⠀⠀⢰⣿⣿⣿⣿\n" +
-                             "⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣧⣀⣀⣾⣿⣿⣿⣿\n" +
-                             "⣿⣿⣿⣿⣿⡏⠉⠛⢿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⡿⣿\n" +
-                             "⣿⣿⣿⣿⣿⣿⠀⠀⠀⠈⠛⢿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⠿⠛⠉⠁⠀⣿\n" +
-                             "⣿⣿⣿⣿⣿⣿⣧⡀⠀⠀⠀⠀⠙⠿⠿⠿⠻⠿⠿⠟⠿⠛⠉⠀⠀⠀⠀⠀⣸⣿\n" +
-                             "⣿⣿⣿⣿⣿⣿⣿⣷⣄⠀⡀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⢀⣴⣿⣿\n" +
-                             "⣿⣿⣿⣿⣿⣿⣿⣿⣿⠏⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠠⣴⣿⣿⣿⣿\n" +
-                             "⣿⣿⣿⣿⣿⣿⣿⣿⡟⠀⠀⢰⣹⡆⠀⠀⠀⠀⠀⠀⣭⣷⠀⠀⠀⠸⣿⣿⣿⣿\n" +
-                             "⣿⣿⣿⣿⣿⣿⣿⣿⠃⠀⠀⠈⠉⠀⠀⠤⠄⠀⠀⠀⠉⠁⠀⠀⠀⠀⢿⣿⣿⣿\n" +
-                             "⣿⣿⣿⣿⣿⣿⣿⣿⢾⣿⣷⠀⠀⠀⠀⡠⠤⢄⠀⠀⠀⠠⣿⣿⣷⠀⢸⣿⣿⣿\n" +
-                             "⣿⣿⣿⣿⣿⣿⣿⣿⡀⠉⠀⠀⠀⠀⠀⢄⠀⢀⠀⠀⠀⠀⠉⠉⠁⠀⠀⣿⣿⣿\n" +
-                             "⣿⣿⣿⣿⣿⣿⣿⣿⣧⠀⠀⠀⠀⠀⠀⠀⠈⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⢹⣿⣿\n" +
+            } else if(delta.success.value()){
+                log.shitTalk("\n"
+                             "⢀⣠⣾⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⠀⠀⠀⠀⣠⣤⣶⣶\n"
+                             "⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⠀⠀⠀⢰⣿⣿⣿⣿\n"
+                             "⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣧⣀⣀⣾⣿⣿⣿⣿\n"
+                             "⣿⣿⣿⣿⣿⡏⠉⠛⢿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⡿⣿\n"
+                             "⣿⣿⣿⣿⣿⣿⠀⠀⠀⠈⠛⢿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⣿⠿⠛⠉⠁⠀⣿\n"
+                             "⣿⣿⣿⣿⣿⣿⣧⡀⠀⠀⠀⠀⠙⠿⠿⠿⠻⠿⠿⠟⠿⠛⠉⠀⠀⠀⠀⠀⣸⣿\n"
+                             "⣿⣿⣿⣿⣿⣿⣿⣷⣄⠀⡀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⢀⣴⣿⣿\n"
+                             "⣿⣿⣿⣿⣿⣿⣿⣿⣿⠏⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠠⣴⣿⣿⣿⣿\n"
+                             "⣿⣿⣿⣿⣿⣿⣿⣿⡟⠀⠀⢰⣹⡆⠀⠀⠀⠀⠀⠀⣭⣷⠀⠀⠀⠸⣿⣿⣿⣿\n"
+                             "⣿⣿⣿⣿⣿⣿⣿⣿⠃⠀⠀⠈⠉⠀⠀⠤⠄⠀⠀⠀⠉⠁⠀⠀⠀⠀⢿⣿⣿⣿\n"
+                             "⣿⣿⣿⣿⣿⣿⣿⣿⢾⣿⣷⠀⠀⠀⠀⡠⠤⢄⠀⠀⠀⠠⣿⣿⣷⠀⢸⣿⣿⣿\n"
+                             "⣿⣿⣿⣿⣿⣿⣿⣿⡀⠉⠀⠀⠀⠀⠀⢄⠀⢀⠀⠀⠀⠀⠉⠉⠁⠀⠀⣿⣿⣿\n"
+                             "⣿⣿⣿⣿⣿⣿⣿⣿⣧⠀⠀⠀⠀⠀⠀⠀⠈⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⢹⣿⣿\n"
                              "⣿⣿⣿⣿⣿⣿⣿⣿⣿⠃⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⠀⢸⣿⣿\n");
             }
 
@@ -473,18 +675,18 @@ void Game::generateShitTalk(const communication::messages::broadcast::Snapshot &
         case DeltaType::ROUND_CHANGE:break;
         case DeltaType::SKIP:break;
         case DeltaType::UNBAN:{
-            log.shitTalk(std::string("\n") +
-            "░░░░░░░░░░░░▄█▀█▀▀▀▀▀▀▀▀▄▄░░░░░░░░\n" +
-             "░░░░░░░░░░▄██▀░█░░░░░░░░░░▀▀▄▄░░░░\n" +
-             "░░░░░░░░░░███▀█▀█▄▄▄▄▄▄▄▒▒▒▄███░░░\n" +
-             "░░░░░░░░▄██░░░░█░░░░░░░░▀▀▀▀▀▀█░░░\n" +
-             "░░░░░░▄███░░░░░░█░░░░░░░░░░░░░░░░░\n" +
-             "░░░░░█████▄░░░░░█░░░░░░░░░░░░░░░░░\n" +
-             "░░░░████████▄▄░█░░░░A░NEW░░░░░░░░░\n" +
-             "░░░████████████░░░░░░TOUCAN░░░░░░░\n" +
-             "░░░▀██████████░░░░░░░░HAS░░░░░░░░░\n" +
-             "░░░░██▒▀█▒▀█▀░░░░░░░░░░ARRIVED░░░░\n" +
-             "░■▓▓▓▓▓▄▓▓▄▓▓▓▓▓▓▓▓■░░░░░░░░░░░░░░\n" +
+            log.shitTalk("\n"
+            "░░░░░░░░░░░░▄█▀█▀▀▀▀▀▀▀▀▄▄░░░░░░░░\n"
+             "░░░░░░░░░░▄██▀░█░░░░░░░░░░▀▀▄▄░░░░\n"
+             "░░░░░░░░░░███▀█▀█▄▄▄▄▄▄▄▒▒▒▄███░░░\n"
+             "░░░░░░░░▄██░░░░█░░░░░░░░▀▀▀▀▀▀█░░░\n"
+             "░░░░░░▄███░░░░░░█░░░░░░░░░░░░░░░░░\n"
+             "░░░░░█████▄░░░░░█░░░░░░░░░░░░░░░░░\n"
+             "░░░░████████▄▄░█░░░░A░NEW░░░░░░░░░\n"
+             "░░░████████████░░░░░░TOUCAN░░░░░░░\n"
+             "░░░▀██████████░░░░░░░░HAS░░░░░░░░░\n"
+             "░░░░██▒▀█▒▀█▀░░░░░░░░░░ARRIVED░░░░\n"
+             "░■▓▓▓▓▓▄▓▓▄▓▓▓▓▓▓▓▓■░░░░░░░░░░░░░░\n"
              "░░░▄▄███▀░░░░░░░░░░░░░░░░░░░░░░░░░\n");
             break;
         }
@@ -17,16 +17,41 @@
 #include <SopraGameLogic/GameController.h>
 #include <SopraAITools/AITools.h>
 #include <unordered_set>
+#include <atomic>
+#include <thread>
 #include <SopraUtil/Timer.h>
-#include <SopraUtil/Logging.hpp>
+#include <Util/AsyncLog.hpp>
+#include <Util/TelemetryWriter.hpp>
+#include <Communication/SnapshotFrame.hpp>
+#include <chrono>
+#include "SearchState.hpp"
+#include "TranspositionTable.hpp"
+#include "ShotTable.hpp"
+#include "Search.hpp"
+#include "TimeManager.hpp"
+#include "StateDiff.hpp"
+#include "OccupancyGrid.hpp"
+#include "OpeningBook.hpp"
+#include "OvertimeTable.hpp"
+#include "PathTable.hpp"
+#include "Engine.hpp"
+#include "Mcts.hpp"
 
 
 class Game {
 public:
-    Game(unsigned int difficulty, communication::messages::request::TeamConfig ownTeamConfig, util::Logging log);
+    Game(unsigned int difficulty, unsigned int threads, bool ponder, ai::Engine engine,
+            std::shared_ptr<util::TelemetryWriter> telemetry,
+            std::shared_ptr<const ai::OpeningBook> openingBook, communication::messages::request::TeamConfig ownTeamConfig,
+            util::AsyncLog log);
 
     /**
-     * Gets the TeamFormation for the match
+     * DTor. Stops pondering
+     */
+    ~Game();
+
+    /**
+     * Gets the TeamFormation for the match, taken from the opening book if it has one for the team configs
      * @return the TeamFormation for the match
      */
     auto getTeamFormation(const communication::messages::broadcast::MatchStart &matchStart) -> communication::messages::request::TeamFormation;
@@ -37,6 +62,12 @@ public:
      */
     void onSnapshot(const communication::messages::broadcast::Snapshot &snapshot);
 
+    /**
+     * Updates the game state after a broadcast parsed by the streaming parser
+     * @param snapshot the current game state from the server
+     */
+    void onSnapshot(const communication::SnapshotFrame &snapshot);
+
     /**
      * Returns the AIs next action
      * @param next information from the server for the requested turn
@@ -46,33 +77,128 @@ public:
     auto getNextAction(const communication::messages::broadcast::Next &next, util::Timer &timer)
         -> std::optional<communication::messages::request::DeltaRequest>;
 
+    /**
+     * Stops the running getNextAction as soon as possible, it still returns the best action found so far.
+     * Thread safe.
+     */
+    void abortSearch();
+
+    /**
+     * Returns the number of actions computed by the search and the number of states explored for them
+     * @return pair of searched actions and explored states since construction
+     */
+    auto getSearchStatistics() const -> std::pair<unsigned long, unsigned long>;
+
 private:
     int difficulty;
+    unsigned int threads;
+    bool ponder;
+    ai::Engine engine;
+    std::shared_ptr<util::TelemetryWriter> telemetry;
+    std::shared_ptr<const ai::OpeningBook> openingBook;
+    ai::OpeningBook::Brooms brooms{};
     bool gotFirstSnapshot = false;
     aiTools::State currentState;
+    ai::StateDiff lastSnapshotDiff;
+    ai::OccupancyGrid occupancy;
+    ai::PathTable pathTable;
+    std::optional<ai::SearchContext> searchContext;
+    std::shared_ptr<const ai::ShotTable> shotTable;
+    ai::TranspositionTable transpositionTable;
+    ai::TimeManager timeManager;
     gameModel::TeamSide mySide;
     communication::messages::request::TeamConfig myConfig;
     communication::messages::request::TeamConfig theirConfig = {};
     communication::messages::broadcast::MatchConfig matchConfig = {};
     communication::messages::types::EntityId lastId = communication::messages::types::EntityId::BLUDGER1;
-    mutable util::Logging log;
+    communication::messages::types::EntityId lastOpponentId = communication::messages::types::EntityId::BLUDGER1;
+    std::thread ponderThread;
+    std::atomic_bool stopPonder = false;
+    std::atomic_bool searchAborted = false;
+    std::optional<ai::PonderResult> ponderResult;
+    unsigned long searchedActions = 0;
+    unsigned long exploredStates = 0;
+    util::AsyncLog log;
+
+
+    /**
+     * Computes an action with the search of the engine, answers immediately if the position was prepared while
+     * pondering
+     * @param actionState the turn to compute an action for
+     * @param abort flag that stops the search
+     * @param deadline point in time at which abort is set
+     * @return the best action found
+     */
+    auto searchAction(const aiTools::ActionState &actionState, const std::atomic_bool &abort,
+                      std::chrono::steady_clock::time_point deadline) -> communication::messages::request::DeltaRequest;
+
+    /**
+     * Value of the current state, served from the eval cache if the state was evaluated before
+     */
+    auto currentValue() const -> double;
+
+    /**
+     * Cells the seeker should not move to: wombat cubes, other players and bludgers
+     * @param seeker the seeker to move
+     * @return the blocked cells
+     */
+    auto seekerObstacles(const gameModel::Player &seeker) const -> ai::CellSet;
+
+    /**
+     * Next cell of the own seeker once the snitch converges on the centre in overtime, looked up in the overtime table
+     * instead of searching a path
+     * @param seeker the seeker to move
+     * @return the cell to move to or nothing if the seeker should not move
+     */
+    auto overtimeSeekerStep(const gameModel::Player &seeker) const -> std::optional<gameModel::Position>;
 
+    /**
+     * Looks up the action for a turn in the opening book
+     * @param root the current state
+     * @param actionState the turn to compute an action for
+     * @return the possible action matching the book entry or nothing if the position is not in the book
+     */
+    auto bookAction(const ai::SearchState &root, const aiTools::ActionState &actionState) const
+        -> std::optional<communication::messages::request::DeltaRequest>;
+
+    /**
+     * Writes the statistics of a search to the telemetry output
+     * @param actionState the turn the search was run for
+     * @param result result of the search
+     * @param deadline point in time at which the search would have been aborted
+     * @param ponderHit whether the result was computed while pondering
+     */
+    void reportSearch(const aiTools::ActionState &actionState, const ai::SearchResult &result,
+                      std::chrono::steady_clock::time_point deadline, bool ponderHit);
+
+    /**
+     * Starts searching in the background while the opponent is thinking
+     * @param actionState the opponent's turn
+     */
+    void startPondering(const aiTools::ActionState &actionState);
+
+    /**
+     * Stops the background search, the result of pondering stays available
+     */
+    void stopPondering();
 
     /**
-     * Constructs a Team object from a given TeamSnapshot
+     * Constructs a Team object from a given TeamFrame
      * @param teamSnapshot
      * @param teamSide side on which the Team plays
      * @return gameModel::Team
      */
-    auto teamFromSnapshot(const communication::messages::broadcast::TeamSnapshot &teamSnapshot, gameModel::TeamSide teamSide) const ->
+    auto teamFromSnapshot(const communication::TeamFrame &teamSnapshot, gameModel::TeamSide teamSide) const ->
         std::shared_ptr<gameModel::Team>;
 
     /**
      * Such dank, much memes, very wow!
-     * @param snapshot
+     * @param delta the last delta of the snapshot
+     * @param diff the values the snapshot changed
+     * @param newState the state after the snapshot
      */
-    void generateShitTalk(const communication::messages::broadcast::Snapshot &snapshot,
-            const aiTools::State &lastState, const aiTools::State &newState) const;
+    void generateShitTalk(const communication::DeltaFrame &delta,
+            const ai::StateDiff &diff, const aiTools::State &newState) const;
 };
 
 
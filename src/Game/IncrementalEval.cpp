@@ -0,0 +1,217 @@
+/**
+ * @file IncrementalEval.cpp
+ * @brief Implements the incrementally updated version of ai::simpleEval
+ */
+
+#include "IncrementalEval.hpp"
+#include "AI.h"
+#include "EvalCache.hpp"
+#include "ShotTable.hpp"
+#include "OvertimeTable.hpp"
+#include <algorithm>
+#include <bitset>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <SopraGameLogic/GameController.h>
+
+namespace ai {
+    namespace {
+        /**
+         * Players that are able to hold the quaffle (keeper and chasers) of a team
+         */
+        constexpr auto candidateMask(std::size_t side) -> PlayerMask {
+            constexpr PlayerMask leftCandidates = ((1u << BEATER_OFFSET) - 1) & ~((1u << KEEPER_OFFSET) - 1);
+            return static_cast<PlayerMask>(leftCandidates << (side * PLAYERS_PER_TEAM));
+        }
+
+        auto count(PlayerMask mask) -> int {
+            return static_cast<int>(std::bitset<PLAYER_COUNT>(mask).count());
+        }
+    }
+
+    IncrementalEval::IncrementalEval(const SearchState &state, const SearchContext &context,
+                                     gameModel::TeamSide mySide) : context(&context), mySide(mySide) {
+        for (std::size_t side = 0; side < 2; side++) {
+            auto mask = teamMask(side == 0 ? gameModel::TeamSide::LEFT : gameModel::TeamSide::RIGHT);
+            updateQuaffleRanks(state, side);
+            updateSeekerDistance(state, side);
+            knockouts[side] = count(state.knockedOut & mask);
+            bans[side] = count(state.banned & mask);
+        }
+
+        for (std::size_t i = 0; i < PLAYER_COUNT; i++) {
+            updateQuaffleHolder(state, i);
+        }
+    }
+
+    void IncrementalEval::update(const SearchState &from, const SearchState &to) {
+        PlayerMask moved = 0;
+        for (std::size_t i = 0; i < PLAYER_COUNT; i++) {
+            if (from.players[i] != to.players[i]) {
+                moved |= 1u << i;
+            }
+        }
+
+        PlayerMask bannedChanged = from.banned ^ to.banned;
+        PlayerMask changed = moved | bannedChanged | (from.knockedOut ^ to.knockedOut);
+        bool quaffleMoved = from.quaffle != to.quaffle;
+        PlayerMask holderCandidates = quaffleMoved ? teamMask(gameModel::TeamSide::LEFT) |
+                teamMask(gameModel::TeamSide::RIGHT) : moved | bannedChanged;
+        for (std::size_t i = 0; holderCandidates != 0; i++, holderCandidates >>= 1) {
+            if (holderCandidates & 1u) {
+                updateQuaffleHolder(to, i);
+            }
+        }
+
+        for (std::size_t side = 0; side < 2; side++) {
+            auto mask = teamMask(side == 0 ? gameModel::TeamSide::LEFT : gameModel::TeamSide::RIGHT);
+            if (quaffleMoved || (changed & candidateMask(side))) {
+                updateQuaffleRanks(to, side);
+            }
+
+            auto seeker = side * PLAYERS_PER_TEAM + SEEKER_OFFSET;
+            if (from.snitch != to.snitch || from.overtimeState != to.overtimeState ||
+                ((changed >> seeker) & 1u)) {
+                updateSeekerDistance(to, side);
+            }
+
+            knockouts[side] += count(to.knockedOut & ~from.knockedOut & mask) - count(from.knockedOut & ~to.knockedOut & mask);
+            bans[side] += count(to.banned & ~from.banned & mask) - count(from.banned & ~to.banned & mask);
+        }
+
+#ifdef CHECK_INCREMENTAL_EVAL
+        [[maybe_unused]] auto expected = simpleEval(to.toState(*context), mySide);
+        [[maybe_unused]] auto actual = value(to);
+        assert(actual == expected || std::abs(actual - expected) <= 1e-9 * std::max(1.0, std::abs(expected)));
+#endif
+    }
+
+    auto IncrementalEval::value(const SearchState &state) const -> double {
+        constexpr auto halfGoal = gameController::GOAL_POINTS / 2;
+        constexpr auto disqPenalty = std::numeric_limits<int>::max();
+        constexpr auto maxDist = 16;
+        double val = 0;
+        auto me = sideIndex(mySide);
+        auto op = 1 - me;
+
+        //Score difference
+        auto scoreDiff = state.scores[me] - state.scores[op];
+        val += scoreDiff;
+
+        //Eval quaffle players
+        if(onQuaffle != 0){
+            //Holding quaffle counts as half a goal, the lowest index is the player that would be found first
+            val += (onQuaffle & -onQuaffle & teamMask(mySide)) ? halfGoal : -halfGoal;
+        } else {
+            //Calc distance advantage over opponent
+            double decay = 0.5;
+            for(std::size_t i = 0; i < std::max(quaffleCandidates[me], quaffleCandidates[op]); i++){
+                val += std::max(std::min(quaffleRanks[op][i] - quaffleRanks[me][i], gameController::GOAL_POINTS), -gameController::GOAL_POINTS) * decay;
+                decay /= 2;
+            }
+        }
+
+        //Eval seeker
+        if(state.snitchExists){
+            auto mySeeker = me * PLAYERS_PER_TEAM + SEEKER_OFFSET;
+            auto opponentSeeker = op * PLAYERS_PER_TEAM + SEEKER_OFFSET;
+            bool mySeekerFined = state.isBanned(mySeeker);
+            bool opSeekerFined = state.isBanned(opponentSeeker);
+            bool mySeekerIncapacitated = mySeekerFined || state.isKnockedOut(mySeeker);
+            bool opSeekerIncapacitated = opSeekerFined || state.isKnockedOut(opponentSeeker);
+            if(!mySeekerIncapacitated && seekerDistances[me] == 0){
+                if(scoreDiff < -gameController::SNITCH_POINTS) {
+                    val -= gameController::SNITCH_POINTS;
+                } else {
+                    val += gameController::SNITCH_POINTS;
+                }
+            } else if(!opSeekerIncapacitated && seekerDistances[op] == 0){
+                if(scoreDiff > gameController::SNITCH_POINTS) {
+                    val += gameController::SNITCH_POINTS;
+                } else {
+                    val -= gameController::SNITCH_POINTS;
+                }
+            }
+
+            auto distDiff = 2 * (seekerDistances[op] - seekerDistances[me]);
+            if(!mySeekerFined && !opSeekerFined) {
+                val += distDiff;
+            }
+
+            if (mySeekerFined && !opSeekerFined && !state.goalScoredThisRound) {
+                val -= maxDist - seekerDistances[me];
+            }
+
+            if(opSeekerFined && !mySeekerFined && !state.goalScoredThisRound) {
+                val += maxDist - seekerDistances[me];
+            }
+        }
+
+        // Knockout advantage
+        val += 2 * (knockouts[op] - knockouts[me]);
+
+        // Ban advantage
+        auto banned = bans[me];
+        val -= banned * banned * banned * gameController::SNITCH_POINTS;
+
+        //Disqualification penalty
+        if(banned > 2 && !state.goalScoredThisRound){
+            val -= disqPenalty;
+        }
+
+        //Goal chance advantage
+        auto otherSide = op == 0 ? gameModel::TeamSide::LEFT : gameModel::TeamSide::RIGHT;
+        auto chanceDiff = context->shots->hypotheticalShot(mySide, state.quaffle, ShotTable::occupancy(state, otherSide))
+                - context->shots->hypotheticalShot(otherSide, state.quaffle, ShotTable::occupancy(state, mySide));
+        val += halfGoal * chanceDiff;
+
+        return val;
+    }
+
+    auto IncrementalEval::cachedValue(const SearchState &state) const -> double {
+        auto key = EvalCache::keyOf(state, *context, mySide);
+        auto &cache = EvalCache::forThread();
+        if (auto cached = cache.probe(key)) {
+            return *cached;
+        }
+
+        auto ret = value(state);
+        cache.store(key, ret);
+        return ret;
+    }
+
+    bool IncrementalEval::operator==(const IncrementalEval &other) const {
+        return context == other.context && mySide == other.mySide && quaffleRanks == other.quaffleRanks &&
+               quaffleCandidates == other.quaffleCandidates && onQuaffle == other.onQuaffle &&
+               seekerDistances == other.seekerDistances && knockouts == other.knockouts && bans == other.bans;
+    }
+
+    void IncrementalEval::updateQuaffleRanks(const SearchState &state, std::size_t side) {
+        auto &ranks = quaffleRanks[side];
+        auto &candidates = quaffleCandidates[side];
+        ranks.fill(std::numeric_limits<int>::max());
+        candidates = 0;
+        for (auto i = side * PLAYERS_PER_TEAM + KEEPER_OFFSET; i < side * PLAYERS_PER_TEAM + BEATER_OFFSET; i++) {
+            if (!state.isBanned(i) && !state.isKnockedOut(i)) {
+                ranks[candidates++] = distance(state.players[i], state.quaffle);
+            }
+        }
+
+        std::sort(ranks.begin(), ranks.begin() + candidates);
+    }
+
+    void IncrementalEval::updateQuaffleHolder(const SearchState &state, std::size_t player) {
+        if (state.players[player] == state.quaffle && !state.isBanned(player)) {
+            onQuaffle |= 1u << player;
+        } else {
+            onQuaffle &= ~(1u << player);
+        }
+    }
+
+    void IncrementalEval::updateSeekerDistance(const SearchState &state, std::size_t side) {
+        auto seeker = side * PLAYERS_PER_TEAM + SEEKER_OFFSET;
+        seekerDistances[side] = seekerDistance(state.players[seeker], state.snitch, state.isKnockedOut(seeker),
+                                               static_cast<gameController::ExcessLength>(state.overtimeState));
+    }
+}
@@ -0,0 +1,71 @@
+/**
+ * @file IncrementalEval.hpp
+ * @brief Declares the incrementally updated version of ai::simpleEval
+ */
+
+#ifndef KI_INCREMENTALEVAL_HPP
+#define KI_INCREMENTALEVAL_HPP
+
+#include "SearchState.hpp"
+
+namespace ai {
+    /**
+     * Keeps the expensive terms of simpleEval (quaffle-distance ranks, quaffle holder, seeker distances, knockout
+     * and ban counts) as accumulators. Moving from a state to a successor only updates the terms of the entities
+     * that changed, evaluating is then constant time. Going back to the parent is done by keeping a copy.
+     *
+     * If the macro CHECK_INCREMENTAL_EVAL is defined the value after every update is checked against simpleEval of
+     * the converted aiTools::State.
+     */
+    class IncrementalEval {
+    public:
+        /**
+         * CTor. Computes all terms from scratch
+         * @param state the state to evaluate
+         * @param context match constants of the state
+         * @param mySide The Side that the KI is playing
+         */
+        IncrementalEval(const SearchState &state, const SearchContext &context, gameModel::TeamSide mySide);
+
+        /**
+         * Updates the terms after the state changed
+         * @param from the state the terms currently belong to
+         * @param to the new state
+         */
+        void update(const SearchState &from, const SearchState &to);
+
+        /**
+         * Evaluates a state, the result is identical to simpleEval
+         * @param state the state the terms belong to
+         * @return A number indicating how favorable the state is. The higher the number the better
+         */
+        auto value(const SearchState &state) const -> double;
+
+        /**
+         * Same as value() but served from and stored to the EvalCache of the calling thread
+         * @param state the state the terms belong to, its key has to be up to date
+         * @return A number indicating how favorable the state is. The higher the number the better
+         */
+        auto cachedValue(const SearchState &state) const -> double;
+
+        bool operator==(const IncrementalEval &other) const;
+
+    private:
+        static constexpr std::size_t QUAFFLE_CANDIDATES = 4;
+
+        void updateQuaffleRanks(const SearchState &state, std::size_t side);
+        void updateQuaffleHolder(const SearchState &state, std::size_t player);
+        void updateSeekerDistance(const SearchState &state, std::size_t side);
+
+        const SearchContext *context;
+        gameModel::TeamSide mySide;
+        std::array<std::array<int, QUAFFLE_CANDIDATES>, 2> quaffleRanks{};
+        std::array<std::size_t, 2> quaffleCandidates{};
+        PlayerMask onQuaffle = 0;
+        std::array<int, 2> seekerDistances{};
+        std::array<int, 2> knockouts{};
+        std::array<int, 2> bans{};
+    };
+}
+
+#endif //KI_INCREMENTALEVAL_HPP
@@ -0,0 +1,344 @@
+/**
+ * @file Mcts.cpp
+ * @brief Implements the Monte Carlo tree search operating on SearchStates
+ */
+
+#include "Mcts.hpp"
+#include "MoveOrdering.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+#include <SopraGameLogic/conversions.h>
+
+namespace ai {
+    namespace {
+        /**
+         * Exploration constant of UCT for rewards in [0, 1]
+         */
+        constexpr double EXPLORATION = 0.7;
+
+        /**
+         * Advantage over the root in points that corresponds to a win rate of about 76%
+         */
+        constexpr double WIN_RATE_SCALE = 2 * gameController::GOAL_POINTS;
+
+        constexpr double MAX_WIN_RATE = 1 - 1e-9;
+        constexpr unsigned long FIRST_REPORT = 64;
+
+        /**
+         * Disqualifications are worth ±infinity in simpleEval
+         */
+        auto clampValue(double value) -> double {
+            return std::clamp(value, SIMPLE_EVAL_BOUNDS.lower, SIMPLE_EVAL_BOUNDS.upper);
+        }
+
+        auto toWinRate(double value) -> double {
+            return 0.5 + 0.5 * std::tanh(value / WIN_RATE_SCALE);
+        }
+
+        auto fromWinRate(double winRate) -> double {
+            return WIN_RATE_SCALE * std::atanh(std::clamp(2 * winRate - 1, -MAX_WIN_RATE, MAX_WIN_RATE));
+        }
+
+        void atomicAdd(std::atomic<double> &target, double value) {
+            auto current = target.load(std::memory_order_relaxed);
+            while (!target.compare_exchange_weak(current, current + value, std::memory_order_relaxed)) {}
+        }
+
+        /**
+         * Index of a randomly chosen outcome
+         * @param probabilities callable returning the probability of the i-th outcome
+         */
+        template<typename Probabilities>
+        auto sampleOutcome(std::size_t count, const Probabilities &probabilities, std::mt19937_64 &random)
+            -> std::size_t {
+            auto sample = std::uniform_real_distribution<double>{0, 1}(random);
+            for (std::size_t i = 0; i + 1 < count; i++) {
+                sample -= probabilities(i);
+                if (sample < 0) {
+                    return i;
+                }
+            }
+
+            return count - 1;
+        }
+    }
+
+    NodePool::NodePool(std::size_t capacity) : capacity(capacity) {}
+
+    auto NodePool::allocate(std::size_t count) -> MctsNode * {
+        std::lock_guard<std::mutex> lock{mutex};
+        if (count == 0 || used + count > capacity) {
+            return nullptr;
+        }
+
+        // Nodes of one allocation never span two blocks, the rest of a block that is too small is skipped
+        if (blocks.empty() || blockUsed + count > BLOCK_SIZE) {
+            blocks.emplace_back(std::make_unique<MctsNode[]>(std::max(count, BLOCK_SIZE)));
+            blockUsed = 0;
+        }
+
+        auto *ret = &blocks.back()[blockUsed];
+        blockUsed += count;
+        used += count;
+        return ret;
+    }
+
+    auto NodePool::size() const -> std::size_t {
+        std::lock_guard<std::mutex> lock{mutex};
+        return used;
+    }
+
+    bool NodePool::exhausted() const {
+        std::lock_guard<std::mutex> lock{mutex};
+        return used >= capacity;
+    }
+
+    Mcts::Mcts(const SearchContext &context, gameModel::TeamSide mySide, unsigned int threads,
+               std::size_t nodeCapacity, std::uint64_t seed) :
+            context(context), mySide(mySide), threads(std::max(threads, 1u)), nodeCapacity(nodeCapacity),
+            seed(seed) {}
+
+    void Mcts::setRolloutDepth(unsigned int depth) {
+        rolloutDepth = depth;
+    }
+
+    auto Mcts::computeBestAction(const SearchState &root, const aiTools::ActionState &actionState,
+                                 const std::atomic_bool &abort, unsigned long maxPlayouts,
+                                 const IterationCallback &keepSearching) -> SearchResult {
+        auto start = std::chrono::steady_clock::now();
+        const IncrementalEval rootEval(root, context, mySide);
+        Tree tree{NodePool{nodeCapacity}, {}, rootEval, clampValue(rootEval.value(root))};
+        tree.root.state = root;
+        tree.root.next = actionState;
+        std::vector<Worker> workers(threads);
+        for (unsigned int i = 0; i < threads; i++) {
+            workers[i].random.seed(seed + i);
+        }
+
+        if (!expandNode(tree.root, tree.pool, workers.front())) {
+            throw std::runtime_error("No action possible");
+        }
+
+        tree.root.status = MctsNode::Status::Expanded;
+        std::atomic_ulong playouts = 0;
+        std::atomic_bool stop = false;
+        auto running = [&abort, &stop, &playouts, maxPlayouts]() {
+            return !abort && !stop && playouts < maxPlayouts;
+        };
+
+        std::vector<std::thread> helpers;
+        helpers.reserve(threads - 1);
+        for (unsigned int i = 1; i < threads; i++) {
+            helpers.emplace_back([this, &tree, &worker = workers[i], &playouts, &running]() {
+                while (running()) {
+                    playout(tree, worker);
+                    playouts++;
+                }
+            });
+        }
+
+        auto nextReport = FIRST_REPORT;
+        while (running()) {
+            playout(tree, workers.front());
+            if (++playouts >= nextReport && keepSearching) {
+                nextReport *= 2;
+                if (!keepSearching(bestAction(tree))) {
+                    stop = true;
+                }
+            }
+        }
+
+        stop = true;
+        for (auto &helper : helpers) {
+            helper.join();
+        }
+
+        auto ret = bestAction(tree);
+        for (const auto &worker : workers) {
+            ret.depth = std::max(ret.depth, worker.depth);
+            ret.expansions += worker.expansions;
+            ret.stats.add(worker.stats);
+        }
+
+        std::chrono::duration<double, std::milli> time = std::chrono::steady_clock::now() - start;
+        ret.stats.iterations.push_back({ret.depth, ret.expansions, time.count()});
+        return ret;
+    }
+
+    void Mcts::playout(Tree &tree, Worker &worker) const {
+        // Selection: descend with UCT until a node that is not expanded yet
+        auto eval = tree.rootEval;
+        auto *node = &tree.root;
+        worker.path.clear();
+        while (node->next.has_value()) {
+            auto status = node->status.load(std::memory_order_acquire);
+            if (status == MctsNode::Status::Unexpanded) {
+                if (node->status.compare_exchange_strong(status, MctsNode::Status::Expanding,
+                                                         std::memory_order_acquire)) {
+                    auto expanded = expandNode(*node, tree.pool, worker);
+                    node->status.store(expanded ? MctsNode::Status::Expanded : MctsNode::Status::Leaf,
+                                       std::memory_order_release);
+                }
+
+                break;
+            }
+
+            // Nodes expanded by another thread right now are treated as leaves
+            if (status != MctsNode::Status::Expanded) {
+                break;
+            }
+
+            auto &edge = select(*node);
+            edge.virtualLoss++;
+            auto &child = edge.outcomes[sampleOutcome(edge.outcomeCount, [&edge](std::size_t i) {
+                return edge.outcomes[i].probability;
+            }, worker.random)];
+            eval.update(node->state, child.state);
+            worker.path.emplace_back(&edge);
+            node = &child;
+        }
+
+        worker.depth = std::max(worker.depth, static_cast<unsigned int>(worker.path.size()));
+        auto winRate = toWinRate(rollout(*node, eval, worker) - tree.rootValue);
+        for (auto *edge : worker.path) {
+            edge->visits++;
+            atomicAdd(edge->wins, winRate);
+            edge->virtualLoss--;
+        }
+
+        worker.stats.playouts++;
+    }
+
+    bool Mcts::expandNode(MctsNode &node, NodePool &pool, Worker &worker) const {
+        if (pool.exhausted()) {
+            return false;
+        }
+
+        Arena::Scope scope(worker.arena);
+        auto successors = expand(node.state, context, *node.next, &worker.arena);
+        worker.expansions++;
+        worker.stats.children += successors.size();
+        if (successors.empty()) {
+            return false;
+        }
+
+        // Unvisited actions are tried first to last, so the tactical ones are tried first
+        ArenaVector<std::pair<int, std::size_t>> order{ArenaAllocator<std::pair<int, std::size_t>>{&worker.arena}};
+        order.reserve(successors.size());
+        std::size_t outcomeCount = 0;
+        for (std::size_t i = 0; i < successors.size(); i++) {
+            order.emplace_back(MoveOrdering::tacticalScore(node.state, successors[i].action), i);
+            outcomeCount += successors[i].outcomes.size();
+        }
+
+        std::stable_sort(order.begin(), order.end(), [](const auto &a, const auto &b) {
+            return a.first > b.first;
+        });
+
+        auto *children = pool.allocate(outcomeCount);
+        if (children == nullptr) {
+            return false;
+        }
+
+        auto edges = std::make_unique<MctsEdge[]>(successors.size());
+        for (std::size_t i = 0; i < order.size(); i++) {
+            auto &successor = successors[order[i].second];
+            auto &edge = edges[i];
+            edge.action = std::move(successor.action);
+            edge.outcomes = children;
+            edge.outcomeCount = successor.outcomes.size();
+            for (auto &outcome : successor.outcomes) {
+                children->state = outcome.state;
+                children->next = outcome.next;
+                children->probability = outcome.probability;
+                children++;
+            }
+        }
+
+        node.edges = std::move(edges);
+        node.edgeCount = successors.size();
+        return true;
+    }
+
+    auto Mcts::select(const MctsNode &node) const -> MctsEdge & {
+        double parentVisits = 0;
+        for (std::size_t i = 0; i < node.edgeCount; i++) {
+            auto visits = node.edges[i].visits.load(std::memory_order_relaxed) +
+                          node.edges[i].virtualLoss.load(std::memory_order_relaxed);
+            if (visits == 0) {
+                return node.edges[i];
+            }
+
+            parentVisits += static_cast<double>(visits);
+        }
+
+        const auto logVisits = std::log(parentVisits);
+        const bool maximize = isMyTurn(*node.next);
+        auto best = &node.edges[0];
+        double bestValue = -1;
+        for (std::size_t i = 0; i < node.edgeCount; i++) {
+            auto &edge = node.edges[i];
+            auto visits = static_cast<double>(edge.visits.load(std::memory_order_relaxed));
+            auto wins = edge.wins.load(std::memory_order_relaxed);
+            auto played = visits + static_cast<double>(edge.virtualLoss.load(std::memory_order_relaxed));
+            auto value = (maximize ? wins : visits - wins) / played + EXPLORATION * std::sqrt(logVisits / played);
+            if (value > bestValue) {
+                bestValue = value;
+                best = &edge;
+            }
+        }
+
+        return *best;
+    }
+
+    auto Mcts::rollout(const MctsNode &node, IncrementalEval eval, Worker &worker) const -> double {
+        auto state = node.state;
+        auto next = node.next;
+        for (unsigned int ply = 0; ply < rolloutDepth && next.has_value(); ply++) {
+            Arena::Scope scope(worker.arena);
+            auto successors = expand(state, context, *next, &worker.arena);
+            worker.expansions++;
+            worker.stats.children += successors.size();
+            if (successors.empty()) {
+                break;
+            }
+
+            const auto &outcomes = successors[std::uniform_int_distribution<std::size_t>{
+                    0, successors.size() - 1}(worker.random)].outcomes;
+            auto &outcome = outcomes[sampleOutcome(outcomes.size(), [&outcomes](std::size_t i) {
+                return outcomes[i].probability;
+            }, worker.random)];
+            eval.update(state, outcome.state);
+            state = outcome.state;
+            next = outcome.next;
+        }
+
+        worker.stats.evals++;
+        return clampValue(eval.cachedValue(state));
+    }
+
+    auto Mcts::bestAction(const Tree &tree) const -> SearchResult {
+        // The most visited action is the most robust choice, the win rate only breaks ties
+        const auto &root = tree.root;
+        const MctsEdge *best = &root.edges[0];
+        for (std::size_t i = 1; i < root.edgeCount; i++) {
+            const auto &edge = root.edges[i];
+            auto visits = edge.visits.load();
+            if (visits > best->visits.load() ||
+                (visits == best->visits.load() && edge.wins.load() > best->wins.load())) {
+                best = &edge;
+            }
+        }
+
+        auto visits = best->visits.load();
+        auto winRate = visits == 0 ? 0.5 : best->wins.load() / static_cast<double>(visits);
+        return {best->action, 0, 0, tree.rootValue + fromWinRate(winRate), {}, {}};
+    }
+
+    bool Mcts::isMyTurn(const aiTools::ActionState &actionState) const {
+        return gameLogic::conversions::idToSide(actionState.id) == mySide;
+    }
+}
@@ -0,0 +1,212 @@
+/**
+ * @file Mcts.hpp
+ * @brief Declares the Monte Carlo tree search operating on SearchStates
+ */
+
+#ifndef KI_MCTS_HPP
+#define KI_MCTS_HPP
+
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <vector>
+#include "SearchState.hpp"
+#include "IncrementalEval.hpp"
+#include "Search.hpp"
+
+namespace ai {
+    struct MctsNode;
+
+    /**
+     * Action of a node of the Monte Carlo tree. All counters are updated concurrently by the search threads.
+     */
+    struct MctsEdge {
+        communication::messages::request::DeltaRequest action;
+
+        /**
+         * The outcomes of the action, outcomeCount consecutive nodes
+         */
+        MctsNode *outcomes = nullptr;
+        std::size_t outcomeCount = 0;
+
+        std::atomic<unsigned long> visits = 0;
+
+        /**
+         * Playouts currently running through the edge, they count as lost for the player choosing the action
+         */
+        std::atomic<unsigned long> virtualLoss = 0;
+
+        /**
+         * Sum of the win rates of the KI over all finished playouts
+         */
+        std::atomic<double> wins = 0;
+    };
+
+    /**
+     * State of the Monte Carlo tree and the turn that follows it
+     */
+    struct MctsNode {
+        enum class Status : std::uint8_t {
+            Unexpanded, Expanding, Expanded, Leaf
+        };
+
+        SearchState state;
+
+        /**
+         * The next turn, nothing if the match is over
+         */
+        std::optional<aiTools::ActionState> next;
+
+        /**
+         * Probability of the node among the outcomes of its action
+         */
+        double probability = 1;
+
+        /**
+         * Edges may only be read once the status is Expanded
+         */
+        std::atomic<Status> status = Status::Unexpanded;
+        std::unique_ptr<MctsEdge[]> edges;
+        std::size_t edgeCount = 0;
+    };
+
+    /**
+     * Allocates the nodes of one search in blocks, the nodes are released all at once when the pool is destroyed.
+     * The number of nodes is limited, the tree stops growing when the pool is exhausted.
+     */
+    class NodePool {
+    public:
+        static constexpr std::size_t BLOCK_SIZE = 4096;
+
+        /**
+         * CTor
+         * @param capacity maximum number of nodes
+         */
+        explicit NodePool(std::size_t capacity);
+
+        /**
+         * Allocates consecutive nodes, thread safe
+         * @param count number of nodes
+         * @return the first node or nullptr if the pool is exhausted
+         */
+        auto allocate(std::size_t count) -> MctsNode *;
+
+        /**
+         * Number of allocated nodes
+         */
+        auto size() const -> std::size_t;
+
+        /**
+         * Whether no more nodes can be allocated
+         */
+        bool exhausted() const;
+
+    private:
+        const std::size_t capacity;
+        mutable std::mutex mutex;
+        std::vector<std::unique_ptr<MctsNode[]>> blocks;
+        std::size_t blockUsed = 0;
+        std::size_t used = 0;
+    };
+
+    /**
+     * Tree parallel Monte Carlo tree search. Actions are selected with UCT, outcomes of chance nodes are sampled by
+     * their probability. Playouts are cut off after a few random plies and evaluated with simpleEval (carried along
+     * as an IncrementalEval), the gain over the root is squashed to a win rate in [0, 1]. All threads share one tree, virtual
+     * losses keep them from running through the same path at the same time.
+     */
+    class Mcts {
+    public:
+        static constexpr std::size_t DEFAULT_NODE_CAPACITY = 1 << 18;
+        static constexpr unsigned int DEFAULT_ROLLOUT_DEPTH = 2;
+
+        /**
+         * CTor
+         * @param context match constants used for expansion and evaluation
+         * @param mySide the side the KI is playing
+         * @param threads number of threads running playouts in parallel
+         * @param nodeCapacity maximum number of nodes of the tree
+         * @param seed seed of the random numbers of the first thread, the other threads use the following seeds
+         */
+        Mcts(const SearchContext &context, gameModel::TeamSide mySide, unsigned int threads = 1,
+             std::size_t nodeCapacity = DEFAULT_NODE_CAPACITY, std::uint64_t seed = 0);
+
+        /**
+         * Sets the number of random plies of a playout after it left the tree
+         * @param depth number of plies, 0 evaluates the new leaf directly
+         */
+        void setRolloutDepth(unsigned int depth);
+
+        /**
+         * Computes the best action for the given turn
+         * @param root the current state
+         * @param actionState the turn to compute an action for
+         * @param abort flag that stops the search
+         * @param maxPlayouts number of playouts after which the search stops, exceeded by at most the number of
+         * threads - 1
+         * @param keepSearching called by the first thread with the intermediate result after 64, 128, 256, ...
+         * playouts, the search stops if it returns false
+         * @return the most visited action, depth is the depth of the tree and expansions counts the expanded nodes
+         * in the tree and in the playouts
+         * @throws std::runtime_error if there is no possible action
+         */
+        auto computeBestAction(const SearchState &root, const aiTools::ActionState &actionState,
+                               const std::atomic_bool &abort,
+                               unsigned long maxPlayouts = std::numeric_limits<unsigned long>::max(),
+                               const IterationCallback &keepSearching = {}) -> SearchResult;
+
+    private:
+        /**
+         * Data of one search thread
+         */
+        struct Worker {
+            std::mt19937_64 random;
+            std::vector<MctsEdge *> path;
+            Arena arena;
+            SearchStats stats;
+            unsigned long expansions = 0;
+            unsigned int depth = 0;
+        };
+
+        /**
+         * Tree of one search, shared by all threads
+         */
+        struct Tree {
+            NodePool pool;
+            MctsNode root;
+            IncrementalEval rootEval;
+
+            /**
+             * Value of the root, playouts are scored relative to it so that a large score difference does not
+             * saturate the win rates
+             */
+            double rootValue;
+        };
+
+        void playout(Tree &tree, Worker &worker) const;
+
+        bool expandNode(MctsNode &node, NodePool &pool, Worker &worker) const;
+
+        auto select(const MctsNode &node) const -> MctsEdge &;
+
+        auto rollout(const MctsNode &node, IncrementalEval eval, Worker &worker) const -> double;
+
+        /**
+         * The most visited action of the root and its value, safe to call while the search is running
+         */
+        auto bestAction(const Tree &tree) const -> SearchResult;
+
+        bool isMyTurn(const aiTools::ActionState &actionState) const;
+
+        const SearchContext &context;
+        gameModel::TeamSide mySide;
+        unsigned int threads;
+        std::size_t nodeCapacity;
+        std::uint64_t seed;
+        unsigned int rolloutDepth = DEFAULT_ROLLOUT_DEPTH;
+    };
+}
+
+#endif //KI_MCTS_HPP
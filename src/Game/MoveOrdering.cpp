@@ -0,0 +1,178 @@
+/**
+ * @file MoveOrdering.cpp
+ * @brief Implements the move ordering heuristics of the alpha-beta search
+ */
+
+#include "MoveOrdering.hpp"
+#include <algorithm>
+#include <limits>
+#include <tuple>
+
+namespace ai {
+    namespace {
+        constexpr int THROW_AT_GOAL = 4;
+        constexpr int ADVANCE_QUAFFLE = 3;
+        constexpr int WREST_QUAFFLE = 3;
+        constexpr int BEAT_AT_PLAYER = 3;
+        constexpr int BEAT_BLUDGER = 2;
+        constexpr int PICK_UP_QUAFFLE = 2;
+
+        auto entitySlot(const std::optional<communication::messages::types::EntityId> &id) -> std::size_t {
+            if (id.has_value()) {
+                for (std::size_t i = 0; i < PLAYER_COUNT; i++) {
+                    if (playerIds[i] == *id) {
+                        return i;
+                    }
+                }
+            }
+
+            return PLAYER_COUNT;
+        }
+
+        auto targetOf(const communication::messages::request::DeltaRequest &action) -> Cell {
+            if (action.getXPosNew().has_value() && action.getYPosNew().has_value()) {
+                return toCell({*action.getXPosNew(), *action.getYPosNew()});
+            }
+
+            return NO_CELL;
+        }
+
+        /**
+         * Distance of a cell to the closest goal ring attacked by the team of a player
+         */
+        auto goalDistance(std::size_t player, Cell cell) -> int {
+            // Same goal rings as ShotTable::hypotheticalShot
+            auto goals = player < PLAYERS_PER_TEAM ? gameModel::Environment::getGoalsRight() :
+                    gameModel::Environment::getGoalsLeft();
+            auto ret = std::numeric_limits<int>::max();
+            for (const auto &goal : goals) {
+                ret = std::min(ret, distance(cell, toCell(goal)));
+            }
+
+            return ret;
+        }
+    }
+
+    auto MoveKey::of(const communication::messages::request::DeltaRequest &action) -> MoveKey {
+        return {static_cast<std::uint8_t>(entitySlot(action.getActiveEntity())),
+                static_cast<std::uint8_t>(action.getDeltaType()), targetOf(action)};
+    }
+
+    bool MoveKey::operator==(const MoveKey &other) const {
+        return entity == other.entity && type == other.type && target == other.target;
+    }
+
+    bool MoveKey::operator!=(const MoveKey &other) const {
+        return !(*this == other);
+    }
+
+    MoveOrdering::MoveOrdering() : history((PLAYER_COUNT + 1) * TYPE_SLOTS * (CELL_COUNT + 1), 0) {}
+
+    auto MoveOrdering::order(const SearchState &state, const Successors &successors,
+                             std::optional<std::size_t> tableMove, unsigned int ply,
+                             Arena *arena) const -> ArenaVector<std::size_t> {
+        // Sorted by (table move, tactical score, killer slot, history), all descending
+        using Priority = std::tuple<bool, int, int, std::uint32_t>;
+        ArenaVector<std::pair<Priority, std::size_t>> priorities{ArenaAllocator<std::pair<Priority, std::size_t>>{arena}};
+        priorities.reserve(successors.size());
+        const auto &plyKillers = killers[std::min<std::size_t>(ply, MAX_PLY - 1)];
+        for (std::size_t i = 0; i < successors.size(); i++) {
+            auto key = MoveKey::of(successors[i].action);
+            int killer = 0;
+            for (std::size_t slot = 0; slot < KILLER_COUNT; slot++) {
+                if (plyKillers[slot] == key) {
+                    killer = static_cast<int>(KILLER_COUNT - slot);
+                    break;
+                }
+            }
+
+            priorities.push_back({{tableMove == i, tacticalScore(state, successors[i].action), killer,
+                                   history[historyIndex(key)]}, i});
+        }
+
+        std::stable_sort(priorities.begin(), priorities.end(), [](const auto &a, const auto &b) {
+            return a.first > b.first;
+        });
+
+        ArenaVector<std::size_t> ret{ArenaAllocator<std::size_t>{arena}};
+        ret.reserve(priorities.size());
+        for (const auto &priority : priorities) {
+            ret.emplace_back(priority.second);
+        }
+
+        return ret;
+    }
+
+    void MoveOrdering::onCutoff(const SearchState &state, const Successor &successor, unsigned int ply,
+                                unsigned int depth) {
+        // Tactical moves are searched early anyway, killers and history are for the quiet ones
+        if (tacticalScore(state, successor.action) > 0) {
+            return;
+        }
+
+        auto key = MoveKey::of(successor.action);
+        auto &plyKillers = killers[std::min<std::size_t>(ply, MAX_PLY - 1)];
+        if (plyKillers.front() != key) {
+            std::move_backward(plyKillers.begin(), plyKillers.end() - 1, plyKillers.end());
+            plyKillers.front() = key;
+        }
+
+        auto &score = history[historyIndex(key)];
+        score = std::min<std::uint64_t>(std::uint64_t{score} + depth * depth, std::numeric_limits<std::uint32_t>::max());
+    }
+
+    void MoveOrdering::newSearch() {
+        for (auto &plyKillers : killers) {
+            plyKillers.fill(std::nullopt);
+        }
+
+        for (auto &score : history) {
+            score /= 2;
+        }
+    }
+
+    auto MoveOrdering::tacticalScore(const SearchState &state,
+                                     const communication::messages::request::DeltaRequest &action) -> int {
+        using communication::messages::types::DeltaType;
+        auto player = entitySlot(action.getActiveEntity());
+        auto target = targetOf(action);
+        if (player == PLAYER_COUNT) {
+            return 0;
+        }
+
+        switch (action.getDeltaType()) {
+            case DeltaType::QUAFFLE_THROW:
+                if (target == NO_CELL || state.quaffle == NO_CELL) {
+                    return 0;
+                }
+
+                if (goalDistance(player, target) == 0) {
+                    return THROW_AT_GOAL;
+                }
+
+                return goalDistance(player, target) < goalDistance(player, state.quaffle) ? ADVANCE_QUAFFLE : 0;
+            case DeltaType::WREST_QUAFFLE:
+                return WREST_QUAFFLE;
+            case DeltaType::BLUDGER_BEATING:
+                return target != NO_CELL && state.playerOn(target).has_value() ? BEAT_AT_PLAYER : BEAT_BLUDGER;
+            case DeltaType::MOVE:
+                if (target == NO_CELL || state.quaffle == NO_CELL) {
+                    return 0;
+                }
+
+                if (state.players[player] == state.quaffle) {
+                    return goalDistance(player, target) < goalDistance(player, state.quaffle) ? ADVANCE_QUAFFLE : 0;
+                }
+
+                return target == state.quaffle ? PICK_UP_QUAFFLE : 0;
+            default:
+                return 0;
+        }
+    }
+
+    auto MoveOrdering::historyIndex(const MoveKey &key) -> std::size_t {
+        auto type = std::min<std::size_t>(key.type, TYPE_SLOTS - 1);
+        auto target = std::min<std::size_t>(key.target, CELL_COUNT);
+        return (key.entity * TYPE_SLOTS + type) * (CELL_COUNT + 1) + target;
+    }
+}
@@ -0,0 +1,93 @@
+/**
+ * @file MoveOrdering.hpp
+ * @brief Declares the move ordering heuristics of the alpha-beta search
+ */
+
+#ifndef KI_MOVEORDERING_HPP
+#define KI_MOVEORDERING_HPP
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include "SearchState.hpp"
+
+namespace ai {
+    /**
+     * Identity of an action independent of the state it is played in
+     */
+    struct MoveKey {
+        std::uint8_t entity;
+        std::uint8_t type;
+        Cell target;
+
+        /**
+         * Key of an action
+         * @param action the action
+         * @return the acting player (PLAYER_COUNT for all other entities), the delta type and the target cell
+         */
+        static auto of(const communication::messages::request::DeltaRequest &action) -> MoveKey;
+
+        bool operator==(const MoveKey &other) const;
+        bool operator!=(const MoveKey &other) const;
+    };
+
+    /**
+     * Decides in which order the successors of a node are searched: the best move stored in the transposition
+     * table, the killer moves of the ply, tactical moves (advancing the quaffle, wresting it, beating a bludger) and
+     * finally all other moves by their history score. Killers and history are collected from beta cutoffs, one
+     * instance belongs to exactly one search thread.
+     */
+    class MoveOrdering {
+    public:
+        static constexpr std::size_t MAX_PLY = 64;
+        static constexpr std::size_t KILLER_COUNT = 2;
+
+        MoveOrdering();
+
+        /**
+         * Order of the successors of a node
+         * @param state the state of the node
+         * @param successors the successors in generation order
+         * @param tableMove index of the best move stored in the transposition table
+         * @param ply distance of the node to the root
+         * @param arena arena the order is allocated from, the global allocator is used if it is nullptr
+         * @return indices into successors, the successor to search first comes first
+         */
+        auto order(const SearchState &state, const Successors &successors, std::optional<std::size_t> tableMove,
+                   unsigned int ply, Arena *arena = nullptr) const -> ArenaVector<std::size_t>;
+
+        /**
+         * Records a successor that caused a beta cutoff
+         * @param state the state of the node
+         * @param successor the successor
+         * @param ply distance of the node to the root
+         * @param depth remaining depth of the node
+         */
+        void onCutoff(const SearchState &state, const Successor &successor, unsigned int ply, unsigned int depth);
+
+        /**
+         * Forgets the killers and halves the history scores, called before every search
+         */
+        void newSearch();
+
+        /**
+         * Priority of a move without any search information
+         * @param state the state the action is played in
+         * @param action the action
+         * @return 0 for quiet moves, higher values are searched first
+         */
+        static auto tacticalScore(const SearchState &state, const communication::messages::request::DeltaRequest &action)
+            -> int;
+
+    private:
+        static constexpr std::size_t TYPE_SLOTS = 32;
+
+        std::array<std::array<std::optional<MoveKey>, KILLER_COUNT>, MAX_PLY> killers;
+        std::vector<std::uint32_t> history;
+
+        static auto historyIndex(const MoveKey &key) -> std::size_t;
+    };
+}
+
+#endif //KI_MOVEORDERING_HPP
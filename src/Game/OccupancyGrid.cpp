@@ -0,0 +1,93 @@
+/**
+ * @file OccupancyGrid.cpp
+ * @brief Implements the grid of the players standing on each cell of the pitch
+ */
+
+#include "OccupancyGrid.hpp"
+
+namespace ai {
+    OccupancyGrid::OccupancyGrid() {
+        cells.fill(EMPTY);
+        positions.fill(NO_CELL);
+    }
+
+    OccupancyGrid::OccupancyGrid(const gameModel::Environment &env) : OccupancyGrid() {
+        update(env);
+    }
+
+    OccupancyGrid::OccupancyGrid(const SearchState &state) : OccupancyGrid() {
+        for (std::size_t i = 0; i < PLAYER_COUNT; i++) {
+            if (!state.isBanned(i)) {
+                move(i, state.players[i]);
+            }
+        }
+    }
+
+    auto OccupancyGrid::update(const gameModel::Environment &env) -> std::optional<std::pair<std::size_t, std::size_t>> {
+        // Remove all players that moved first, otherwise a player moving onto the old cell of another one would
+        // be reported as a collision
+        std::array<Cell, PLAYER_COUNT> targets{};
+        for (const auto &player : env.getAllPlayers()) {
+            auto index = playerIndex(player->getId());
+            targets[index] = player->isFined ? NO_CELL : toCell(player->position);
+            if (targets[index] != positions[index]) {
+                move(index, NO_CELL);
+            }
+        }
+
+        std::optional<std::pair<std::size_t, std::size_t>> collision;
+        for (std::size_t i = 0; i < PLAYER_COUNT; i++) {
+            if (targets[i] != positions[i]) {
+                if (auto other = move(i, targets[i]); other.has_value() && !collision.has_value()) {
+                    collision.emplace(*other, i);
+                }
+            }
+        }
+
+        return collision;
+    }
+
+    auto OccupancyGrid::move(std::size_t player, Cell cell) -> std::optional<std::size_t> {
+        if (cell != NO_CELL && cells[cell] != EMPTY && cells[cell] != player) {
+            return cells[cell];
+        }
+
+        if (positions[player] != NO_CELL) {
+            cells[positions[player]] = EMPTY;
+        }
+
+        positions[player] = cell;
+        if (cell != NO_CELL) {
+            cells[cell] = static_cast<std::uint8_t>(player);
+        }
+
+        return std::nullopt;
+    }
+
+    auto OccupancyGrid::playerAt(Cell cell) const -> std::optional<std::size_t> {
+        if (cell == NO_CELL || cells[cell] == EMPTY) {
+            return std::nullopt;
+        }
+
+        return cells[cell];
+    }
+
+    auto OccupancyGrid::playerAt(const gameModel::Position &position) const ->
+            std::optional<communication::messages::types::EntityId> {
+        auto player = playerAt(toCell(position));
+        if (!player.has_value()) {
+            return std::nullopt;
+        }
+
+        return playerIds[*player];
+    }
+
+    bool OccupancyGrid::teamHasQuaffle(gameModel::TeamSide side, Cell quaffle) const {
+        auto player = playerAt(quaffle);
+        return player.has_value() && sideOf(*player) == side;
+    }
+
+    auto OccupancyGrid::sideOf(std::size_t player) -> gameModel::TeamSide {
+        return player < PLAYERS_PER_TEAM ? gameModel::TeamSide::LEFT : gameModel::TeamSide::RIGHT;
+    }
+}
@@ -0,0 +1,93 @@
+/**
+ * @file OccupancyGrid.hpp
+ * @brief Declares the grid of the players standing on each cell of the pitch
+ */
+
+#ifndef KI_OCCUPANCYGRID_HPP
+#define KI_OCCUPANCYGRID_HPP
+
+#include <array>
+#include <optional>
+#include <utility>
+#include <SopraGameLogic/GameModel.h>
+#include "SearchState.hpp"
+
+namespace ai {
+    /**
+     * 17x13 grid that stores for every cell the index (into playerIds) of the player standing on it, so finding
+     * the player on a cell, the holder of the quaffle or the team of a player are array accesses instead of scans
+     * over the environment. Banned players are not on the pitch and therefore not part of the grid.
+     */
+    class OccupancyGrid {
+    public:
+        /**
+         * CTor. Empty grid
+         */
+        OccupancyGrid();
+
+        /**
+         * CTor. Places all players of an environment, of two players sharing a cell only one is placed
+         * @param env the environment
+         */
+        explicit OccupancyGrid(const gameModel::Environment &env);
+
+        /**
+         * CTor. Places all players of a SearchState, of two players sharing a cell only one is placed
+         * @param state the state
+         */
+        explicit OccupancyGrid(const SearchState &state);
+
+        /**
+         * Moves the players whose position or ban changed since the last update
+         * @param env the environment the grid was built from
+         * @return indices of two players that are not banned but share a cell, the second one is not placed
+         */
+        auto update(const gameModel::Environment &env) -> std::optional<std::pair<std::size_t, std::size_t>>;
+
+        /**
+         * Moves a player to a cell
+         * @param player index of the player
+         * @param cell the new cell or NO_CELL to remove the player
+         * @return index of the player already standing on the cell, the grid is unchanged in this case
+         */
+        auto move(std::size_t player, Cell cell) -> std::optional<std::size_t>;
+
+        /**
+         * The player standing on a cell
+         * @param cell a cell, NO_CELL is never occupied
+         * @return index of the player or nothing if the cell is free
+         */
+        auto playerAt(Cell cell) const -> std::optional<std::size_t>;
+
+        /**
+         * The player standing on a position
+         * @param position a position, positions outside of the pitch are never occupied
+         * @return id of the player or nothing if the position is free
+         */
+        auto playerAt(const gameModel::Position &position) const ->
+            std::optional<communication::messages::types::EntityId>;
+
+        /**
+         * Checks if a player of a team stands on the quaffle
+         * @param side the team
+         * @param quaffle cell of the quaffle
+         * @return true if a member of the team is on the quaffle cell
+         */
+        bool teamHasQuaffle(gameModel::TeamSide side, Cell quaffle) const;
+
+        /**
+         * Team of a player
+         * @param player index of the player
+         * @return the side the player plays on
+         */
+        static auto sideOf(std::size_t player) -> gameModel::TeamSide;
+
+    private:
+        static constexpr std::uint8_t EMPTY = 0xFF;
+
+        std::array<std::uint8_t, CELL_COUNT> cells;
+        std::array<Cell, PLAYER_COUNT> positions;
+    };
+}
+
+#endif //KI_OCCUPANCYGRID_HPP
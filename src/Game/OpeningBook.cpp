@@ -0,0 +1,280 @@
+/**
+ * @file OpeningBook.cpp
+ * @brief Implements the opening book of team formations and early-game actions
+ */
+
+#include "OpeningBook.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "Zobrist.hpp"
+
+namespace ai {
+    namespace {
+        using Payload = std::array<std::uint8_t, 8>;
+
+        constexpr std::array<char, 8> MAGIC = {'K', 'I', 'B', 'O', 'O', 'K', '0', '1'};
+        constexpr std::size_t HEADER_SIZE = MAGIC.size() + sizeof(std::uint64_t);
+        constexpr std::uint8_t NO_ENTITY = 0xFF;
+        constexpr std::uint64_t FORMATION_SEED = 0x466F726D6174696F;
+
+        auto broomsKey(const OpeningBook::Brooms &brooms) -> std::uint64_t {
+            std::uint64_t ret = 0;
+            for (std::size_t i = 0; i < PLAYER_COUNT; i++) {
+                ret = splitMix(ret ^ (i << 8 | static_cast<std::uint64_t>(brooms[i])));
+            }
+
+            return ret;
+        }
+
+        auto entityByte(const std::optional<communication::messages::types::EntityId> &entity) -> std::uint8_t {
+            return entity.has_value() ? static_cast<std::uint8_t>(*entity) : NO_ENTITY;
+        }
+
+        auto entityOf(std::uint8_t byte) -> std::optional<communication::messages::types::EntityId> {
+            if (byte == NO_ENTITY) {
+                return std::nullopt;
+            }
+
+            return static_cast<communication::messages::types::EntityId>(byte);
+        }
+
+        auto encodeFormation(const communication::messages::request::TeamFormation &formation) -> Payload {
+            return {toCell({formation.getSeekerX(), formation.getSeekerY()}),
+                    toCell({formation.getKeeperX(), formation.getKeeperY()}),
+                    toCell({formation.getChaser1X(), formation.getChaser1Y()}),
+                    toCell({formation.getChaser2X(), formation.getChaser2Y()}),
+                    toCell({formation.getChaser3X(), formation.getChaser3Y()}),
+                    toCell({formation.getBeater1X(), formation.getBeater1Y()}),
+                    toCell({formation.getBeater2X(), formation.getBeater2Y()}), 0};
+        }
+
+        auto encodeAction(const communication::messages::request::DeltaRequest &action) -> Payload {
+            Cell target = NO_CELL;
+            if (action.getXPosNew().has_value() && action.getYPosNew().has_value()) {
+                target = toCell({*action.getXPosNew(), *action.getYPosNew()});
+            }
+
+            return {static_cast<std::uint8_t>(action.getDeltaType()), entityByte(action.getActiveEntity()),
+                    entityByte(action.getPassiveEntity()), target, 0, 0, 0, 0};
+        }
+    }
+
+    void OpeningBook::Builder::addFormation(std::uint64_t key,
+                                            const communication::messages::request::TeamFormation &formation,
+                                            double result) {
+        add(key, encodeFormation(formation), result);
+    }
+
+    void OpeningBook::Builder::addMove(std::uint64_t key, const communication::messages::request::DeltaRequest &action,
+                                       double result) {
+        add(key, encodeAction(action), result);
+    }
+
+    void OpeningBook::Builder::add(std::uint64_t key, const Payload &payload, double result) {
+        auto &keyCandidates = candidates[key];
+        auto candidate = std::find_if(keyCandidates.begin(), keyCandidates.end(),
+                                      [&payload](const Candidate &c) { return c.payload == payload; });
+        if (candidate == keyCandidates.end()) {
+            keyCandidates.emplace_back(Candidate{payload, 1, result});
+        } else {
+            candidate->games++;
+            candidate->resultSum += result;
+        }
+    }
+
+    auto OpeningBook::Builder::write(const std::string &path, unsigned long minGames) const -> std::size_t {
+        std::vector<Entry> out;
+        out.reserve(candidates.size());
+        for (const auto &[key, keyCandidates] : candidates) {
+            const Candidate *best = nullptr;
+            unsigned long games = 0;
+            for (const auto &candidate : keyCandidates) {
+                games += candidate.games;
+                auto mean = candidate.resultSum / static_cast<double>(candidate.games);
+                if (best == nullptr || mean > best->resultSum / static_cast<double>(best->games) ||
+                    (mean == best->resultSum / static_cast<double>(best->games) && candidate.games > best->games)) {
+                    best = &candidate;
+                }
+            }
+
+            if (best != nullptr && games >= minGames) {
+                out.emplace_back(Entry{key, best->payload});
+            }
+        }
+
+        std::sort(out.begin(), out.end(), [](const Entry &a, const Entry &b) { return a.key < b.key; });
+        std::ofstream file{path, std::ios::binary | std::ios::trunc};
+        std::uint64_t size = out.size();
+        file.write(MAGIC.data(), MAGIC.size());
+        file.write(reinterpret_cast<const char *>(&size), sizeof(size));
+        file.write(reinterpret_cast<const char *>(out.data()), static_cast<std::streamsize>(out.size() * sizeof(Entry)));
+        if (!file) {
+            throw std::runtime_error("Can't write opening book " + path);
+        }
+
+        return out.size();
+    }
+
+    OpeningBook::OpeningBook(const std::string &path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Can't open opening book " + path);
+        }
+
+        struct stat info{};
+        if (::fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < HEADER_SIZE) {
+            ::close(fd);
+            throw std::runtime_error("Invalid opening book " + path);
+        }
+
+        mappingSize = static_cast<std::size_t>(info.st_size);
+        mapping = ::mmap(nullptr, mappingSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (mapping == MAP_FAILED) {
+            mapping = nullptr;
+            throw std::runtime_error("Can't map opening book " + path);
+        }
+
+        const auto *bytes = static_cast<const char *>(mapping);
+        std::uint64_t size;
+        std::memcpy(&size, bytes + MAGIC.size(), sizeof(size));
+        if (!std::equal(MAGIC.begin(), MAGIC.end(), bytes) || size > (mappingSize - HEADER_SIZE) / sizeof(Entry) ||
+            HEADER_SIZE + size * sizeof(Entry) != mappingSize) {
+            ::munmap(mapping, mappingSize);
+            mapping = nullptr;
+            throw std::runtime_error("Invalid opening book " + path);
+        }
+
+        entries = reinterpret_cast<const Entry *>(bytes + HEADER_SIZE);
+        count = size;
+    }
+
+    OpeningBook::~OpeningBook() {
+        if (mapping != nullptr) {
+            ::munmap(mapping, mappingSize);
+        }
+    }
+
+    OpeningBook::OpeningBook(OpeningBook &&other) noexcept :
+            mapping{std::exchange(other.mapping, nullptr)}, mappingSize{std::exchange(other.mappingSize, 0)},
+            entries{std::exchange(other.entries, nullptr)}, count{std::exchange(other.count, 0)} {}
+
+    OpeningBook &OpeningBook::operator=(OpeningBook &&other) noexcept {
+        if (this != &other) {
+            if (mapping != nullptr) {
+                ::munmap(mapping, mappingSize);
+            }
+
+            mapping = std::exchange(other.mapping, nullptr);
+            mappingSize = std::exchange(other.mappingSize, 0);
+            entries = std::exchange(other.entries, nullptr);
+            count = std::exchange(other.count, 0);
+        }
+
+        return *this;
+    }
+
+    auto OpeningBook::probeFormation(std::uint64_t key) const ->
+            std::optional<communication::messages::request::TeamFormation> {
+        const auto *entry = find(key);
+        if (entry == nullptr) {
+            return std::nullopt;
+        }
+
+        std::array<gameModel::Position, PLAYERS_PER_TEAM> positions;
+        for (std::size_t i = 0; i < PLAYERS_PER_TEAM; i++) {
+            if (entry->payload[i] >= CELL_COUNT) {
+                return std::nullopt;
+            }
+
+            positions[i] = toPosition(entry->payload[i]);
+        }
+
+        return communication::messages::request::TeamFormation{
+                positions[SEEKER_OFFSET].x, positions[SEEKER_OFFSET].y,
+                positions[KEEPER_OFFSET].x, positions[KEEPER_OFFSET].y,
+                positions[CHASER_OFFSET].x, positions[CHASER_OFFSET].y,
+                positions[CHASER_OFFSET + 1].x, positions[CHASER_OFFSET + 1].y,
+                positions[CHASER_OFFSET + 2].x, positions[CHASER_OFFSET + 2].y,
+                positions[BEATER_OFFSET].x, positions[BEATER_OFFSET].y,
+                positions[BEATER_OFFSET + 1].x, positions[BEATER_OFFSET + 1].y};
+    }
+
+    auto OpeningBook::probeMove(std::uint64_t key) const ->
+            std::optional<communication::messages::request::DeltaRequest> {
+        const auto *entry = find(key);
+        if (entry == nullptr) {
+            return std::nullopt;
+        }
+
+        std::optional<int> x, y;
+        if (entry->payload[3] < CELL_COUNT) {
+            auto target = toPosition(entry->payload[3]);
+            x = target.x;
+            y = target.y;
+        }
+
+        return communication::messages::request::DeltaRequest{
+                static_cast<communication::messages::types::DeltaType>(entry->payload[0]), std::nullopt, std::nullopt,
+                std::nullopt, x, y, entityOf(entry->payload[1]), entityOf(entry->payload[2]), std::nullopt,
+                std::nullopt, std::nullopt, std::nullopt, std::nullopt};
+    }
+
+    auto OpeningBook::size() const -> std::size_t {
+        return count;
+    }
+
+    auto OpeningBook::formationKey(gameModel::TeamSide side, const Brooms &brooms) -> std::uint64_t {
+        return splitMix(FORMATION_SEED + static_cast<std::uint64_t>(sideIndex(side))) ^ broomsKey(brooms);
+    }
+
+    auto OpeningBook::moveKey(const SearchState &state, const aiTools::ActionState &actionState,
+                              const Brooms &brooms) -> std::uint64_t {
+        return nodeKey(state, actionState) ^ broomsKey(brooms);
+    }
+
+    auto OpeningBook::broomsOf(const gameModel::Environment &env) -> Brooms {
+        Brooms ret{};
+        for (const auto &player : env.getAllPlayers()) {
+            ret[playerIndex(player->getId())] = player->broom;
+        }
+
+        return ret;
+    }
+
+    auto OpeningBook::broomsOf(const communication::messages::request::TeamConfig &left,
+                               const communication::messages::request::TeamConfig &right) -> Brooms {
+        Brooms ret{};
+        for (const auto *config : {&left, &right}) {
+            auto offset = config == &left ? 0 : PLAYERS_PER_TEAM;
+            ret[offset + SEEKER_OFFSET] = config->getSeeker().getBroom();
+            ret[offset + KEEPER_OFFSET] = config->getKeeper().getBroom();
+            ret[offset + CHASER_OFFSET] = config->getChaser1().getBroom();
+            ret[offset + CHASER_OFFSET + 1] = config->getChaser2().getBroom();
+            ret[offset + CHASER_OFFSET + 2] = config->getChaser3().getBroom();
+            ret[offset + BEATER_OFFSET] = config->getBeater1().getBroom();
+            ret[offset + BEATER_OFFSET + 1] = config->getBeater2().getBroom();
+        }
+
+        return ret;
+    }
+
+    bool OpeningBook::sameAction(const communication::messages::request::DeltaRequest &a,
+                                 const communication::messages::request::DeltaRequest &b) {
+        return encodeAction(a) == encodeAction(b);
+    }
+
+    auto OpeningBook::find(std::uint64_t key) const -> const Entry * {
+        const auto *end = entries + count;
+        const auto *entry = std::lower_bound(entries, end, key,
+                                             [](const Entry &e, std::uint64_t k) { return e.key < k; });
+        return entry != end && entry->key == key ? entry : nullptr;
+    }
+}
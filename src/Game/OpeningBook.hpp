@@ -0,0 +1,171 @@
+/**
+ * @file OpeningBook.hpp
+ * @brief Declares the opening book of team formations and early-game actions
+ */
+
+#ifndef KI_OPENINGBOOK_HPP
+#define KI_OPENINGBOOK_HPP
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <SopraMessages/DeltaRequest.hpp>
+#include <SopraMessages/TeamConfig.hpp>
+#include <SopraMessages/TeamFormation.hpp>
+#include <SopraAITools/AITools.h>
+#include "SearchState.hpp"
+
+namespace ai {
+    /**
+     * Read-only table of team formations and actions for the first rounds of a match, built offline from self-play.
+     * The book is a binary file that is memory mapped, entries are sorted by their 64 bit key and found by binary
+     * search. Keys combine the position (nodeKey) or the side (formations) with the brooms of all players, so
+     * every pairing of team configs has its own lines.
+     *
+     * File layout (native byte order): 8 byte magic, 8 byte number of entries, entries of 16 bytes each.
+     */
+    class OpeningBook {
+    public:
+        /**
+         * Brooms of all players in the order of playerIds
+         */
+        using Brooms = std::array<communication::messages::types::Broom, PLAYER_COUNT>;
+
+        /**
+         * Collects the formations and actions played in self-play matches and writes the book
+         */
+        class Builder {
+        public:
+            /**
+             * Records the formation a team started a match with
+             * @param key formationKey of the team
+             * @param formation the formation
+             * @param result outcome of the match from the view of the team, higher is better
+             */
+            void addFormation(std::uint64_t key, const communication::messages::request::TeamFormation &formation,
+                              double result);
+
+            /**
+             * Records an action played in a match
+             * @param key moveKey of the position
+             * @param action the action
+             * @param result outcome of the match from the view of the acting team, higher is better
+             */
+            void addMove(std::uint64_t key, const communication::messages::request::DeltaRequest &action,
+                         double result);
+
+            /**
+             * Writes the choice with the best average result of every recorded key
+             * @param path the file to write
+             * @param minGames keys recorded in fewer matches are left out
+             * @return number of entries written
+             * @throws std::runtime_error if the file can't be written
+             */
+            auto write(const std::string &path, unsigned long minGames = 1) const -> std::size_t;
+
+        private:
+            struct Candidate {
+                std::array<std::uint8_t, 8> payload;
+                unsigned long games;
+                double resultSum;
+            };
+
+            std::unordered_map<std::uint64_t, std::vector<Candidate>> candidates;
+
+            void add(std::uint64_t key, const std::array<std::uint8_t, 8> &payload, double result);
+        };
+
+        /**
+         * CTor. Empty book
+         */
+        OpeningBook() = default;
+
+        /**
+         * CTor. Maps a book file
+         * @param path the file written by Builder::write
+         * @throws std::runtime_error if the file can't be opened or is no book
+         */
+        explicit OpeningBook(const std::string &path);
+
+        ~OpeningBook();
+
+        OpeningBook(const OpeningBook &) = delete;
+        OpeningBook &operator=(const OpeningBook &) = delete;
+        OpeningBook(OpeningBook &&other) noexcept;
+        OpeningBook &operator=(OpeningBook &&other) noexcept;
+
+        /**
+         * Looks up the formation for a team
+         * @param key formationKey of the team
+         * @return the formation or nothing if the book has none
+         */
+        auto probeFormation(std::uint64_t key) const -> std::optional<communication::messages::request::TeamFormation>;
+
+        /**
+         * Looks up the action for a position. Only the type, the entities and the target of the action are stored,
+         * use sameAction to find the complete action among the possible ones.
+         * @param key moveKey of the position
+         * @return the action or nothing if the book has none
+         */
+        auto probeMove(std::uint64_t key) const -> std::optional<communication::messages::request::DeltaRequest>;
+
+        /**
+         * Number of entries in the book
+         */
+        auto size() const -> std::size_t;
+
+        /**
+         * Key of the formation of a team
+         * @param side the side of the team
+         * @param brooms brooms of all players
+         */
+        static auto formationKey(gameModel::TeamSide side, const Brooms &brooms) -> std::uint64_t;
+
+        /**
+         * Key of a position
+         * @param state the state
+         * @param actionState the turn to be played
+         * @param brooms brooms of all players
+         */
+        static auto moveKey(const SearchState &state, const aiTools::ActionState &actionState,
+                            const Brooms &brooms) -> std::uint64_t;
+
+        /**
+         * Brooms of the players of an environment
+         */
+        static auto broomsOf(const gameModel::Environment &env) -> Brooms;
+
+        /**
+         * Brooms of the players of two team configs
+         */
+        static auto broomsOf(const communication::messages::request::TeamConfig &left,
+                             const communication::messages::request::TeamConfig &right) -> Brooms;
+
+        /**
+         * Compares the parts of two actions that are stored in the book
+         * @return true if both actions have the same type, entities and target
+         */
+        static bool sameAction(const communication::messages::request::DeltaRequest &a,
+                               const communication::messages::request::DeltaRequest &b);
+
+    private:
+        struct Entry {
+            std::uint64_t key;
+            std::array<std::uint8_t, 8> payload;
+        };
+
+        static_assert(sizeof(Entry) == 16, "Entries are stored as they are laid out in memory");
+
+        void *mapping = nullptr;
+        std::size_t mappingSize = 0;
+        const Entry *entries = nullptr;
+        std::size_t count = 0;
+
+        auto find(std::uint64_t key) const -> const Entry *;
+    };
+}
+
+#endif //KI_OPENINGBOOK_HPP
@@ -0,0 +1,204 @@
+/**
+ * @file OvertimeTable.cpp
+ * @brief Implements the table of snitch catch distances for the overtime stages
+ */
+
+#include "OvertimeTable.hpp"
+#include <algorithm>
+#include <deque>
+#include <vector>
+
+namespace ai {
+    namespace {
+        constexpr std::uint8_t UNREACHABLE = 0xFF;
+        const gameModel::Position centre{8, 6};
+
+        /**
+         * Catch distances indexed by (seeker * CELL_COUNT + snitch) * 2 + knockedOut
+         */
+        struct CatchTable {
+            std::array<bool, CELL_COUNT> onPitch{};
+            std::array<Cell, CELL_COUNT> steps{};
+            std::array<std::vector<Cell>, CELL_COUNT> neighbours;
+            std::vector<std::uint8_t> turns;
+
+            auto at(std::size_t seeker, std::size_t snitch, bool knockedOut) -> std::uint8_t & {
+                return turns[(seeker * CELL_COUNT + snitch) * 2 + knockedOut];
+            }
+
+            auto at(std::size_t seeker, std::size_t snitch, bool knockedOut) const -> std::uint8_t {
+                return turns[(seeker * CELL_COUNT + snitch) * 2 + knockedOut];
+            }
+
+            /**
+             * Turns still needed after the seeker ended its turn on a cell. The snitch can't fly onto the seeker, it
+             * stays next to it and is caught in the following turn.
+             */
+            auto remaining(Cell seeker, Cell snitch) const -> std::uint8_t {
+                if (seeker == snitch) {
+                    return 0;
+                }
+
+                return seeker == steps[snitch] ? 1 : at(seeker, steps[snitch], false);
+            }
+        };
+
+        auto plusOne(std::uint8_t turns) -> std::uint8_t {
+            return turns == UNREACHABLE ? UNREACHABLE : static_cast<std::uint8_t>(turns + 1);
+        }
+
+        auto sign(int value) -> int {
+            return (value > 0) - (value < 0);
+        }
+
+        /**
+         * Catch distances to a snitch that does not move are the lengths of the shortest paths
+         */
+        void fillStationary(CatchTable &table, Cell snitch) {
+            std::deque<Cell> open{snitch};
+            table.at(snitch, snitch, false) = 0;
+            while (!open.empty()) {
+                auto cell = open.front();
+                open.pop_front();
+                for (auto neighbour : table.neighbours[cell]) {
+                    if (table.at(neighbour, snitch, false) == UNREACHABLE) {
+                        table.at(neighbour, snitch, false) = plusOne(table.at(cell, snitch, false));
+                        open.emplace_back(neighbour);
+                    }
+                }
+            }
+        }
+
+        /**
+         * The seeker either catches the snitch with its move or continues from its new cell against the snitch of the
+         * next round, which is always closer to the centre and therefore already computed
+         */
+        void fillMoving(CatchTable &table, Cell snitch) {
+            for (std::size_t seeker = 0; seeker < CELL_COUNT; seeker++) {
+                if (!table.onPitch[seeker]) {
+                    continue;
+                }
+
+                if (seeker == snitch) {
+                    table.at(seeker, snitch, false) = 0;
+                    continue;
+                }
+
+                auto best = table.remaining(static_cast<Cell>(seeker), snitch);
+                for (auto neighbour : table.neighbours[seeker]) {
+                    best = std::min(best, table.remaining(neighbour, snitch));
+                }
+
+                table.at(seeker, snitch, false) = plusOne(best);
+            }
+        }
+
+        auto catchTable() -> const CatchTable & {
+            static const auto instance = []() {
+                CatchTable ret;
+                ret.turns.assign(CELL_COUNT * CELL_COUNT * 2, UNREACHABLE);
+                for (std::size_t cell = 0; cell < CELL_COUNT; cell++) {
+                    ret.onPitch[cell] = gameModel::Environment::getCell(toPosition(static_cast<Cell>(cell))) !=
+                                        gameModel::Cell::OutOfBounds;
+                }
+
+                std::vector<Cell> snitchOrder;
+                for (std::size_t cell = 0; cell < CELL_COUNT; cell++) {
+                    if (!ret.onPitch[cell]) {
+                        continue;
+                    }
+
+                    auto position = toPosition(static_cast<Cell>(cell));
+                    for (int dx = -1; dx <= 1; dx++) {
+                        for (int dy = -1; dy <= 1; dy++) {
+                            auto neighbour = toCell({position.x + dx, position.y + dy});
+                            if ((dx != 0 || dy != 0) && neighbour != NO_CELL && ret.onPitch[neighbour]) {
+                                ret.neighbours[cell].emplace_back(neighbour);
+                            }
+                        }
+                    }
+
+                    auto step = toCell({position.x + sign(centre.x - position.x), position.y + sign(centre.y - position.y)});
+                    ret.steps[cell] = ret.onPitch[step] ? step : static_cast<Cell>(cell);
+                    snitchOrder.emplace_back(static_cast<Cell>(cell));
+                }
+
+                auto centreCell = toCell(centre);
+                std::stable_sort(snitchOrder.begin(), snitchOrder.end(), [centreCell](Cell a, Cell b) {
+                    return distance(a, centreCell) < distance(b, centreCell);
+                });
+
+                for (auto snitch : snitchOrder) {
+                    if (ret.steps[snitch] == snitch) {
+                        fillStationary(ret, snitch);
+                    } else {
+                        fillMoving(ret, snitch);
+                    }
+
+                    // A knocked out seeker loses its turn while the snitch keeps flying
+                    for (std::size_t seeker = 0; seeker < CELL_COUNT; seeker++) {
+                        if (ret.onPitch[seeker]) {
+                            ret.at(seeker, snitch, true) = seeker == snitch ? 0 :
+                                    plusOne(ret.remaining(static_cast<Cell>(seeker), snitch));
+                        }
+                    }
+                }
+
+                return ret;
+            }();
+
+            return instance;
+        }
+    }
+
+    auto snitchStep(Cell snitch) -> Cell {
+        if (snitch == NO_CELL || !catchTable().onPitch[snitch]) {
+            return snitch;
+        }
+
+        return catchTable().steps[snitch];
+    }
+
+    auto catchDistance(Cell seeker, Cell snitch, bool knockedOut) -> int {
+        if (seeker == snitch) {
+            return 0;
+        }
+
+        const auto &table = catchTable();
+        if (seeker == NO_CELL || snitch == NO_CELL || !table.onPitch[seeker] || !table.onPitch[snitch]) {
+            return distance(seeker, snitch);
+        }
+
+        return table.at(seeker, snitch, knockedOut);
+    }
+
+    auto catchStep(Cell seeker, Cell snitch, const CellSet &blocked) -> std::optional<Cell> {
+        const auto &table = catchTable();
+        if (seeker == NO_CELL || snitch == NO_CELL || !table.onPitch[seeker] || !table.onPitch[snitch]) {
+            return std::nullopt;
+        }
+
+        std::optional<Cell> ret;
+        auto best = table.remaining(seeker, snitch);
+        for (auto neighbour : table.neighbours[seeker]) {
+            if (neighbour == snitch) {
+                return neighbour;
+            }
+
+            if (!blocked.test(neighbour) && table.remaining(neighbour, snitch) < best) {
+                best = table.remaining(neighbour, snitch);
+                ret = neighbour;
+            }
+        }
+
+        return ret;
+    }
+
+    auto seekerDistance(Cell seeker, Cell snitch, bool knockedOut, gameController::ExcessLength overtimeState) -> int {
+        if (overtimeState == gameController::ExcessLength::Stage2 || overtimeState == gameController::ExcessLength::Stage3) {
+            return catchDistance(seeker, snitch, knockedOut);
+        }
+
+        return distance(seeker, snitch);
+    }
+}
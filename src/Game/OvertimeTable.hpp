@@ -0,0 +1,53 @@
+/**
+ * @file OvertimeTable.hpp
+ * @brief Declares the table of snitch catch distances for the overtime stages
+ */
+
+#ifndef KI_OVERTIMETABLE_HPP
+#define KI_OVERTIMETABLE_HPP
+
+#include <optional>
+#include <SopraGameLogic/GameController.h>
+#include "SearchState.hpp"
+
+namespace ai {
+    /**
+     * Cell the snitch flies to in the ball phase once overtime has reached Stage2: one step towards the centre of
+     * the pitch, the snitch stays at the centre
+     * @param snitch the cell of the snitch
+     * @return the cell of the snitch in the next round
+     */
+    auto snitchStep(Cell snitch) -> Cell;
+
+    /**
+     * Number of turns a seeker needs to catch a snitch that moves according to snitchStep, served from a table that
+     * is computed once for all seeker and snitch cells. Bludgers and other players are not part of the table.
+     * @param seeker cell of the seeker
+     * @param snitch cell of the snitch
+     * @param knockedOut whether the seeker misses its next turn
+     * @return 0 if the seeker is on the snitch, the number of turns until it can move onto the snitch otherwise.
+     * Cells outside of the pitch fall back to distance.
+     */
+    auto catchDistance(Cell seeker, Cell snitch, bool knockedOut) -> int;
+
+    /**
+     * Best move of a seeker chasing a snitch that moves according to snitchStep
+     * @param seeker cell of the seeker
+     * @param snitch cell of the snitch
+     * @param blocked cells the seeker must not move to, the snitch cell is never blocked
+     * @return the neighbouring cell with the smallest catchDistance or nothing if staying is at least as good
+     */
+    auto catchStep(Cell seeker, Cell snitch, const CellSet &blocked) -> std::optional<Cell>;
+
+    /**
+     * Distance between a seeker and the snitch as used by the evaluation: catchDistance in the overtime stages in
+     * which the snitch converges on the centre, distance otherwise
+     * @param seeker cell of the seeker
+     * @param snitch cell of the snitch
+     * @param knockedOut whether the seeker is knocked out
+     * @param overtimeState the overtime stage of the game
+     */
+    auto seekerDistance(Cell seeker, Cell snitch, bool knockedOut, gameController::ExcessLength overtimeState) -> int;
+}
+
+#endif //KI_OVERTIMETABLE_HPP
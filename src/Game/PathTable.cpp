@@ -0,0 +1,157 @@
+/**
+ * @file PathTable.cpp
+ * @brief Implements the table of shortest paths between all cells of the pitch
+ */
+
+#include "PathTable.hpp"
+
+namespace ai {
+    namespace {
+        /**
+         * Neighbours of every cell that are on the pitch
+         */
+        auto neighbours() -> const std::array<std::vector<Cell>, CELL_COUNT> & {
+            static const auto instance = []() {
+                std::array<std::vector<Cell>, CELL_COUNT> ret;
+                for (std::size_t cell = 0; cell < CELL_COUNT; cell++) {
+                    auto position = toPosition(static_cast<Cell>(cell));
+                    if (gameModel::Environment::getCell(position) == gameModel::Cell::OutOfBounds) {
+                        continue;
+                    }
+
+                    for (int dx = -1; dx <= 1; dx++) {
+                        for (int dy = -1; dy <= 1; dy++) {
+                            gameModel::Position neighbour{position.x + dx, position.y + dy};
+                            if ((dx != 0 || dy != 0) && toCell(neighbour) != NO_CELL &&
+                                gameModel::Environment::getCell(neighbour) != gameModel::Cell::OutOfBounds) {
+                                ret[cell].emplace_back(toCell(neighbour));
+                            }
+                        }
+                    }
+                }
+
+                return ret;
+            }();
+
+            return instance;
+        }
+    }
+
+    PathTable::PathTable(const CellSet &obstacles) : obstacles(obstacles) {
+        compute();
+    }
+
+    bool PathTable::update(const CellSet &newObstacles) {
+        if (newObstacles.bits == obstacles.bits) {
+            return false;
+        }
+
+        obstacles = newObstacles;
+        compute();
+        return true;
+    }
+
+    auto PathTable::distance(Cell from, Cell to) const -> int {
+        if (from >= CELL_COUNT || to >= CELL_COUNT) {
+            return UNREACHABLE;
+        }
+
+        return distances[to * CELL_COUNT + from];
+    }
+
+    auto PathTable::nextStep(Cell from, Cell to, const CellSet &blocked) const -> std::optional<Cell> {
+        auto length = distance(from, to);
+        if (length == UNREACHABLE || length == 0) {
+            return std::nullopt;
+        }
+
+        for (auto neighbour : neighbours()[from]) {
+            if (distance(neighbour, to) == length - 1 && (neighbour == to || !blocked.test(neighbour))) {
+                return neighbour;
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    auto PathTable::path(Cell from, Cell to) const -> std::vector<gameModel::Position> {
+        std::vector<gameModel::Position> ret;
+        if (distance(from, to) == UNREACHABLE) {
+            return ret;
+        }
+
+        for (auto cell = std::optional<Cell>{from}; cell.has_value(); cell = nextStep(*cell, to)) {
+            ret.emplace_back(toPosition(*cell));
+        }
+
+        return {ret.rbegin(), ret.rend()};
+    }
+
+    auto PathTable::obstaclesOf(const gameModel::Environment &env) -> CellSet {
+        CellSet ret{};
+        for (const auto &cube : env.pileOfShit) {
+            if (auto cell = toCell(cube->position); cell != NO_CELL) {
+                ret.set(cell);
+            }
+        }
+
+        return ret;
+    }
+
+    auto PathTable::shortestDistance(Cell from, Cell to, const CellSet &obstacles) -> int {
+        if (from >= CELL_COUNT || to >= CELL_COUNT || neighbours()[from].empty() || neighbours()[to].empty() ||
+            obstacles.test(from) || obstacles.test(to)) {
+            return UNREACHABLE;
+        }
+
+        std::array<std::uint8_t, CELL_COUNT> lengths;
+        lengths.fill(UNREACHABLE);
+        lengths[from] = 0;
+        std::array<Cell, CELL_COUNT> open;
+        std::size_t head = 0;
+        std::size_t tail = 0;
+        open[tail++] = from;
+        while (head < tail) {
+            auto cell = open[head++];
+            if (cell == to) {
+                return lengths[cell];
+            }
+
+            for (auto neighbour : neighbours()[cell]) {
+                if (lengths[neighbour] == UNREACHABLE && !obstacles.test(neighbour)) {
+                    lengths[neighbour] = static_cast<std::uint8_t>(lengths[cell] + 1);
+                    open[tail++] = neighbour;
+                }
+            }
+        }
+
+        return UNREACHABLE;
+    }
+
+    void PathTable::compute() {
+        // One breadth first search per target, moves are symmetric so distances[to][from] is the distance from -> to.
+        // Every cell is queued at most once, so a fixed array serves as the queue.
+        distances.assign(CELL_COUNT * CELL_COUNT, UNREACHABLE);
+        std::array<Cell, CELL_COUNT> open;
+        for (std::size_t to = 0; to < CELL_COUNT; to++) {
+            if (neighbours()[to].empty() || obstacles.test(static_cast<Cell>(to))) {
+                continue;
+            }
+
+            auto *row = &distances[to * CELL_COUNT];
+            row[to] = 0;
+            std::size_t head = 0;
+            std::size_t tail = 0;
+            open[tail++] = static_cast<Cell>(to);
+            while (head < tail) {
+                auto cell = open[head++];
+                for (auto neighbour : neighbours()[cell]) {
+                    if (row[neighbour] == UNREACHABLE && !obstacles.test(neighbour)) {
+                        row[neighbour] = static_cast<std::uint8_t>(row[cell] + 1);
+                        open[tail++] = neighbour;
+                    }
+                }
+            }
+        }
+    }
+}
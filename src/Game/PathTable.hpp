@@ -0,0 +1,86 @@
+/**
+ * @file PathTable.hpp
+ * @brief Declares the table of shortest paths between all cells of the pitch
+ */
+
+#ifndef KI_PATHTABLE_HPP
+#define KI_PATHTABLE_HPP
+
+#include <optional>
+#include <vector>
+#include "SearchState.hpp"
+
+namespace ai {
+    /**
+     * Lengths and first steps of the shortest paths between all pairs of cells for a player moving one cell per
+     * move. Cells outside of the pitch and obstacles (wombat cubes) can't be entered. The table is recomputed
+     * only when the obstacles change, every query is a lookup.
+     */
+    class PathTable {
+    public:
+        static constexpr int UNREACHABLE = 0xFF;
+
+        /**
+         * CTor
+         * @param obstacles cells that can't be entered
+         */
+        explicit PathTable(const CellSet &obstacles = {});
+
+        /**
+         * Recomputes the table if the obstacles changed
+         * @param obstacles cells that can't be entered
+         * @return true if the table was recomputed
+         */
+        bool update(const CellSet &obstacles);
+
+        /**
+         * Number of moves on the shortest path
+         * @param from start cell
+         * @param to target cell
+         * @return the number of moves or UNREACHABLE if there is no path
+         */
+        auto distance(Cell from, Cell to) const -> int;
+
+        /**
+         * First cell on a shortest path
+         * @param from start cell
+         * @param to target cell, never blocked
+         * @param blocked cells that may not be entered in this move, for example because a player stands there
+         * @return the first free cell on a shortest path or nothing if there is none
+         */
+        auto nextStep(Cell from, Cell to, const CellSet &blocked = {}) const -> std::optional<Cell>;
+
+        /**
+         * Shortest path in the layout of aiTools::computeOptimalPath: the target first and the start last
+         * @param from start cell
+         * @param to target cell
+         * @return all cells of the path or nothing if there is no path
+         */
+        auto path(Cell from, Cell to) const -> std::vector<gameModel::Position>;
+
+        /**
+         * Cells occupied by wombat cubes
+         * @param env the environment
+         */
+        static auto obstaclesOf(const gameModel::Environment &env) -> CellSet;
+
+        /**
+         * Number of moves on the shortest path without a table. Runs a single breadth first search that stops at the
+         * target, which is cheap for nearby cells and does not allocate. Used where the obstacles differ from call
+         * to call, like in the evaluation of search states.
+         * @param from start cell
+         * @param to target cell
+         * @param obstacles cells that can't be entered
+         * @return the number of moves or UNREACHABLE if there is no path
+         */
+        static auto shortestDistance(Cell from, Cell to, const CellSet &obstacles) -> int;
+
+    private:
+        CellSet obstacles;
+        std::vector<std::uint8_t> distances;
+
+        void compute();
+    };
+}
+
+#endif //KI_PATHTABLE_HPP
@@ -0,0 +1,530 @@
+/**
+ * @file Search.cpp
+ * @brief Implements the alpha-beta search operating on SearchStates
+ */
+
+#include "Search.hpp"
+#include "AI.h"
+#include "Zobrist.hpp"
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <numeric>
+#include <thread>
+#include <SopraGameLogic/conversions.h>
+
+namespace ai {
+    constexpr auto INF = std::numeric_limits<double>::infinity();
+
+    void SearchStats::add(const SearchStats &other) {
+        children += other.children;
+        cutoffs += other.cutoffs;
+        chanceCutoffs += other.chanceCutoffs;
+        playouts += other.playouts;
+        evals += other.evals;
+        tableProbes += other.tableProbes;
+        tableHits += other.tableHits;
+    }
+
+    auto takePonderResult(std::optional<PonderResult> &ponderResult, const SearchState &root,
+                          const aiTools::ActionState &actionState) -> std::optional<SearchResult> {
+        std::optional<SearchResult> ret;
+        if (ponderResult.has_value() && ponderResult->key == nodeKey(root, actionState)) {
+            ret = std::move(ponderResult->result);
+        }
+
+        ponderResult.reset();
+        return ret;
+    }
+
+    Search::Search(const SearchContext &context, gameModel::TeamSide mySide, TranspositionTable &table,
+                   unsigned int threads, bool collectPrincipalVariation, bool orderMoves) :
+            context(context), mySide(mySide), table(table), threads(std::max(threads, 1u)),
+            collectPrincipalVariation(collectPrincipalVariation), orderMoves(orderMoves) {}
+
+    void Search::setLeafEval(LeafEval eval) {
+        leafEval = eval;
+    }
+
+    void Search::setChancePruning(ChancePruning pruning, EvalBounds bounds) {
+        chancePruning = pruning;
+        evalBounds = bounds;
+    }
+
+    void Search::setHelperCallback(IterationCallback callback) {
+        helperCallback = std::move(callback);
+    }
+
+    auto Search::computeBestAction(const SearchState &root, const aiTools::ActionState &actionState,
+                                   const std::atomic_bool &abort, unsigned int minDepth, unsigned int maxDepth,
+                                   const IterationCallback &keepSearching) -> SearchResult {
+        table.newSearch();
+        auto successors = expand(root, context, actionState);
+        if (successors.empty()) {
+            throw std::runtime_error("No action possible");
+        }
+
+        // Lazy SMP: helpers search the same tree with a different root order and depth, sharing their results
+        // through the transposition table. They are stopped as soon as the main search returns.
+        std::atomic_bool stopHelpers = false;
+        std::vector<SearchResult> helperResults(threads - 1);
+        std::vector<std::thread> helpers;
+        helpers.reserve(threads - 1);
+        for (unsigned int i = 1; i < threads; i++) {
+            helpers.emplace_back([this, &root, successors, &stopHelpers, &helperResults, i, minDepth, maxDepth]() mutable {
+                std::rotate(successors.begin(), successors.begin() + i % successors.size(), successors.end());
+                Search helper(context, mySide, table, 1, false, orderMoves);
+                helper.setLeafEval(leafEval);
+                helper.setChancePruning(chancePruning, evalBounds);
+                helperResults[i - 1] = helper.iterativeDeepening(root, std::move(successors), stopHelpers,
+                        minDepth + 1 + i % 2, maxDepth, false, helperCallback);
+            });
+        }
+
+        auto rootChildren = successors.size();
+        auto result = iterativeDeepening(root, std::move(successors), abort, minDepth, maxDepth, true, keepSearching);
+        stopHelpers = true;
+        for (auto &helper : helpers) {
+            helper.join();
+        }
+
+        auto totalExpansions = result.expansions;
+        auto totalStats = result.stats;
+        totalStats.children += rootChildren;
+        for (const auto &helperResult : helperResults) {
+            totalExpansions += helperResult.expansions;
+            totalStats.add(helperResult.stats);
+            if (helperResult.depth > result.depth) {
+                result = helperResult;
+            }
+        }
+
+        result.expansions = totalExpansions + 1;
+        result.stats = std::move(totalStats);
+        return result;
+    }
+
+    auto Search::ponder(const SearchState &root, const aiTools::ActionState &actionState, const std::atomic_bool &stop,
+                        unsigned int minDepth, unsigned int maxDepth, const IterationCallback &keepSearching)
+                        -> std::optional<PonderResult> {
+        table.newSearch();
+        expansions = 0;
+        ordering.newSearch();
+        const IncrementalEval rootEval(root, context, mySide);
+        alphaBeta(root, rootEval, actionState, minDepth, 0, -INF, INF, stop);
+        auto entry = table.probe(nodeKey(root, actionState));
+        if (stop || !entry.has_value()) {
+            return std::nullopt;
+        }
+
+        auto successors = expand(root, context, actionState);
+        if (entry->bestMove >= successors.size()) {
+            return std::nullopt;
+        }
+
+        const auto &outcomes = successors[entry->bestMove].outcomes;
+        auto predicted = std::max_element(outcomes.begin(), outcomes.end(), [](const Outcome &a, const Outcome &b) {
+            return a.probability < b.probability;
+        });
+        if (predicted == outcomes.end() || !predicted->next.has_value() || !isMyTurn(*predicted->next)) {
+            return std::nullopt;
+        }
+
+        auto replies = expand(predicted->state, context, *predicted->next);
+        if (replies.empty()) {
+            return std::nullopt;
+        }
+
+        auto result = iterativeDeepening(predicted->state, std::move(replies), stop, minDepth, maxDepth, false,
+                                         keepSearching);
+        if (result.depth == 0) {
+            return std::nullopt;
+        }
+
+        return PonderResult{nodeKey(predicted->state, *predicted->next), result};
+    }
+
+    auto Search::iterativeDeepening(const SearchState &root, Successors successors,
+                                    const std::atomic_bool &abort, unsigned int minDepth, unsigned int maxDepth,
+                                    bool completeFirst, const IterationCallback &keepSearching) -> SearchResult {
+        const std::atomic_bool noAbort = false;
+        const IncrementalEval rootEval(root, context, mySide);
+        expansions = 0;
+        stats = {};
+        ordering.newSearch();
+        SearchResult result{successors.front().action, 0, 0, -INF, {}, {}};
+        for (auto depth = minDepth; depth <= maxDepth; depth++) {
+            const auto &iterationAbort = depth == minDepth && completeFirst ? noAbort : abort;
+            auto iterationStart = std::chrono::steady_clock::now();
+            auto iterationExpansions = expansions;
+            std::size_t best = 0;
+            double alpha = -INF;
+            for (std::size_t i = 0; i < successors.size(); i++) {
+                auto value = successorValue(successors[i], root, rootEval, depth, 0, alpha, INF, iterationAbort);
+                if (iterationAbort) {
+                    break;
+                }
+
+                if (value > alpha) {
+                    alpha = value;
+                    best = i;
+                }
+            }
+
+            if (iterationAbort) {
+                break;
+            }
+
+            result.action = successors[best].action;
+            result.depth = depth;
+            result.score = alpha;
+            std::chrono::duration<double, std::milli> iterationTime = std::chrono::steady_clock::now() - iterationStart;
+            stats.iterations.push_back({depth, expansions - iterationExpansions, iterationTime.count()});
+            if (collectPrincipalVariation || keepSearching) {
+                auto line = principalLine(successors[best], depth);
+                result.endsGame = line.endsGame;
+                if (collectPrincipalVariation) {
+                    result.principalVariation = std::move(line.actions);
+                }
+            }
+
+            // The next iteration starts with the best action of this one
+            std::swap(successors.front(), successors[best]);
+            if (keepSearching && !keepSearching(result)) {
+                break;
+            }
+        }
+
+        result.expansions = expansions;
+        result.stats = stats;
+        return result;
+    }
+
+    auto Search::alphaBeta(const SearchState &state, const IncrementalEval &eval,
+                           const aiTools::ActionState &actionState, unsigned int depth, unsigned int ply,
+                           double alpha, double beta, const std::atomic_bool &abort) -> double {
+        if (depth == 0 || abort) {
+            return leafValue(state, eval);
+        }
+
+        auto key = nodeKey(state, actionState);
+        auto entry = table.probe(key);
+        stats.tableProbes++;
+        if (entry.has_value()) {
+            stats.tableHits++;
+        }
+
+        if (entry.has_value() && entry->depth >= depth) {
+            switch (entry->bound) {
+                case TranspositionTable::Bound::Exact:
+                    return entry->score;
+                case TranspositionTable::Bound::Lower:
+                    alpha = std::max(alpha, entry->score);
+                    break;
+                case TranspositionTable::Bound::Upper:
+                    beta = std::min(beta, entry->score);
+                    break;
+            }
+
+            if (alpha >= beta) {
+                return entry->score;
+            }
+        }
+
+        Arena::Scope scope(arena);
+        auto successors = expand(state, context, actionState, &arena);
+        expansions++;
+        stats.children += successors.size();
+        if (successors.empty()) {
+            return leafValue(state, eval);
+        }
+
+        // Try the best move of a previous search first, then killers, tactical moves and history
+        std::optional<std::size_t> tableMove;
+        if (entry.has_value() && entry->bestMove < successors.size()) {
+            tableMove = entry->bestMove;
+        }
+
+        auto order = moveOrder(state, successors, tableMove, ply);
+        const auto alphaOrig = alpha;
+        const auto betaOrig = beta;
+        bool maximize = isMyTurn(actionState);
+        double best = maximize ? -INF : INF;
+        std::size_t bestIndex = order.front();
+        for (std::size_t i = 0; i < order.size(); i++) {
+            const auto &successor = successors[order[i]];
+            auto value = successorValue(successor, state, eval, depth, ply, alpha, beta, abort);
+            if (maximize ? value > best : value < best) {
+                best = value;
+                bestIndex = order[i];
+            }
+
+            if (maximize) {
+                alpha = std::max(alpha, best);
+            } else {
+                beta = std::min(beta, best);
+            }
+
+            if (alpha >= beta) {
+                if (i + 1 < order.size()) {
+                    stats.cutoffs++;
+                }
+
+                if (orderMoves && !abort) {
+                    ordering.onCutoff(state, successor, ply, depth);
+                }
+
+                break;
+            }
+        }
+
+        if (!abort) {
+            auto bound = TranspositionTable::Bound::Exact;
+            if (best <= alphaOrig) {
+                bound = TranspositionTable::Bound::Upper;
+            } else if (best >= betaOrig) {
+                bound = TranspositionTable::Bound::Lower;
+            }
+
+            table.store(key, {best, depth, bound, static_cast<std::uint16_t>(bestIndex)});
+        }
+
+        return best;
+    }
+
+    auto Search::moveOrder(const SearchState &state, const Successors &successors,
+                           std::optional<std::size_t> tableMove, unsigned int ply) -> ArenaVector<std::size_t> {
+        if (orderMoves) {
+            return ordering.order(state, successors, tableMove, ply, &arena);
+        }
+
+        ArenaVector<std::size_t> order(successors.size(), ArenaAllocator<std::size_t>{&arena});
+        std::iota(order.begin(), order.end(), 0);
+        if (tableMove.has_value()) {
+            std::rotate(order.begin(), order.begin() + *tableMove, order.begin() + *tableMove + 1);
+        }
+
+        return order;
+    }
+
+    auto Search::successorValue(const Successor &successor, const SearchState &parent,
+                                const IncrementalEval &parentEval, unsigned int depth, unsigned int ply, double alpha,
+                                double beta, const std::atomic_bool &abort) -> double {
+        if (successor.outcomes.size() == 1) {
+            return outcomeValue(successor.outcomes.front(), parent, parentEval, depth - 1, ply + 1, alpha, beta,
+                                abort);
+        }
+
+        if (chancePruning != ChancePruning::None) {
+            return chanceValue(successor, parent, parentEval, depth, ply, alpha, beta, abort);
+        }
+
+        // The window only holds for deterministic actions, chance outcomes are searched with a full window
+        double value = 0;
+        for (const auto &outcome : successor.outcomes) {
+            value += outcome.probability *
+                     outcomeValue(outcome, parent, parentEval, depth - 1, ply + 1, -INF, INF, abort);
+        }
+
+        return value;
+    }
+
+    auto Search::outcomeValue(const Outcome &outcome, const SearchState &parent, const IncrementalEval &parentEval,
+                              unsigned int depth, unsigned int ply, double alpha, double beta,
+                              const std::atomic_bool &abort) -> double {
+        auto eval = parentEval;
+        eval.update(parent, outcome.state);
+        if (!outcome.next.has_value()) {
+            return leafValue(outcome.state, eval);
+        }
+
+        return alphaBeta(outcome.state, eval, *outcome.next, depth, ply, alpha, beta, abort);
+    }
+
+    auto Search::chanceValue(const Successor &successor, const SearchState &parent, const IncrementalEval &parentEval,
+                             unsigned int depth, unsigned int ply, double alpha, double beta,
+                             const std::atomic_bool &abort) -> double {
+        // Every outcome lies within [lower, upper], initially the bounds of the evaluation
+        Arena::Scope scope(arena);
+        const auto &outcomes = successor.outcomes;
+        ArenaVector<EvalBounds> bounds(outcomes.size(), evalBounds, ArenaAllocator<EvalBounds>{&arena});
+        auto expectation = [&outcomes, &bounds](double EvalBounds::*bound) {
+            double ret = 0;
+            for (std::size_t i = 0; i < outcomes.size(); i++) {
+                ret += outcomes[i].probability * bounds[i].*bound;
+            }
+
+            return ret;
+        };
+
+        // Star2: a single successor of every outcome bounds it from the side of the player to move
+        if (chancePruning == ChancePruning::Star2) {
+            for (std::size_t i = 0; i < outcomes.size() && !abort; i++) {
+                bounds[i] = probeOutcome(outcomes[i], parent, parentEval, depth - 1, ply + 1, abort);
+                if (auto lower = expectation(&EvalBounds::lower); lower >= beta) {
+                    stats.chanceCutoffs++;
+                    return lower;
+                }
+
+                if (auto upper = expectation(&EvalBounds::upper); upper <= alpha) {
+                    stats.chanceCutoffs++;
+                    return upper;
+                }
+            }
+        }
+
+        // Star1: an outcome is searched with the window in which it still decides whether the expectation is inside
+        // (alpha, beta), the outcomes after it are assumed to be at their bounds
+        double sum = 0;
+        auto lowerRest = expectation(&EvalBounds::lower);
+        auto upperRest = expectation(&EvalBounds::upper);
+        for (std::size_t i = 0; i < outcomes.size(); i++) {
+            const auto probability = outcomes[i].probability;
+            lowerRest -= probability * bounds[i].lower;
+            upperRest -= probability * bounds[i].upper;
+            if (probability <= 0) {
+                continue;
+            }
+
+            auto outcomeAlpha = (alpha - sum - upperRest) / probability;
+            auto outcomeBeta = (beta - sum - lowerRest) / probability;
+            if (outcomeAlpha >= bounds[i].upper) {
+                stats.chanceCutoffs++;
+                return sum + probability * bounds[i].upper + upperRest;
+            }
+
+            if (outcomeBeta <= bounds[i].lower) {
+                stats.chanceCutoffs++;
+                return sum + probability * bounds[i].lower + lowerRest;
+            }
+
+            auto value = outcomeValue(outcomes[i], parent, parentEval, depth - 1, ply + 1,
+                                      std::max(outcomeAlpha, bounds[i].lower), std::min(outcomeBeta, bounds[i].upper),
+                                      abort);
+            if (value <= outcomeAlpha) {
+                if (i + 1 < outcomes.size()) {
+                    stats.chanceCutoffs++;
+                }
+
+                return sum + probability * value + upperRest;
+            }
+
+            if (value >= outcomeBeta) {
+                if (i + 1 < outcomes.size()) {
+                    stats.chanceCutoffs++;
+                }
+
+                return sum + probability * value + lowerRest;
+            }
+
+            sum += probability * value;
+        }
+
+        return sum;
+    }
+
+    auto Search::probeOutcome(const Outcome &outcome, const SearchState &parent, const IncrementalEval &parentEval,
+                              unsigned int depth, unsigned int ply, const std::atomic_bool &abort) -> EvalBounds {
+        auto eval = parentEval;
+        eval.update(parent, outcome.state);
+        if (!outcome.next.has_value() || depth == 0) {
+            auto value = leafValue(outcome.state, eval);
+            return {value, value};
+        }
+
+        auto entry = table.probe(nodeKey(outcome.state, *outcome.next));
+        stats.tableProbes++;
+        if (entry.has_value()) {
+            stats.tableHits++;
+            if (entry->depth >= depth) {
+                switch (entry->bound) {
+                    case TranspositionTable::Bound::Exact:
+                        return {entry->score, entry->score};
+                    case TranspositionTable::Bound::Lower:
+                        return {entry->score, evalBounds.upper};
+                    case TranspositionTable::Bound::Upper:
+                        return {evalBounds.lower, entry->score};
+                }
+            }
+        }
+
+        Arena::Scope scope(arena);
+        auto successors = expand(outcome.state, context, *outcome.next, &arena);
+        expansions++;
+        stats.children += successors.size();
+        if (successors.empty()) {
+            auto value = leafValue(outcome.state, eval);
+            return {value, value};
+        }
+
+        std::optional<std::size_t> tableMove;
+        if (entry.has_value() && entry->bestMove < successors.size()) {
+            tableMove = entry->bestMove;
+        }
+
+        // The value of one successor is a lower bound for the player maximizing and an upper bound for the other one
+        const auto &first = successors[moveOrder(outcome.state, successors, tableMove, ply).front()];
+        auto value = successorValue(first, outcome.state, eval, depth, ply, evalBounds.lower, evalBounds.upper, abort);
+        if (abort) {
+            return evalBounds;
+        }
+
+        if (isMyTurn(*outcome.next)) {
+            return {value, evalBounds.upper};
+        }
+
+        return {evalBounds.lower, value};
+    }
+
+    auto Search::leafValue(const SearchState &state, const IncrementalEval &eval) -> double {
+        stats.evals++;
+        auto value = leafEval == nullptr ? eval.cachedValue(state) : leafEval(state, context, mySide);
+        if (chancePruning == ChancePruning::None) {
+            return value;
+        }
+
+        return std::clamp(value, evalBounds.lower, evalBounds.upper);
+    }
+
+    auto Search::principalLine(Successor first, unsigned int depth) const -> PrincipalLine {
+        // Follows the best moves stored in the table along the most likely outcome of every action, an outcome
+        // without a next turn ends the match
+        PrincipalLine ret{{first.action}, false};
+        auto current = std::move(first);
+        while (true) {
+            auto outcome = std::max_element(current.outcomes.begin(), current.outcomes.end(),
+                    [](const Outcome &a, const Outcome &b) { return a.probability < b.probability; });
+            if (outcome == current.outcomes.end()) {
+                break;
+            }
+
+            if (!outcome->next.has_value()) {
+                ret.endsGame = true;
+                break;
+            }
+
+            if (ret.actions.size() >= depth) {
+                break;
+            }
+
+            auto entry = table.probe(nodeKey(outcome->state, *outcome->next));
+            if (!entry.has_value()) {
+                break;
+            }
+
+            auto successors = expand(outcome->state, context, *outcome->next);
+            if (entry->bestMove >= successors.size()) {
+                break;
+            }
+
+            current = std::move(successors[entry->bestMove]);
+            ret.actions.emplace_back(current.action);
+        }
+
+        return ret;
+    }
+
+    bool Search::isMyTurn(const aiTools::ActionState &actionState) const {
+        return gameLogic::conversions::idToSide(actionState.id) == mySide;
+    }
+}
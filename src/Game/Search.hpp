@@ -0,0 +1,301 @@
+/**
+ * @file Search.hpp
+ * @brief Declares the alpha-beta search operating on SearchStates
+ */
+
+#ifndef KI_SEARCH_HPP
+#define KI_SEARCH_HPP
+
+#include <atomic>
+#include <functional>
+#include "SearchState.hpp"
+#include "IncrementalEval.hpp"
+#include "MoveOrdering.hpp"
+#include "TranspositionTable.hpp"
+
+namespace ai {
+    /**
+     * Statistics of a single iteration of iterative deepening
+     */
+    struct IterationStats {
+        unsigned int depth;
+        unsigned long expansions;
+        double milliseconds;
+    };
+
+    /**
+     * Counters collected during a search
+     */
+    struct SearchStats {
+        /**
+         * Completed iterations of the main thread
+         */
+        std::vector<IterationStats> iterations;
+
+        /**
+         * Number of successors of all expanded nodes
+         */
+        unsigned long children = 0;
+
+        /**
+         * Number of expanded nodes where not all successors were searched
+         */
+        unsigned long cutoffs = 0;
+
+        /**
+         * Number of chance nodes where not all outcomes were searched completely
+         */
+        unsigned long chanceCutoffs = 0;
+
+        /**
+         * Number of Monte Carlo playouts, only counted by Mcts
+         */
+        unsigned long playouts = 0;
+
+        /**
+         * Number of evaluated leaves
+         */
+        unsigned long evals = 0;
+
+        /**
+         * Number of lookups in the transposition table
+         */
+        unsigned long tableProbes = 0;
+
+        /**
+         * Number of lookups that found an entry, whether or not it was deep enough to be used
+         */
+        unsigned long tableHits = 0;
+
+        /**
+         * Adds the counters (not the iterations) of another search
+         * @param other statistics of another thread
+         */
+        void add(const SearchStats &other);
+    };
+
+    /**
+     * Result of a search, the first members have the same layout as the tuple returned by
+     * aiTools::computeBestActionAlphaBetaID
+     */
+    struct SearchResult {
+        communication::messages::request::DeltaRequest action;
+        unsigned int depth;
+        unsigned long expansions;
+        double score;
+        SearchStats stats;
+
+        /**
+         * Expected line of play starting with action, only collected if requested
+         */
+        std::vector<communication::messages::request::DeltaRequest> principalVariation;
+
+        /**
+         * Whether the match ends on the principal variation, e.g. because the snitch is caught. Only determined if
+         * the principal variation is collected or an IterationCallback is given.
+         */
+        bool endsGame = false;
+    };
+
+    using IterationCallback = std::function<bool(const SearchResult &)>;
+
+    /**
+     * Evaluation of the leaves of a search, for example ai::evalState
+     */
+    using LeafEval = double (*)(const SearchState &, const SearchContext &, gameModel::TeamSide);
+
+    /**
+     * Pruning of chance nodes, the actions with more than one outcome
+     */
+    enum class ChancePruning {
+        /**
+         * Every outcome is searched with a full window
+         */
+        None,
+
+        /**
+         * The window of every outcome is derived from the values of the outcomes searched before and the bounds of
+         * the evaluation for the outcomes not searched yet
+         */
+        Star1,
+
+        /**
+         * Star1 after probing a single successor of every outcome, which bounds the outcomes more tightly than the
+         * evaluation bounds
+         */
+        Star2
+    };
+
+    /**
+     * Range of the leaf evaluation, leaf values outside of it are clamped if chance nodes are pruned
+     */
+    struct EvalBounds {
+        double lower;
+        double upper;
+    };
+
+    /**
+     * Bounds of simpleEval, only disqualifications and very large score differences are clamped
+     */
+    constexpr EvalBounds SIMPLE_EVAL_BOUNDS{-1000, 1000};
+
+    /**
+     * Result of pondering, an action prepared for the turn that is expected to follow the opponent's turn
+     */
+    struct PonderResult {
+        /**
+         * nodeKey of the predicted state and turn
+         */
+        std::uint64_t key;
+        SearchResult result;
+    };
+
+    /**
+     * Takes the result of pondering if it was prepared for the given turn. The result is discarded either way, it
+     * only belongs to a single turn.
+     * @param ponderResult result of pondering, if any
+     * @param root the current state
+     * @param actionState the turn to compute an action for
+     * @return the prepared result or nothing if the state or the turn was not predicted
+     */
+    auto takePonderResult(std::optional<PonderResult> &ponderResult, const SearchState &root,
+                          const aiTools::ActionState &actionState) -> std::optional<SearchResult>;
+
+    /**
+     * Iterative deepening alpha-beta search. Nodes are stored as SearchStates and evaluated with an
+     * IncrementalEval that is carried from parent to child, only the expansion of a node converts it to a full
+     * aiTools::State. Results are shared between iterations and turns via a transposition table. With more than one
+     * thread the additional threads run a Lazy SMP search on the same table.
+     */
+    class Search {
+    public:
+        /**
+         * CTor
+         * @param context match constants used for expansion and evaluation
+         * @param mySide the side the KI is playing
+         * @param table transposition table used for the search
+         * @param threads number of threads searching in parallel
+         * @param collectPrincipalVariation whether to extract the principal variation after every iteration
+         * @param orderMoves whether to order moves by killer moves, history and tactical score, the move stored in
+         * the transposition table is always searched first
+         */
+        Search(const SearchContext &context, gameModel::TeamSide mySide, TranspositionTable &table,
+               unsigned int threads = 1, bool collectPrincipalVariation = false, bool orderMoves = true);
+
+        /**
+         * Replaces the incrementally updated simpleEval at the leaves, which is served from the EvalCache of the
+         * searching thread
+         * @param eval the evaluation function, nullptr restores simpleEval
+         */
+        void setLeafEval(LeafEval eval);
+
+        /**
+         * Turns the search into an expectimax search that prunes chance nodes
+         * @param pruning the pruning of chance nodes
+         * @param bounds range of the leaf evaluation
+         */
+        void setChancePruning(ChancePruning pruning, EvalBounds bounds = SIMPLE_EVAL_BOUNDS);
+
+        /**
+         * Observes the Lazy SMP helpers
+         * @param callback called on a helper thread after each completed iteration of that helper, the helper stops
+         * if it returns false
+         */
+        void setHelperCallback(IterationCallback callback);
+
+        /**
+         * Computes the best action for the given turn
+         * @param root the current state
+         * @param actionState the turn to compute an action for
+         * @param abort flag that stops the search, the minimum depth is always searched completely
+         * @param minDepth depth of the first iteration
+         * @param maxDepth depth of the last iteration
+         * @param keepSearching called with the result of every completed iteration of the main thread, no further
+         * iteration is started if it returns false
+         * @return the best action of the deepest iteration completed by any thread
+         * @throws std::runtime_error if there is no possible action
+         */
+        auto computeBestAction(const SearchState &root, const aiTools::ActionState &actionState,
+                               const std::atomic_bool &abort, unsigned int minDepth, unsigned int maxDepth,
+                               const IterationCallback &keepSearching = {}) -> SearchResult;
+
+        /**
+         * Searches on the opponent's time. Predicts the opponent's action for the given turn and searches the reply
+         * to its most likely outcome until stopped. All results are kept in the transposition table.
+         * @param root the current state
+         * @param actionState the opponent's turn
+         * @param stop flag that stops pondering
+         * @param minDepth depth used to predict the opponent's action and of the first iteration of the reply
+         * @param maxDepth depth of the last iteration of the reply
+         * @param keepSearching called with the result of every completed iteration of the reply, no further iteration
+         * is started if it returns false
+         * @return the reply for the predicted state if the prediction is a turn of the KI and at least one iteration
+         * completed, nothing otherwise
+         */
+        auto ponder(const SearchState &root, const aiTools::ActionState &actionState, const std::atomic_bool &stop,
+                    unsigned int minDepth, unsigned int maxDepth, const IterationCallback &keepSearching = {})
+            -> std::optional<PonderResult>;
+
+    private:
+        auto iterativeDeepening(const SearchState &root, Successors successors,
+                                const std::atomic_bool &abort, unsigned int minDepth, unsigned int maxDepth,
+                                bool completeFirst, const IterationCallback &keepSearching = {}) -> SearchResult;
+
+        auto alphaBeta(const SearchState &state, const IncrementalEval &eval, const aiTools::ActionState &actionState,
+                       unsigned int depth, unsigned int ply, double alpha, double beta,
+                       const std::atomic_bool &abort) -> double;
+
+        auto moveOrder(const SearchState &state, const Successors &successors, std::optional<std::size_t> tableMove,
+                       unsigned int ply) -> ArenaVector<std::size_t>;
+
+        auto successorValue(const Successor &successor, const SearchState &parent, const IncrementalEval &parentEval,
+                            unsigned int depth, unsigned int ply, double alpha, double beta,
+                            const std::atomic_bool &abort) -> double;
+
+        auto outcomeValue(const Outcome &outcome, const SearchState &parent, const IncrementalEval &parentEval,
+                          unsigned int depth, unsigned int ply, double alpha, double beta,
+                          const std::atomic_bool &abort) -> double;
+
+        auto chanceValue(const Successor &successor, const SearchState &parent, const IncrementalEval &parentEval,
+                         unsigned int depth, unsigned int ply, double alpha, double beta,
+                         const std::atomic_bool &abort) -> double;
+
+        auto probeOutcome(const Outcome &outcome, const SearchState &parent, const IncrementalEval &parentEval,
+                          unsigned int depth, unsigned int ply, const std::atomic_bool &abort) -> EvalBounds;
+
+        auto leafValue(const SearchState &state, const IncrementalEval &eval) -> double;
+
+        /**
+         * Expected line of play and whether the match ends on it
+         */
+        struct PrincipalLine {
+            std::vector<communication::messages::request::DeltaRequest> actions;
+            bool endsGame;
+        };
+
+        auto principalLine(Successor first, unsigned int depth) const -> PrincipalLine;
+
+        bool isMyTurn(const aiTools::ActionState &actionState) const;
+
+        const SearchContext &context;
+        gameModel::TeamSide mySide;
+        TranspositionTable &table;
+        unsigned int threads;
+        bool collectPrincipalVariation;
+        bool orderMoves;
+        MoveOrdering ordering;
+        LeafEval leafEval = nullptr;
+        ChancePruning chancePruning = ChancePruning::None;
+        EvalBounds evalBounds = SIMPLE_EVAL_BOUNDS;
+        IterationCallback helperCallback;
+        unsigned long expansions = 0;
+        SearchStats stats;
+
+        /**
+         * Successor lists and move orders of the nodes on the current path, rewound when a node is left
+         */
+        Arena arena;
+    };
+}
+
+#endif //KI_SEARCH_HPP
@@ -0,0 +1,260 @@
+/**
+ * @file SearchState.cpp
+ * @brief Implements the conversion between aiTools::State and the flat SearchState
+ */
+
+#include "SearchState.hpp"
+#include "AI.h"
+#include "Zobrist.hpp"
+#include "ShotTable.hpp"
+#include <SopraGameLogic/GameController.h>
+#include <SopraGameLogic/conversions.h>
+#include <atomic>
+#include <limits>
+
+namespace ai {
+    /**
+     * Order of the fan counters inside SearchState::fanblock, same order as the arguments of gameModel::Fanblock
+     */
+    constexpr std::array<gameModel::InterferenceType, FAN_TYPE_COUNT> fanTypes = {
+            gameModel::InterferenceType::Teleport,
+            gameModel::InterferenceType::RangedAttack,
+            gameModel::InterferenceType::Impulse,
+            gameModel::InterferenceType::SnitchPush,
+            gameModel::InterferenceType::BlockCell};
+
+    /**
+     * Constructs a player of the given type from its entry in a SearchState
+     */
+    template<typename T>
+    auto makePlayer(const SearchState &state, const SearchContext &context, std::size_t index) -> T {
+        T player{toPosition(state.players[index]), context.brooms[index], playerIds[index]};
+        player.knockedOut = state.isKnockedOut(index);
+        player.isFined = state.isBanned(index);
+        return player;
+    }
+
+    /**
+     * Allocates an entity of a full state, from the global allocator if arena is nullptr
+     */
+    template<typename T, typename ...Args>
+    auto makeShared(Arena *arena, Args &&...args) -> std::shared_ptr<T> {
+        return std::allocate_shared<T>(ArenaAllocator<T>{arena}, std::forward<Args>(args)...);
+    }
+
+    auto toCell(const gameModel::Position &position) -> Cell {
+        if (position.x < 0 || position.x >= FIELD_WIDTH || position.y < 0 || position.y >= FIELD_HEIGHT) {
+            return NO_CELL;
+        }
+
+        return static_cast<Cell>(position.y * FIELD_WIDTH + position.x);
+    }
+
+    auto toPosition(Cell cell) -> gameModel::Position {
+        if (cell == NO_CELL) {
+            return {-1, -1};
+        }
+
+        return {cell % FIELD_WIDTH, cell / FIELD_WIDTH};
+    }
+
+    auto distance(Cell a, Cell b) -> int {
+        // Covers every possible value of Cell so off-pitch players (NO_CELL) can be looked up as well
+        constexpr std::size_t cellValues = std::numeric_limits<Cell>::max() + 1;
+        static const auto table = []() {
+            std::array<std::array<std::uint8_t, cellValues>, cellValues> ret{};
+            for (std::size_t from = 0; from < cellValues; from++) {
+                for (std::size_t to = 0; to < cellValues; to++) {
+                    ret[from][to] = static_cast<std::uint8_t>(gameController::getDistance(
+                            toPosition(static_cast<Cell>(from)), toPosition(static_cast<Cell>(to))));
+                }
+            }
+
+            return ret;
+        }();
+
+        return table[a][b];
+    }
+
+    auto playerIndex(communication::messages::types::EntityId id) -> std::size_t {
+        for (std::size_t i = 0; i < PLAYER_COUNT; i++) {
+            if (playerIds[i] == id) {
+                return i;
+            }
+        }
+
+        throw std::runtime_error("Id " + communication::messages::types::toString(id) + " is not a player");
+    }
+
+    auto SearchState::fromState(const aiTools::State &state) -> SearchState {
+        auto ret = convert(state);
+        ret.key = zobristKey(ret);
+        return ret;
+    }
+
+    auto SearchState::fromState(const aiTools::State &state, const SearchState &parent) -> SearchState {
+        auto ret = convert(state);
+        ret.key = updateZobristKey(parent.key, parent, ret);
+        return ret;
+    }
+
+    auto SearchState::convert(const aiTools::State &state) -> SearchState {
+        SearchState ret{};
+        for (std::size_t i = 0; i < PLAYER_COUNT; i++) {
+            auto player = state.env->getPlayerById(playerIds[i]);
+            ret.players[i] = toCell(player->position);
+            const auto &usedSet = i < PLAYERS_PER_TEAM ? state.playersUsedLeft : state.playersUsedRight;
+            if (player->knockedOut) {
+                ret.knockedOut |= 1u << i;
+            }
+
+            if (player->isFined) {
+                ret.banned |= 1u << i;
+            }
+
+            if (usedSet.find(playerIds[i]) != usedSet.end()) {
+                ret.used |= 1u << i;
+            }
+        }
+
+        ret.quaffle = toCell(state.env->quaffle->position);
+        ret.bludgers = {toCell(state.env->bludgers[0]->position), toCell(state.env->bludgers[1]->position)};
+        ret.snitchExists = state.env->snitch->exists;
+        ret.snitch = toCell(state.env->snitch->position);
+        for (const auto &cube : state.env->pileOfShit) {
+            ret.cubes.set(toCell(cube->position));
+        }
+
+        for (auto side : {gameModel::TeamSide::LEFT, gameModel::TeamSide::RIGHT}) {
+            auto team = state.env->getTeam(side);
+            const auto &available = side == gameModel::TeamSide::LEFT ? state.availableFansLeft : state.availableFansRight;
+            ret.scores[sideIndex(side)] = static_cast<std::int16_t>(team->score);
+            for (std::size_t i = 0; i < FAN_TYPE_COUNT; i++) {
+                ret.fanblock[sideIndex(side)][i] = static_cast<std::uint8_t>(team->fanblock.getUses(fanTypes[i]));
+                ret.availableFans[sideIndex(side)][i] = static_cast<std::uint8_t>(available[i]);
+            }
+        }
+
+        ret.roundNumber = static_cast<std::uint16_t>(state.roundNumber);
+        ret.overTimeCounter = static_cast<std::uint16_t>(state.overTimeCounter);
+        ret.phase = static_cast<std::uint8_t>(state.currentPhase);
+        ret.overtimeState = static_cast<std::uint8_t>(state.overtimeState);
+        ret.goalScoredThisRound = state.goalScoredThisRound;
+        return ret;
+    }
+
+    auto SearchState::toState(const SearchContext &context, Arena *arena) const -> aiTools::State {
+        auto makeTeam = [this, &context, arena](gameModel::TeamSide side) {
+            auto base = sideIndex(side) * PLAYERS_PER_TEAM;
+            auto seeker = makePlayer<gameModel::Seeker>(*this, context, base + SEEKER_OFFSET);
+            auto keeper = makePlayer<gameModel::Keeper>(*this, context, base + KEEPER_OFFSET);
+            std::array<gameModel::Beater, 2> beaters = {
+                    makePlayer<gameModel::Beater>(*this, context, base + BEATER_OFFSET),
+                    makePlayer<gameModel::Beater>(*this, context, base + BEATER_OFFSET + 1)};
+            std::array<gameModel::Chaser, 3> chasers = {
+                    makePlayer<gameModel::Chaser>(*this, context, base + CHASER_OFFSET),
+                    makePlayer<gameModel::Chaser>(*this, context, base + CHASER_OFFSET + 1),
+                    makePlayer<gameModel::Chaser>(*this, context, base + CHASER_OFFSET + 2)};
+
+            const auto &fans = fanblock[sideIndex(side)];
+            gameModel::Fanblock block(fans[0], fans[1], fans[2], fans[3], fans[4]);
+            return makeShared<gameModel::Team>(arena, seeker, keeper, beaters, chasers, scores[sideIndex(side)], block, side);
+        };
+
+        aiTools::State state;
+        state.env = makeShared<gameModel::Environment>(arena, context.config, makeTeam(gameModel::TeamSide::LEFT),
+                makeTeam(gameModel::TeamSide::RIGHT));
+        state.env->quaffle = makeShared<gameModel::Quaffle>(arena, toPosition(quaffle));
+        state.env->bludgers = {
+                makeShared<gameModel::Bludger>(arena, toPosition(bludgers[0]), communication::messages::types::EntityId::BLUDGER1),
+                makeShared<gameModel::Bludger>(arena, toPosition(bludgers[1]), communication::messages::types::EntityId::BLUDGER2)};
+        state.env->snitch = makeShared<gameModel::Snitch>(arena, toPosition(snitch));
+        state.env->snitch->exists = snitchExists;
+        state.env->pileOfShit.clear();
+        for (std::size_t cell = 0; cell < CELL_COUNT; cell++) {
+            if (cubes.test(static_cast<Cell>(cell))) {
+                state.env->pileOfShit.emplace_back(makeShared<gameModel::CubeOfShit>(arena, toPosition(static_cast<Cell>(cell))));
+            }
+        }
+
+        state.roundNumber = roundNumber;
+        state.overTimeCounter = overTimeCounter;
+        state.currentPhase = static_cast<communication::messages::types::PhaseType>(phase);
+        state.overtimeState = static_cast<gameController::ExcessLength>(overtimeState);
+        state.goalScoredThisRound = goalScoredThisRound;
+        state.playersUsedLeft = {};
+        state.playersUsedRight = {};
+        for (std::size_t i = 0; i < PLAYER_COUNT; i++) {
+            if ((used >> i) & 1u) {
+                (i < PLAYERS_PER_TEAM ? state.playersUsedLeft : state.playersUsedRight).emplace(playerIds[i]);
+            }
+        }
+
+        for (std::size_t i = 0; i < FAN_TYPE_COUNT; i++) {
+            state.availableFansLeft[i] = availableFans[0][i];
+            state.availableFansRight[i] = availableFans[1][i];
+        }
+
+        return state;
+    }
+
+    auto SearchState::playerOn(Cell cell) const -> std::optional<std::size_t> {
+        for (std::size_t i = 0; i < PLAYER_COUNT; i++) {
+            if (players[i] == cell && !isBanned(i)) {
+                return i;
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    bool SearchState::operator==(const SearchState &other) const {
+        return players == other.players && knockedOut == other.knockedOut && banned == other.banned &&
+               used == other.used && quaffle == other.quaffle && bludgers == other.bludgers &&
+               snitch == other.snitch && cubes.bits == other.cubes.bits && scores == other.scores &&
+               fanblock == other.fanblock && availableFans == other.availableFans &&
+               roundNumber == other.roundNumber && overTimeCounter == other.overTimeCounter &&
+               phase == other.phase && overtimeState == other.overtimeState &&
+               snitchExists == other.snitchExists && goalScoredThisRound == other.goalScoredThisRound;
+    }
+
+    bool SearchState::operator!=(const SearchState &other) const {
+        return !(*this == other);
+    }
+
+    SearchContext::SearchContext(const std::shared_ptr<const gameModel::Environment> &env,
+                                 std::shared_ptr<const ShotTable> shots) :
+            config(env->config), brooms{}, shots(std::move(shots)) {
+        static std::atomic_uint64_t nextId = 0;
+        id = nextId.fetch_add(1, std::memory_order_relaxed);
+        for (std::size_t i = 0; i < PLAYER_COUNT; i++) {
+            brooms[i] = env->getPlayerById(playerIds[i])->broom;
+        }
+
+        if (!this->shots) {
+            this->shots = std::make_shared<const ShotTable>(config);
+        }
+    }
+
+    auto expand(const SearchState &state, const SearchContext &context, const aiTools::ActionState &actionState,
+                Arena *arena) -> Successors {
+        // The full state only lives during the expansion, its environment is allocated from a scratch arena that is
+        // rewound once all outcomes are converted
+        thread_local Arena scratch;
+        Arena::Scope scope(scratch);
+        auto expanded = aiTools::expandState(state.toState(context, &scratch), actionState);
+        Successors ret{ArenaAllocator<Successor>{arena}};
+        ret.reserve(expanded.size());
+        for (const auto &[action, outcomes] : expanded) {
+            Successor successor{action, ArenaVector<Outcome>{ArenaAllocator<Outcome>{arena}}};
+            successor.outcomes.reserve(outcomes.size());
+            for (const auto &[nextState, nextActionState, probability] : outcomes) {
+                successor.outcomes.push_back({SearchState::fromState(nextState, state), nextActionState, probability});
+            }
+
+            ret.emplace_back(std::move(successor));
+        }
+
+        return ret;
+    }
+}
@@ -0,0 +1,270 @@
+/**
+ * @file SearchState.hpp
+ * @brief Declares the flat, trivially copyable state representation used by the search
+ */
+
+#ifndef KI_SEARCHSTATE_HPP
+#define KI_SEARCHSTATE_HPP
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+#include <vector>
+#include <SopraGameLogic/GameModel.h>
+#include <SopraMessages/DeltaRequest.hpp>
+#include <SopraAITools/AITools.h>
+#include "Arena.hpp"
+
+namespace ai {
+    constexpr int FIELD_WIDTH = 17;
+    constexpr int FIELD_HEIGHT = 13;
+    constexpr std::size_t CELL_COUNT = FIELD_WIDTH * FIELD_HEIGHT;
+    constexpr std::size_t PLAYER_COUNT = 14;
+    constexpr std::size_t PLAYERS_PER_TEAM = PLAYER_COUNT / 2;
+    constexpr std::size_t FAN_TYPE_COUNT = 5;
+
+    /**
+     * Index of a cell on the pitch (y * FIELD_WIDTH + x)
+     */
+    using Cell = std::uint8_t;
+    constexpr Cell NO_CELL = 0xFF;
+
+    /**
+     * Set of players, bit i corresponds to playerIds[i]
+     */
+    using PlayerMask = std::uint16_t;
+
+    /**
+     * Order of the players inside a SearchState. The first PLAYERS_PER_TEAM entries belong to the left team.
+     */
+    constexpr std::array<communication::messages::types::EntityId, PLAYER_COUNT> playerIds = {
+            communication::messages::types::EntityId::LEFT_SEEKER,
+            communication::messages::types::EntityId::LEFT_KEEPER,
+            communication::messages::types::EntityId::LEFT_CHASER1,
+            communication::messages::types::EntityId::LEFT_CHASER2,
+            communication::messages::types::EntityId::LEFT_CHASER3,
+            communication::messages::types::EntityId::LEFT_BEATER1,
+            communication::messages::types::EntityId::LEFT_BEATER2,
+            communication::messages::types::EntityId::RIGHT_SEEKER,
+            communication::messages::types::EntityId::RIGHT_KEEPER,
+            communication::messages::types::EntityId::RIGHT_CHASER1,
+            communication::messages::types::EntityId::RIGHT_CHASER2,
+            communication::messages::types::EntityId::RIGHT_CHASER3,
+            communication::messages::types::EntityId::RIGHT_BEATER1,
+            communication::messages::types::EntityId::RIGHT_BEATER2};
+
+    /**
+     * Offsets of the roles inside a team block of playerIds
+     */
+    constexpr std::size_t SEEKER_OFFSET = 0;
+    constexpr std::size_t KEEPER_OFFSET = 1;
+    constexpr std::size_t CHASER_OFFSET = 2;
+    constexpr std::size_t BEATER_OFFSET = 5;
+
+    /**
+     * Converts a position to a cell index
+     * @param position the position on the pitch
+     * @return the cell index or NO_CELL if the position is not on the pitch
+     */
+    auto toCell(const gameModel::Position &position) -> Cell;
+
+    /**
+     * Converts a cell index back to a position
+     * @param cell a cell index other than NO_CELL
+     * @return the corresponding position
+     */
+    auto toPosition(Cell cell) -> gameModel::Position;
+
+    /**
+     * Distance between two cells as defined by gameController::getDistance, served from a precomputed table
+     * @param a first cell
+     * @param b second cell
+     * @return the distance between a and b
+     */
+    auto distance(Cell a, Cell b) -> int;
+
+    /**
+     * Index of a player inside a SearchState
+     * @param id id of a player
+     * @return the index into SearchState::players
+     */
+    auto playerIndex(communication::messages::types::EntityId id) -> std::size_t;
+
+    /**
+     * Index of a team side in the per team arrays of a SearchState
+     * @param side the side of the team
+     * @return 0 for the left and 1 for the right team
+     */
+    constexpr auto sideIndex(gameModel::TeamSide side) -> std::size_t {
+        return side == gameModel::TeamSide::LEFT ? 0 : 1;
+    }
+
+    /**
+     * Mask containing all players of a team
+     * @param side the side of the team
+     * @return mask with the bits of all members set
+     */
+    constexpr auto teamMask(gameModel::TeamSide side) -> PlayerMask {
+        constexpr PlayerMask leftMask = (1u << PLAYERS_PER_TEAM) - 1;
+        return side == gameModel::TeamSide::LEFT ? leftMask : static_cast<PlayerMask>(leftMask << PLAYERS_PER_TEAM);
+    }
+
+    /**
+     * Bitset over all cells of the pitch
+     */
+    struct CellSet {
+        std::array<std::uint64_t, (CELL_COUNT + 63) / 64> bits;
+
+        bool test(Cell cell) const {
+            return (bits[cell / 64] >> (cell % 64)) & 1u;
+        }
+
+        void set(Cell cell) {
+            bits[cell / 64] |= std::uint64_t{1} << (cell % 64);
+        }
+
+        void reset(Cell cell) {
+            bits[cell / 64] &= ~(std::uint64_t{1} << (cell % 64));
+        }
+    };
+
+    class SearchContext;
+    class ShotTable;
+
+    /**
+     * Compact value type representation of an aiTools::State. Everything that does not change during a match
+     * (config, brooms) lives in the SearchContext, so a SearchState can be copied with a single memcpy.
+     */
+    struct SearchState {
+        std::array<Cell, PLAYER_COUNT> players;
+        PlayerMask knockedOut;
+        PlayerMask banned;
+        PlayerMask used;
+        Cell quaffle;
+        std::array<Cell, 2> bludgers;
+        Cell snitch;
+        CellSet cubes;
+        std::array<std::int16_t, 2> scores;
+        std::array<std::array<std::uint8_t, FAN_TYPE_COUNT>, 2> fanblock;
+        std::array<std::array<std::uint8_t, FAN_TYPE_COUNT>, 2> availableFans;
+        std::uint16_t roundNumber;
+        std::uint16_t overTimeCounter;
+        std::uint8_t phase : 2;
+        std::uint8_t overtimeState : 2;
+        bool snitchExists : 1;
+        bool goalScoredThisRound : 1;
+
+        /**
+         * Zobrist key of the state, see zobristKey()
+         */
+        std::uint64_t key;
+
+        /**
+         * Builds the flat representation of a state
+         * @param state the state to convert
+         * @return the corresponding SearchState
+         */
+        static auto fromState(const aiTools::State &state) -> SearchState;
+
+        /**
+         * Builds the flat representation of a successor, the key is derived incrementally from the parent
+         * @param state the state to convert
+         * @param parent the state state was derived from
+         * @return the corresponding SearchState
+         */
+        static auto fromState(const aiTools::State &state, const SearchState &parent) -> SearchState;
+
+        /**
+         * Converts the flat representation back into a full state
+         * @param context the match constants the state was created with
+         * @param arena arena the environment and its entities are allocated from, the global allocator is used if
+         * it is nullptr. The state must not outlive the memory of the arena.
+         * @return a freshly allocated aiTools::State equal to the one this object was created from
+         */
+        auto toState(const SearchContext &context, Arena *arena = nullptr) const -> aiTools::State;
+
+        bool isKnockedOut(std::size_t player) const {
+            return (knockedOut >> player) & 1u;
+        }
+
+        bool isBanned(std::size_t player) const {
+            return (banned >> player) & 1u;
+        }
+
+        /**
+         * Returns the first player on the given cell that has not been banned
+         * @param cell the cell to check
+         * @return the index of the player or nothing if the cell is empty
+         */
+        auto playerOn(Cell cell) const -> std::optional<std::size_t>;
+
+        /**
+         * Compares the content of two states, the key is not compared
+         */
+        bool operator==(const SearchState &other) const;
+        bool operator!=(const SearchState &other) const;
+
+    private:
+        static auto convert(const aiTools::State &state) -> SearchState;
+    };
+
+    static_assert(std::is_trivially_copyable_v<SearchState>, "SearchState needs to be copyable with memcpy");
+
+    /**
+     * Data that stays constant during a match and is needed to evaluate or expand a SearchState
+     */
+    class SearchContext {
+    public:
+        /**
+         * CTor. Extracts the match constants from an environment
+         * @param env an environment of the current match
+         * @param shots shot table of the match, built from the config of env if not set
+         */
+        explicit SearchContext(const std::shared_ptr<const gameModel::Environment> &env,
+                               std::shared_ptr<const ShotTable> shots = nullptr);
+
+        gameModel::Config config;
+        std::array<communication::messages::types::Broom, PLAYER_COUNT> brooms;
+        std::shared_ptr<const ShotTable> shots;
+
+        /**
+         * Unique per constructed context, copies share it. Separates the entries of different matches in caches
+         * that are keyed by SearchState::key.
+         */
+        std::uint64_t id;
+    };
+
+    /**
+     * Possible outcome of an action
+     */
+    struct Outcome {
+        SearchState state;
+        std::optional<aiTools::ActionState> next;
+        double probability;
+    };
+
+    /**
+     * Action available in a state together with all of its outcomes
+     */
+    struct Successor {
+        communication::messages::request::DeltaRequest action;
+        ArenaVector<Outcome> outcomes;
+    };
+
+    using Successors = ArenaVector<Successor>;
+
+    /**
+     * Generates all actions for the given turn. The rules are applied by aiTools, the results are converted to
+     * SearchStates.
+     * @param state the state to expand
+     * @param context match constants of the state
+     * @param actionState the turn to expand
+     * @param arena arena the successors are allocated from, the global allocator is used if it is nullptr
+     * @return all possible actions with their outcomes
+     */
+    auto expand(const SearchState &state, const SearchContext &context, const aiTools::ActionState &actionState,
+                Arena *arena = nullptr) -> Successors;
+}
+
+#endif //KI_SEARCHSTATE_HPP
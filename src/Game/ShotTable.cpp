@@ -0,0 +1,174 @@
+/**
+ * @file ShotTable.cpp
+ * @brief Implements the precomputed success probabilities of quaffle shots on goal
+ */
+
+#include "ShotTable.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace ai {
+    namespace {
+        /**
+         * Creates an environment where every player is banned, so that no player can intercept a shot
+         */
+        auto createScratchEnv(const gameModel::Config &config) -> std::shared_ptr<gameModel::Environment> {
+            using ID = communication::messages::types::EntityId;
+            auto createTeam = [](gameModel::TeamSide side) {
+                bool left = side == gameModel::TeamSide::LEFT;
+                gameModel::Seeker seeker({0, 0}, {}, left ? ID::LEFT_SEEKER : ID::RIGHT_SEEKER);
+                gameModel::Keeper keeper({0, 0}, {}, left ? ID::LEFT_KEEPER : ID::RIGHT_KEEPER);
+                std::array<gameModel::Beater, 2> beaters{
+                        gameModel::Beater({0, 0}, {}, left ? ID::LEFT_BEATER1 : ID::RIGHT_BEATER1),
+                        gameModel::Beater({0, 0}, {}, left ? ID::LEFT_BEATER2 : ID::RIGHT_BEATER2)};
+                std::array<gameModel::Chaser, 3> chasers{
+                        gameModel::Chaser({0, 0}, {}, left ? ID::LEFT_CHASER1 : ID::RIGHT_CHASER1),
+                        gameModel::Chaser({0, 0}, {}, left ? ID::LEFT_CHASER2 : ID::RIGHT_CHASER2),
+                        gameModel::Chaser({0, 0}, {}, left ? ID::LEFT_CHASER3 : ID::RIGHT_CHASER3)};
+                return std::make_shared<gameModel::Team>(seeker, keeper, beaters, chasers, 0,
+                                                         gameModel::Fanblock(0, 0, 0, 0, 0), side);
+            };
+
+            auto env = std::make_shared<gameModel::Environment>(config, createTeam(gameModel::TeamSide::LEFT),
+                                                                createTeam(gameModel::TeamSide::RIGHT));
+            for (const auto &player : env->getAllPlayers()) {
+                player->isFined = true;
+                player->knockedOut = false;
+            }
+
+            return env;
+        }
+
+        auto count(const CellSet &a, const CellSet &b) -> int {
+            int ret = 0;
+            for (std::size_t i = 0; i < a.bits.size(); i++) {
+                ret += __builtin_popcountll(a.bits[i] & b.bits[i]);
+            }
+
+            return ret;
+        }
+    }
+
+    ShotTable::ShotTable(const gameModel::Config &config) : entries{} {
+        auto env = createScratchEnv(config);
+        std::array<gameModel::Position, GOAL_COUNT> goals{};
+        auto goalsLeft = gameModel::Environment::getGoalsLeft();
+        auto goalsRight = gameModel::Environment::getGoalsRight();
+        std::copy(goalsLeft.begin(), goalsLeft.end(), goals.begin());
+        std::copy(goalsRight.begin(), goalsRight.end(), goals.begin() + goalsLeft.size());
+
+        for (auto side : {gameModel::TeamSide::LEFT, gameModel::TeamSide::RIGHT}) {
+            auto otherSide = side == gameModel::TeamSide::LEFT ? gameModel::TeamSide::RIGHT : gameModel::TeamSide::LEFT;
+            auto shooter = env->getTeam(side)->chasers[0];
+            auto interceptor = env->getTeam(otherSide)->chasers[0];
+            shooter->isFined = false;
+            for (std::size_t cell = 0; cell < CELL_COUNT; cell++) {
+                auto source = toPosition(static_cast<Cell>(cell));
+                shooter->position = source;
+                env->quaffle->position = source;
+                for (std::size_t goal = 0; goal < GOAL_COUNT; goal++) {
+                    auto &entry = entries[sideIndex(side)][cell][goal];
+                    gameController::Shot shot(env, shooter, env->quaffle, goals[goal]);
+                    entry.result = shot.isShotOnGoal();
+                    entry.baseProb = shot.successProb();
+                    entry.interceptFactor = 1;
+
+                    std::optional<gameModel::Position> firstIntercept;
+                    for (const auto &crossed : gameController::getAllCrossedCells(source, goals[goal])) {
+                        auto crossedCell = toCell(crossed);
+                        if (crossed != source && crossedCell != NO_CELL) {
+                            entry.interceptCells.set(crossedCell);
+                            if (!firstIntercept.has_value()) {
+                                firstIntercept = crossed;
+                            }
+                        }
+                    }
+
+                    // Measure the effect of a single interceptor, every further one has the same effect
+                    if (firstIntercept.has_value() && entry.baseProb > 0) {
+                        interceptor->position = *firstIntercept;
+                        interceptor->isFined = false;
+                        gameController::Shot intercepted(env, shooter, env->quaffle, goals[goal]);
+                        entry.interceptFactor = intercepted.successProb() / entry.baseProb;
+                        interceptor->isFined = true;
+                    }
+                }
+            }
+
+            shooter->isFined = true;
+        }
+    }
+
+    auto ShotTable::entry(gameModel::TeamSide side, Cell source, std::size_t goal) const -> const Entry & {
+        return entries[sideIndex(side)][source][goal];
+    }
+
+    auto ShotTable::successProb(gameModel::TeamSide side, Cell source, std::size_t goal,
+                                const CellSet &opponents) const -> double {
+        const auto &shot = entry(side, source, goal);
+        auto interceptors = count(shot.interceptCells, opponents);
+        return interceptors == 0 ? shot.baseProb : shot.baseProb * std::pow(shot.interceptFactor, interceptors);
+    }
+
+    auto ShotTable::highestGoalRate(gameModel::TeamSide side, Cell source, const CellSet &opponents) const -> double {
+        // Same goal rings as getHighestGoalRate
+        std::size_t firstGoal = side == gameModel::TeamSide::LEFT ? 0 : GOAL_COUNT / 2;
+        double chance = 0;
+        for (auto goal = firstGoal; goal < firstGoal + GOAL_COUNT / 2; goal++) {
+            auto result = entry(side, source, goal).result;
+            if (result == gameController::ActionResult::ScoreLeft || result == gameController::ActionResult::ScoreRight) {
+                chance = std::max(chance, successProb(side, source, goal, opponents));
+            }
+        }
+
+        return chance;
+    }
+
+    auto ShotTable::hypotheticalShot(gameModel::TeamSide side, Cell source, const CellSet &opponents) const -> double {
+        // Same goal rings as hypotheticalShotSuccessProb
+        std::size_t firstGoal = side == gameModel::TeamSide::LEFT ? GOAL_COUNT / 2 : 0;
+        auto goals = side == gameModel::TeamSide::LEFT ? gameModel::Environment::getGoalsRight() :
+                gameModel::Environment::getGoalsLeft();
+        double chance = 0;
+        for (std::size_t i = 0; i < goals.size(); i++) {
+            if (toCell(goals[i]) == source) {
+                return 1;
+            }
+
+            if (entry(side, source, firstGoal + i).result.has_value()) {
+                chance = std::max(chance, successProb(side, source, firstGoal + i, opponents));
+            }
+        }
+
+        return chance;
+    }
+
+    auto ShotTable::occupancy(const std::shared_ptr<const gameModel::Environment> &env,
+                              gameModel::TeamSide side) -> CellSet {
+        return occupancy(*env, side);
+    }
+
+    auto ShotTable::occupancy(const gameModel::Environment &env, gameModel::TeamSide side) -> CellSet {
+        CellSet ret{};
+        for (const auto &player : env.getTeam(side)->getAllPlayers()) {
+            auto cell = toCell(player->position);
+            if (!player->isFined && cell != NO_CELL) {
+                ret.set(cell);
+            }
+        }
+
+        return ret;
+    }
+
+    auto ShotTable::occupancy(const SearchState &state, gameModel::TeamSide side) -> CellSet {
+        CellSet ret{};
+        auto first = sideIndex(side) * PLAYERS_PER_TEAM;
+        for (auto i = first; i < first + PLAYERS_PER_TEAM; i++) {
+            if (!state.isBanned(i) && state.players[i] != NO_CELL) {
+                ret.set(state.players[i]);
+            }
+        }
+
+        return ret;
+    }
+}
@@ -0,0 +1,123 @@
+/**
+ * @file ShotTable.hpp
+ * @brief Declares the precomputed success probabilities of quaffle shots on goal
+ */
+
+#ifndef KI_SHOTTABLE_HPP
+#define KI_SHOTTABLE_HPP
+
+#include <array>
+#include <optional>
+#include "SearchState.hpp"
+#include <SopraGameLogic/GameController.h>
+
+namespace ai {
+    /**
+     * Number of goal rings on the pitch, the first three are getGoalsLeft(), the last three getGoalsRight()
+     */
+    constexpr std::size_t GOAL_COUNT = 6;
+
+    /**
+     * Outcome of a quaffle shot from every cell to every goal ring for both teams, built once per match. A shot is
+     * described by the probability without any opponent in the way and the cells where an opponent can intercept
+     * it. Every opponent on such a cell multiplies the probability with the interception factor, so evaluating a
+     * shot is a table lookup and a popcount over the opponent occupancy.
+     */
+    class ShotTable {
+    public:
+        struct Entry {
+            /**
+             * Result of gameController::Shot::isShotOnGoal without interceptors
+             */
+            std::optional<gameController::ActionResult> result;
+
+            /**
+             * Success probability without interceptors
+             */
+            double baseProb;
+
+            /**
+             * Factor applied to baseProb for every opponent on one of the interceptCells
+             */
+            double interceptFactor;
+
+            /**
+             * Cells the quaffle crosses on its way to the goal ring
+             */
+            CellSet interceptCells;
+        };
+
+        /**
+         * CTor. Simulates every shot on a scratch environment using the given config
+         * @param config config of the current match
+         */
+        explicit ShotTable(const gameModel::Config &config);
+
+        /**
+         * Table entry of a shot
+         * @param side side of the shooting team
+         * @param source cell the quaffle is shot from
+         * @param goal index of the goal ring
+         * @return the precomputed shot
+         */
+        auto entry(gameModel::TeamSide side, Cell source, std::size_t goal) const -> const Entry &;
+
+        /**
+         * Success probability of a shot
+         * @param side side of the shooting team
+         * @param source cell the quaffle is shot from
+         * @param goal index of the goal ring
+         * @param opponents cells occupied by players of the other team
+         * @return the same value as gameController::Shot::successProb
+         */
+        auto successProb(gameModel::TeamSide side, Cell source, std::size_t goal, const CellSet &opponents) const -> double;
+
+        /**
+         * Lookup equivalent of ai::getHighestGoalRate
+         * @param side side of the shooting team
+         * @param source cell the quaffle is shot from
+         * @param opponents cells occupied by players of the other team
+         * @return The highest success rate of any shot resulting in a goal
+         */
+        auto highestGoalRate(gameModel::TeamSide side, Cell source, const CellSet &opponents) const -> double;
+
+        /**
+         * Lookup equivalent of ai::hypotheticalShotSuccessProb
+         * @param side side of the team to attempt the shot
+         * @param source cell of the quaffle
+         * @param opponents cells occupied by players of the other team
+         * @return highest chance of scoring a goal if a non existing player of the team held the Quaffle
+         */
+        auto hypotheticalShot(gameModel::TeamSide side, Cell source, const CellSet &opponents) const -> double;
+
+        /**
+         * Cells occupied by the players of a team that are on the pitch
+         * @param env the environment
+         * @param side side of the team
+         * @return set of all cells with a non banned player of the team
+         */
+        static auto occupancy(const std::shared_ptr<const gameModel::Environment> &env,
+                              gameModel::TeamSide side) -> CellSet;
+
+        /**
+         * Cells occupied by the players of a team that are on the pitch
+         * @param env the environment
+         * @param side side of the team
+         * @return set of all cells with a non banned player of the team
+         */
+        static auto occupancy(const gameModel::Environment &env, gameModel::TeamSide side) -> CellSet;
+
+        /**
+         * Cells occupied by the players of a team that are on the pitch
+         * @param state the state
+         * @param side side of the team
+         * @return set of all cells with a non banned player of the team
+         */
+        static auto occupancy(const SearchState &state, gameModel::TeamSide side) -> CellSet;
+
+    private:
+        std::array<std::array<std::array<Entry, GOAL_COUNT>, CELL_COUNT>, 2> entries;
+    };
+}
+
+#endif //KI_SHOTTABLE_HPP
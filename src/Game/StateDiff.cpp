@@ -0,0 +1,238 @@
+/**
+ * @file StateDiff.cpp
+ * @brief Implements the in place application of snapshots to a state
+ */
+
+#include "StateDiff.hpp"
+#include <stdexcept>
+#include <SopraGameLogic/conversions.h>
+
+namespace ai {
+    namespace {
+        auto toModel(const communication::Coordinates &coordinates) -> gameModel::Position {
+            return {coordinates.first, coordinates.second};
+        }
+
+        bool sameFanblock(const gameModel::Fanblock &a, const gameModel::Fanblock &b) {
+            for (auto type : {gameModel::InterferenceType::Teleport, gameModel::InterferenceType::RangedAttack,
+                              gameModel::InterferenceType::Impulse, gameModel::InterferenceType::SnitchPush,
+                              gameModel::InterferenceType::BlockCell}) {
+                if (a.getUses(type) != b.getUses(type)) {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+    }
+
+    auto fanblockFromSnapshot(const communication::TeamFrame &team) -> gameModel::Fanblock {
+        using communication::messages::types::FanType;
+        int teleport = 0;
+        int rangedAttack = 0;
+        int impulse = 0;
+        int snitchPush = 0;
+        int blockCell = 0;
+        for (const auto &fan : team.fans) {
+            if (fan.banned) {
+                continue;
+            }
+
+            switch (fan.fanType) {
+                case FanType::GOBLIN:
+                    rangedAttack++;
+                    break;
+                case FanType::TROLL:
+                    impulse++;
+                    break;
+                case FanType::ELF:
+                    teleport++;
+                    break;
+                case FanType::NIFFLER:
+                    snitchPush++;
+                    break;
+                case FanType::WOMBAT:
+                    blockCell++;
+                    break;
+            }
+        }
+
+        return {teleport, rangedAttack, impulse, snitchPush, blockCell};
+    }
+
+    void StateDiff::apply(aiTools::State &state, const communication::SnapshotFrame &snapshot) {
+        using namespace communication::messages::types;
+        playerCount = 0;
+        ballCount = 0;
+        cubesChanged = false;
+        usedAdded.reset();
+        usedCleared = false;
+        roundNumber = state.roundNumber;
+        phase = state.currentPhase;
+        goalScoredThisRound = state.goalScoredThisRound;
+        overtimeState = state.overtimeState;
+        overTimeCounter = state.overTimeCounter;
+
+        state.roundNumber = snapshot.round;
+        state.currentPhase = snapshot.phase;
+        state.goalScoredThisRound = snapshot.goalWasThrownThisRound;
+        const auto &lastDelta = snapshot.lastDelta;
+        if (lastDelta.deltaType == DeltaType::TURN_USED) {
+            if (!lastDelta.activeEntity.has_value()) {
+                throw std::runtime_error("Active entity id not set!");
+            }
+
+            auto &used = gameLogic::conversions::idToSide(*lastDelta.activeEntity) == gameModel::TeamSide::LEFT ?
+                         state.playersUsedLeft : state.playersUsedRight;
+            if (used.emplace(*lastDelta.activeEntity).second) {
+                usedAdded = *lastDelta.activeEntity;
+            }
+        } else if (lastDelta.deltaType == DeltaType::ROUND_CHANGE) {
+            // The sets of the record take the old entries, the emptied sets of the last round go to the state
+            usedLeft.clear();
+            usedRight.clear();
+            std::swap(usedLeft, state.playersUsedLeft);
+            std::swap(usedRight, state.playersUsedRight);
+            usedCleared = true;
+        }
+
+        auto &env = *state.env;
+        updateTeam(*env.team1, snapshot.leftTeam);
+        updateTeam(*env.team2, snapshot.rightTeam);
+        updateBall(*env.quaffle, snapshot.quaffle);
+        updateBall(*env.bludgers[0], snapshot.bludger1);
+        updateBall(*env.bludgers[1], snapshot.bludger2);
+        snitchExisted = env.snitch->exists;
+        env.snitch->exists = snapshot.snitch.has_value();
+        updateBall(*env.snitch, snapshot.snitch.value_or(communication::Coordinates{0, 0}));
+        updateCubes(env, snapshot.wombatCubes);
+    }
+
+    void StateDiff::undo(aiTools::State &state) const {
+        auto &env = *state.env;
+        if (cubesChanged) {
+            while (env.pileOfShit.size() > cubes.size()) {
+                env.pileOfShit.pop_back();
+            }
+
+            for (std::size_t i = 0; i < cubes.size(); i++) {
+                if (i < env.pileOfShit.size()) {
+                    env.pileOfShit[i]->position = cubes[i];
+                } else {
+                    env.pileOfShit.emplace_back(std::make_shared<gameModel::CubeOfShit>(cubes[i]));
+                }
+            }
+        }
+
+        env.snitch->exists = snitchExisted;
+        for (std::size_t i = 0; i < ballCount; i++) {
+            balls[i].ball->position = balls[i].position;
+        }
+
+        for (std::size_t i = 0; i < playerCount; i++) {
+            players[i].player->position = players[i].position;
+            players[i].player->knockedOut = players[i].knockedOut;
+            players[i].player->isFined = players[i].isFined;
+        }
+
+        for (auto side : {gameModel::TeamSide::LEFT, gameModel::TeamSide::RIGHT}) {
+            auto &team = *env.getTeam(side);
+            team.score = scores[sideIndex(side)];
+            if (fanblocks[sideIndex(side)].has_value()) {
+                team.fanblock = *fanblocks[sideIndex(side)];
+            }
+        }
+
+        if (usedCleared) {
+            state.playersUsedLeft = usedLeft;
+            state.playersUsedRight = usedRight;
+        } else if (usedAdded.has_value()) {
+            state.playersUsedLeft.erase(*usedAdded);
+            state.playersUsedRight.erase(*usedAdded);
+        }
+
+        state.roundNumber = roundNumber;
+        state.currentPhase = phase;
+        state.goalScoredThisRound = goalScoredThisRound;
+        state.overtimeState = overtimeState;
+        state.overTimeCounter = overTimeCounter;
+    }
+
+    auto StateDiff::getPreviousScore(gameModel::TeamSide side) const -> int {
+        return scores[sideIndex(side)];
+    }
+
+    auto StateDiff::changedEntities() const -> std::size_t {
+        return playerCount + ballCount;
+    }
+
+    void StateDiff::updateTeam(gameModel::Team &team, const communication::TeamFrame &frame) {
+        auto index = sideIndex(team.getSide());
+        scores[index] = team.score;
+        team.score = frame.points;
+        updatePlayer(*team.seeker, frame.seeker);
+        updatePlayer(*team.keeper, frame.keeper);
+        for (std::size_t i = 0; i < team.chasers.size(); i++) {
+            updatePlayer(*team.chasers[i], frame.chasers[i]);
+        }
+
+        for (std::size_t i = 0; i < team.beaters.size(); i++) {
+            updatePlayer(*team.beaters[i], frame.beaters[i]);
+        }
+
+        fanblocks[index].reset();
+        auto fanblock = fanblockFromSnapshot(frame);
+        if (!sameFanblock(team.fanblock, fanblock)) {
+            fanblocks[index].emplace(team.fanblock);
+            team.fanblock = fanblock;
+        }
+    }
+
+    void StateDiff::updatePlayer(gameModel::Player &player, const communication::PlayerFrame &frame) {
+        auto position = toModel(frame.position);
+        if (player.position != position || player.knockedOut != frame.knockout || player.isFined != frame.banned) {
+            players[playerCount++] = {&player, player.position, player.knockedOut, player.isFined};
+            player.position = position;
+            player.knockedOut = frame.knockout;
+            player.isFined = frame.banned;
+        }
+    }
+
+    void StateDiff::updateBall(gameModel::Ball &ball, const communication::Coordinates &position) {
+        auto newPosition = toModel(position);
+        if (ball.position != newPosition) {
+            balls[ballCount++] = {&ball, ball.position};
+            ball.position = newPosition;
+        }
+    }
+
+    void StateDiff::updateCubes(gameModel::Environment &env, const std::vector<communication::Coordinates> &newCubes) {
+        auto &pile = env.pileOfShit;
+        bool same = pile.size() == newCubes.size();
+        for (std::size_t i = 0; same && i < pile.size(); i++) {
+            same = pile[i]->position == toModel(newCubes[i]);
+        }
+
+        if (same) {
+            return;
+        }
+
+        cubesChanged = true;
+        cubes.clear();
+        for (const auto &cube : pile) {
+            cubes.emplace_back(cube->position);
+        }
+
+        while (pile.size() > newCubes.size()) {
+            pile.pop_back();
+        }
+
+        for (std::size_t i = 0; i < newCubes.size(); i++) {
+            if (i < pile.size()) {
+                pile[i]->position = toModel(newCubes[i]);
+            } else {
+                pile.emplace_back(std::make_shared<gameModel::CubeOfShit>(toModel(newCubes[i])));
+            }
+        }
+    }
+}
@@ -0,0 +1,102 @@
+/**
+ * @file StateDiff.hpp
+ * @brief Declares the in place application of snapshots to a state
+ */
+
+#ifndef KI_STATEDIFF_HPP
+#define KI_STATEDIFF_HPP
+
+#include <array>
+#include <optional>
+#include <unordered_set>
+#include <vector>
+#include <SopraGameLogic/GameModel.h>
+#include <SopraGameLogic/GameController.h>
+#include <SopraAITools/AITools.h>
+#include <Communication/SnapshotFrame.hpp>
+#include "SearchState.hpp"
+
+namespace ai {
+    /**
+     * Counts the fans of a team that are not banned
+     * @param team the team as sent in a snapshot
+     * @return the fanblock of the team
+     */
+    auto fanblockFromSnapshot(const communication::TeamFrame &team) -> gameModel::Fanblock;
+
+    /**
+     * Updates the entities of an existing environment to a snapshot instead of rebuilding it. Only values that
+     * differ from the snapshot are written, their previous values are recorded so the previous state can be
+     * restored with undo(). The record is reused for every snapshot, once the cube buffer has grown to the size
+     * needed in the match applying a snapshot does not allocate.
+     */
+    class StateDiff {
+    public:
+        /**
+         * Updates a state to a snapshot and records the overwritten values
+         * @param state the state to update, must have an environment
+         * @param snapshot the new snapshot
+         * @throws std::runtime_error if the last delta is TURN_USED without an active entity
+         */
+        void apply(aiTools::State &state, const communication::SnapshotFrame &snapshot);
+
+        /**
+         * Restores the values overwritten by the last apply()
+         * @param state the state passed to apply(), must not have been modified since
+         */
+        void undo(aiTools::State &state) const;
+
+        /**
+         * Score of a team before the last apply()
+         * @param side the side of the team
+         * @return points of the team
+         */
+        auto getPreviousScore(gameModel::TeamSide side) const -> int;
+
+        /**
+         * Number of players and balls the last apply() changed
+         */
+        auto changedEntities() const -> std::size_t;
+
+    private:
+        struct PlayerChange {
+            gameModel::Player *player;
+            gameModel::Position position;
+            bool knockedOut;
+            bool isFined;
+        };
+
+        struct BallChange {
+            gameModel::Ball *ball;
+            gameModel::Position position;
+        };
+
+        static constexpr std::size_t BALL_COUNT = 4;
+
+        std::array<PlayerChange, PLAYER_COUNT> players{};
+        std::size_t playerCount = 0;
+        std::array<BallChange, BALL_COUNT> balls{};
+        std::size_t ballCount = 0;
+        bool snitchExisted = false;
+        std::array<int, 2> scores{};
+        std::array<std::optional<gameModel::Fanblock>, 2> fanblocks;
+        bool cubesChanged = false;
+        std::vector<gameModel::Position> cubes;
+        unsigned int roundNumber = 0;
+        communication::messages::types::PhaseType phase = communication::messages::types::PhaseType::BALL_PHASE;
+        bool goalScoredThisRound = false;
+        gameController::ExcessLength overtimeState = gameController::ExcessLength::None;
+        unsigned int overTimeCounter = 0;
+        std::optional<communication::messages::types::EntityId> usedAdded;
+        bool usedCleared = false;
+        std::unordered_set<communication::messages::types::EntityId> usedLeft;
+        std::unordered_set<communication::messages::types::EntityId> usedRight;
+
+        void updateTeam(gameModel::Team &team, const communication::TeamFrame &frame);
+        void updatePlayer(gameModel::Player &player, const communication::PlayerFrame &frame);
+        void updateBall(gameModel::Ball &ball, const communication::Coordinates &position);
+        void updateCubes(gameModel::Environment &env, const std::vector<communication::Coordinates> &newCubes);
+    };
+}
+
+#endif //KI_STATEDIFF_HPP
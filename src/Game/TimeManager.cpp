@@ -0,0 +1,93 @@
+/**
+ * @file TimeManager.cpp
+ * @brief Implements the time manager deciding how long the search may run for a turn
+ */
+
+#include "TimeManager.hpp"
+#include <algorithm>
+#include <array>
+#include <SopraGameLogic/GameController.h>
+
+namespace ai {
+    namespace {
+        constexpr unsigned int MAX_DIFFICULTY = 2;
+
+        /**
+         * Share of the available time used on normal turns, per difficulty
+         */
+        constexpr std::array<double, MAX_DIFFICULTY + 1> TIME_SHARE = {1, 1, 0.25};
+
+        /**
+         * Share of the budget after which no new iteration is started, per difficulty
+         */
+        constexpr std::array<double, MAX_DIFFICULTY + 1> ITERATION_SHARE = {1, 1, 0.5};
+
+        /**
+         * Number of iterations with the same best action after which the search stops, per difficulty
+         */
+        constexpr std::array<unsigned int, MAX_DIFFICULTY + 1> STABLE_ITERATIONS = {4, 3, 2};
+
+        constexpr double CRITICAL_FACTOR = 2;
+        constexpr int CRITICAL_DISTANCE = 2;
+    }
+
+    TimeManager::TimeManager(unsigned int difficulty) : difficulty(std::min(difficulty, MAX_DIFFICULTY)) {}
+
+    auto TimeManager::start(const aiTools::State &state, int timeout) -> Budget {
+        auto available = std::max(timeout - TIMEOUT_TOLERANCE, 0);
+        auto share = TIME_SHARE[difficulty] * (isCritical(state) ? CRITICAL_FACTOR : 1);
+        auto maximum = static_cast<int>(std::min(1.0, share) * available);
+        auto optimum = static_cast<int>(ITERATION_SHARE[difficulty] * maximum);
+        budget = {std::chrono::milliseconds{optimum}, std::chrono::milliseconds{maximum}};
+        startTime = std::chrono::steady_clock::now();
+        lastAction.reset();
+        stableIterations = 0;
+        return budget;
+    }
+
+    bool TimeManager::keepSearching(const SearchResult &result) {
+        if (lastAction.has_value() && *lastAction == result.action) {
+            stableIterations++;
+        } else {
+            lastAction = result.action;
+            stableIterations = 1;
+        }
+
+        // The match ends within the search horizon, deeper searches won't change the action
+        if (result.endsGame) {
+            return false;
+        }
+
+        if (stableIterations >= STABLE_ITERATIONS[difficulty]) {
+            return false;
+        }
+
+        return std::chrono::steady_clock::now() - startTime < budget.optimum;
+    }
+
+    bool TimeManager::isCritical(const aiTools::State &state) {
+        if (state.overtimeState != gameController::ExcessLength::None) {
+            return true;
+        }
+
+        const auto &env = state.env;
+        for (const auto &goals : {gameModel::Environment::getGoalsLeft(), gameModel::Environment::getGoalsRight()}) {
+            for (const auto &goal : goals) {
+                if (gameController::getDistance(env->quaffle->position, goal) <= CRITICAL_DISTANCE) {
+                    return true;
+                }
+            }
+        }
+
+        if (env->snitch->exists) {
+            for (const auto &seeker : {env->team1->seeker, env->team2->seeker}) {
+                if (!seeker->isFined &&
+                    gameController::getDistance(seeker->position, env->snitch->position) <= CRITICAL_DISTANCE) {
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+}
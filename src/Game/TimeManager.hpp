@@ -0,0 +1,80 @@
+/**
+ * @file TimeManager.hpp
+ * @brief Declares the time manager deciding how long the search may run for a turn
+ */
+
+#ifndef KI_TIMEMANAGER_HPP
+#define KI_TIMEMANAGER_HPP
+
+#include <chrono>
+#include <optional>
+#include "Search.hpp"
+
+namespace ai {
+    /**
+     * Time the search may use for a single turn
+     */
+    struct Budget {
+        /**
+         * No new iteration is started after this time, the next one would most likely not finish
+         */
+        std::chrono::milliseconds optimum;
+
+        /**
+         * The search is aborted after this time
+         */
+        std::chrono::milliseconds maximum;
+    };
+
+    /**
+     * Maps the difficulty and the situation of the game to a search budget and decides after every iteration
+     * whether deepening is still worth it. The default and the strongest difficulty may use the whole timeout, the
+     * weakest one uses a smaller share. Lower difficulties give up earlier once the best action stops changing.
+     */
+    class TimeManager {
+    public:
+        /**
+         * Time kept in reserve for the network
+         */
+        static constexpr int TIMEOUT_TOLERANCE = 2000;
+
+        /**
+         * CTor
+         * @param difficulty 0 (strongest) to 2 (weakest), larger values are treated as 2
+         */
+        explicit TimeManager(unsigned int difficulty);
+
+        /**
+         * Starts timing a new turn
+         * @param state the current state
+         * @param timeout timeout of the turn as sent by the server in ms
+         * @return the budget of the turn
+         */
+        auto start(const aiTools::State &state, int timeout) -> Budget;
+
+        /**
+         * Decides whether the search should start another iteration
+         * @param result result of the iteration that just finished
+         * @return false if the budget is used up, the best action was stable for enough iterations or the match ends
+         * on the principal variation
+         */
+        bool keepSearching(const SearchResult &result);
+
+        /**
+         * A turn is critical if the quaffle is close to a goal, a seeker is close to the snitch or the game is in
+         * overtime
+         * @param state the current state
+         * @return whether the turn gets additional time
+         */
+        static bool isCritical(const aiTools::State &state);
+
+    private:
+        unsigned int difficulty;
+        Budget budget{};
+        std::chrono::steady_clock::time_point startTime;
+        std::optional<communication::messages::request::DeltaRequest> lastAction;
+        unsigned int stableIterations = 0;
+    };
+}
+
+#endif //KI_TIMEMANAGER_HPP
@@ -0,0 +1,87 @@
+/**
+ * @file TranspositionTable.cpp
+ * @brief Implements the lock-free transposition table used by the search
+ */
+
+#include "TranspositionTable.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace ai {
+    // Layout of the data word: score (float) | depth (8 bit) | bound (2 bit) + generation (6 bit) | best move (16 bit)
+    constexpr unsigned int SCORE_SHIFT = 32;
+    constexpr unsigned int DEPTH_SHIFT = 24;
+    constexpr unsigned int BOUND_SHIFT = 22;
+    constexpr unsigned int GENERATION_SHIFT = 16;
+    constexpr std::uint64_t GENERATION_MASK = 0x3F;
+
+    TranspositionTable::TranspositionTable(unsigned int sizeLog2) :
+            mask((std::size_t{1} << sizeLog2) - 1), slots(std::make_unique<Slot[]>(std::size_t{1} << sizeLog2)) {
+        clear();
+    }
+
+    auto TranspositionTable::probe(std::uint64_t key) const -> std::optional<Entry> {
+        const auto &slot = slots[key & mask];
+        auto data = slot.data.load(std::memory_order_relaxed);
+        auto check = slot.check.load(std::memory_order_relaxed);
+        if ((check ^ data) != key || data == 0) {
+            return std::nullopt;
+        }
+
+        return unpack(data);
+    }
+
+    void TranspositionTable::store(std::uint64_t key, const Entry &entry) {
+        // Leaves are not stored, this also guarantees that an occupied slot never contains 0
+        if (entry.depth == 0) {
+            return;
+        }
+
+        auto &slot = slots[key & mask];
+        auto currentGeneration = generation.load(std::memory_order_relaxed);
+        auto oldData = slot.data.load(std::memory_order_relaxed);
+        auto oldKey = slot.check.load(std::memory_order_relaxed) ^ oldData;
+        bool oldIsCurrent = ((oldData >> GENERATION_SHIFT) & GENERATION_MASK) == currentGeneration;
+        if (oldData != 0 && oldIsCurrent && unpack(oldData).depth > entry.depth) {
+            return;
+        }
+
+        auto newEntry = entry;
+        if (newEntry.bestMove == NO_MOVE && oldKey == key && oldData != 0) {
+            newEntry.bestMove = unpack(oldData).bestMove;
+        }
+
+        auto data = pack(newEntry, currentGeneration);
+        slot.check.store(key ^ data, std::memory_order_relaxed);
+        slot.data.store(data, std::memory_order_relaxed);
+    }
+
+    void TranspositionTable::newSearch() {
+        generation = static_cast<std::uint8_t>((generation + 1) & GENERATION_MASK);
+    }
+
+    void TranspositionTable::clear() {
+        for (std::size_t i = 0; i <= mask; i++) {
+            slots[i].check.store(0, std::memory_order_relaxed);
+            slots[i].data.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    auto TranspositionTable::pack(const Entry &entry, std::uint8_t generation) -> std::uint64_t {
+        auto score = static_cast<float>(entry.score);
+        std::uint32_t scoreBits = 0;
+        std::memcpy(&scoreBits, &score, sizeof(scoreBits));
+        auto depth = static_cast<std::uint64_t>(std::min(entry.depth, 0xFFu));
+        return static_cast<std::uint64_t>(scoreBits) << SCORE_SHIFT | depth << DEPTH_SHIFT |
+               static_cast<std::uint64_t>(entry.bound) << BOUND_SHIFT |
+               static_cast<std::uint64_t>(generation & GENERATION_MASK) << GENERATION_SHIFT | entry.bestMove;
+    }
+
+    auto TranspositionTable::unpack(std::uint64_t data) -> Entry {
+        auto scoreBits = static_cast<std::uint32_t>(data >> SCORE_SHIFT);
+        float score = 0;
+        std::memcpy(&score, &scoreBits, sizeof(score));
+        return {score, static_cast<unsigned int>((data >> DEPTH_SHIFT) & 0xFF),
+                static_cast<Bound>((data >> BOUND_SHIFT) & 0x3), static_cast<std::uint16_t>(data & 0xFFFF)};
+    }
+}
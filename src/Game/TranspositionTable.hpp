@@ -0,0 +1,84 @@
+/**
+ * @file TranspositionTable.hpp
+ * @brief Declares the lock-free transposition table used by the search
+ */
+
+#ifndef KI_TRANSPOSITIONTABLE_HPP
+#define KI_TRANSPOSITIONTABLE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+namespace ai {
+    /**
+     * Fixed size hash table of search results. Every slot consists of two 64 bit words, the key is stored xor-ed with
+     * the data so concurrent writers never need a lock: a torn slot simply fails the key check on probe.
+     * Entries are replaced by depth, entries of earlier searches are always replaced.
+     */
+    class TranspositionTable {
+    public:
+        static constexpr unsigned int DEFAULT_SIZE_LOG2 = 20;
+        static constexpr std::uint16_t NO_MOVE = 0xFFFF;
+
+        /**
+         * Type of the stored score
+         */
+        enum class Bound : std::uint8_t {
+            Exact, Lower, Upper
+        };
+
+        struct Entry {
+            double score;
+            unsigned int depth;
+            Bound bound;
+            std::uint16_t bestMove;
+        };
+
+        /**
+         * CTor
+         * @param sizeLog2 the table holds 2^sizeLog2 entries
+         */
+        explicit TranspositionTable(unsigned int sizeLog2 = DEFAULT_SIZE_LOG2);
+
+        /**
+         * Looks up a node
+         * @param key the key of the node
+         * @return the stored entry or nothing if the node is not in the table
+         */
+        auto probe(std::uint64_t key) const -> std::optional<Entry>;
+
+        /**
+         * Stores a search result, keeps the deeper of two results for the same slot
+         * @param key the key of the node
+         * @param entry the result of the search
+         */
+        void store(std::uint64_t key, const Entry &entry);
+
+        /**
+         * Marks all stored entries as belonging to a previous search so they get replaced first
+         */
+        void newSearch();
+
+        /**
+         * Removes all entries
+         */
+        void clear();
+
+    private:
+        struct Slot {
+            std::atomic<std::uint64_t> check;
+            std::atomic<std::uint64_t> data;
+        };
+
+        static auto pack(const Entry &entry, std::uint8_t generation) -> std::uint64_t;
+        static auto unpack(std::uint64_t data) -> Entry;
+
+        std::size_t mask;
+        std::unique_ptr<Slot[]> slots;
+        std::atomic<std::uint8_t> generation = 0;
+    };
+}
+
+#endif //KI_TRANSPOSITIONTABLE_HPP
@@ -0,0 +1,172 @@
+/**
+ * @file Zobrist.cpp
+ * @brief Implements the Zobrist hashing of SearchStates
+ */
+
+#include "Zobrist.hpp"
+
+namespace ai {
+    namespace {
+        constexpr std::size_t SCALAR_COUNT = 2 + 4 * FAN_TYPE_COUNT + 6;
+
+        /**
+         * Random keys for all features that are stored per cell, the last entry of every table is used for NO_CELL
+         */
+        struct ZobristTables {
+            std::array<std::array<std::uint64_t, CELL_COUNT + 1>, PLAYER_COUNT> players;
+            std::array<std::array<std::uint64_t, CELL_COUNT + 1>, 4> balls;
+            std::array<std::uint64_t, std::tuple_size_v<decltype(CellSet::bits)> * 64> cubes;
+            std::array<std::uint64_t, PLAYER_COUNT> knockedOut;
+            std::array<std::uint64_t, PLAYER_COUNT> banned;
+            std::array<std::uint64_t, PLAYER_COUNT> used;
+        };
+
+        const ZobristTables &tables() {
+            static const auto instance = []() {
+                ZobristTables ret{};
+                std::uint64_t seed = 0;
+                auto next = [&seed]() { return splitMix(seed++); };
+                for (auto &player : ret.players) {
+                    for (auto &key : player) {
+                        key = next();
+                    }
+                }
+
+                for (auto &ball : ret.balls) {
+                    for (auto &key : ball) {
+                        key = next();
+                    }
+                }
+
+                for (auto &key : ret.cubes) {
+                    key = next();
+                }
+
+                for (std::size_t i = 0; i < PLAYER_COUNT; i++) {
+                    ret.knockedOut[i] = next();
+                    ret.banned[i] = next();
+                    ret.used[i] = next();
+                }
+
+                return ret;
+            }();
+
+            return instance;
+        }
+
+        auto cellIndex(Cell cell) -> std::size_t {
+            return cell == NO_CELL ? CELL_COUNT : cell;
+        }
+
+        /**
+         * All features of a state that are not positions or flags, hashed by value
+         */
+        auto scalars(const SearchState &state) -> std::array<std::uint32_t, SCALAR_COUNT> {
+            std::array<std::uint32_t, SCALAR_COUNT> ret{};
+            std::size_t i = 0;
+            for (auto score : state.scores) {
+                ret[i++] = static_cast<std::uint16_t>(score);
+            }
+
+            for (const auto *counters : {&state.fanblock, &state.availableFans}) {
+                for (const auto &team : *counters) {
+                    for (auto count : team) {
+                        ret[i++] = count;
+                    }
+                }
+            }
+
+            ret[i++] = state.roundNumber;
+            ret[i++] = state.overTimeCounter;
+            ret[i++] = state.phase;
+            ret[i++] = state.overtimeState;
+            ret[i++] = state.snitchExists;
+            ret[i] = state.goalScoredThisRound;
+            return ret;
+        }
+
+        auto scalarKey(std::size_t feature, std::uint32_t value) -> std::uint64_t {
+            return splitMix((static_cast<std::uint64_t>(feature + 1) << 32) ^ value);
+        }
+
+        auto ballCells(const SearchState &state) -> std::array<Cell, 4> {
+            return {state.quaffle, state.bludgers[0], state.bludgers[1], state.snitch};
+        }
+
+        auto toggleMask(std::uint64_t key, std::uint64_t diff, const std::uint64_t *keys) -> std::uint64_t {
+            while (diff != 0) {
+                auto bit = static_cast<std::size_t>(__builtin_ctzll(diff));
+                key ^= keys[bit];
+                diff &= diff - 1;
+            }
+
+            return key;
+        }
+    }
+
+    auto zobristKey(const SearchState &state) -> std::uint64_t {
+        const auto &keys = tables();
+        std::uint64_t key = 0;
+        for (std::size_t i = 0; i < PLAYER_COUNT; i++) {
+            key ^= keys.players[i][cellIndex(state.players[i])];
+        }
+
+        auto balls = ballCells(state);
+        for (std::size_t i = 0; i < balls.size(); i++) {
+            key ^= keys.balls[i][cellIndex(balls[i])];
+        }
+
+        for (std::size_t word = 0; word < state.cubes.bits.size(); word++) {
+            key = toggleMask(key, state.cubes.bits[word], keys.cubes.data() + word * 64);
+        }
+
+        key = toggleMask(key, state.knockedOut, keys.knockedOut.data());
+        key = toggleMask(key, state.banned, keys.banned.data());
+        key = toggleMask(key, state.used, keys.used.data());
+        auto values = scalars(state);
+        for (std::size_t i = 0; i < values.size(); i++) {
+            key ^= scalarKey(i, values[i]);
+        }
+
+        return key;
+    }
+
+    auto updateZobristKey(std::uint64_t key, const SearchState &from, const SearchState &to) -> std::uint64_t {
+        const auto &keys = tables();
+        for (std::size_t i = 0; i < PLAYER_COUNT; i++) {
+            if (from.players[i] != to.players[i]) {
+                key ^= keys.players[i][cellIndex(from.players[i])] ^ keys.players[i][cellIndex(to.players[i])];
+            }
+        }
+
+        auto fromBalls = ballCells(from);
+        auto toBalls = ballCells(to);
+        for (std::size_t i = 0; i < fromBalls.size(); i++) {
+            if (fromBalls[i] != toBalls[i]) {
+                key ^= keys.balls[i][cellIndex(fromBalls[i])] ^ keys.balls[i][cellIndex(toBalls[i])];
+            }
+        }
+
+        for (std::size_t word = 0; word < from.cubes.bits.size(); word++) {
+            key = toggleMask(key, from.cubes.bits[word] ^ to.cubes.bits[word], keys.cubes.data() + word * 64);
+        }
+
+        key = toggleMask(key, from.knockedOut ^ to.knockedOut, keys.knockedOut.data());
+        key = toggleMask(key, from.banned ^ to.banned, keys.banned.data());
+        key = toggleMask(key, from.used ^ to.used, keys.used.data());
+        auto fromValues = scalars(from);
+        auto toValues = scalars(to);
+        for (std::size_t i = 0; i < fromValues.size(); i++) {
+            if (fromValues[i] != toValues[i]) {
+                key ^= scalarKey(i, fromValues[i]) ^ scalarKey(i, toValues[i]);
+            }
+        }
+
+        return key;
+    }
+
+    auto nodeKey(const SearchState &state, const aiTools::ActionState &actionState) -> std::uint64_t {
+        auto turn = (static_cast<std::uint64_t>(actionState.id) << 8) | static_cast<std::uint64_t>(actionState.turnState);
+        return state.key ^ splitMix(~turn);
+    }
+}
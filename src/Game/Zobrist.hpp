@@ -0,0 +1,52 @@
+/**
+ * @file Zobrist.hpp
+ * @brief Declares the Zobrist hashing of SearchStates
+ */
+
+#ifndef KI_ZOBRIST_HPP
+#define KI_ZOBRIST_HPP
+
+#include <cstdint>
+#include "SearchState.hpp"
+
+namespace ai {
+    /**
+     * SplitMix64 finalizer, spreads every bit of the input over the whole result. Used to derive random looking
+     * keys from seeds and feature indices.
+     * @param x the value to mix
+     * @return the mixed value
+     */
+    constexpr auto splitMix(std::uint64_t x) -> std::uint64_t {
+        x += 0x9E3779B97F4A7C15;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EB;
+        return x ^ (x >> 31);
+    }
+
+    /**
+     * Computes the Zobrist key of a state from scratch
+     * @param state the state to hash
+     * @return 64 bit key over player and ball positions, knockout/ban flags, used players, wombat cubes, scores,
+     * fans and the phase of the state
+     */
+    auto zobristKey(const SearchState &state) -> std::uint64_t;
+
+    /**
+     * Incrementally updates a Zobrist key, only the features that differ between the two states are touched
+     * @param key the key of from
+     * @param from the state the key belongs to
+     * @param to the state to compute the key for
+     * @return the key of to
+     */
+    auto updateZobristKey(std::uint64_t key, const SearchState &from, const SearchState &to) -> std::uint64_t;
+
+    /**
+     * Key of a search node, combines the key of the state with the turn that is to be played
+     * @param state the state of the node
+     * @param actionState the turn of the node
+     * @return key identifying the node
+     */
+    auto nodeKey(const SearchState &state, const aiTools::ActionState &actionState) -> std::uint64_t;
+}
+
+#endif //KI_ZOBRIST_HPP
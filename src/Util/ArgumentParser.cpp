@@ -14,9 +14,11 @@ namespace util {
     static constexpr int PORT_DEFAULT = 4488;
     static constexpr int DIFFICULTY_DEFAULT = 1;
     static constexpr int VERBOSITY_DEFAULT = 0;
+    static constexpr int THREADS_DEFAULT = 1;
     static constexpr auto LOBBY_DEFAULT = "hogwarts";
     static constexpr auto USERNAME_DEFAULT = "Team10Ki";
     static constexpr auto PASSWORD_DEFAULT = "password";
+    static constexpr auto ENGINE_DEFAULT = "alphabeta";
 
     ArgumentParser::ArgumentParser(int argc, char **argv) {
         if (argc <= 1) {
@@ -33,6 +35,12 @@ namespace util {
                 {"port", required_argument, nullptr, 'p'},
                 {"difficulty", required_argument, nullptr, 'd'},
                 {"verbosity", required_argument, nullptr, 'v'},
+                {"threads", required_argument, nullptr, 'j'},
+                {"ponder", no_argument, nullptr, 'P'},
+                {"telemetry", required_argument, nullptr, 'T'},
+                {"pretty-json", no_argument, nullptr, 'J'},
+                {"book", required_argument, nullptr, 'b'},
+                {"engine", required_argument, nullptr, 'e'},
                 {}
         };
 
@@ -51,11 +59,13 @@ namespace util {
         int initialPort = PORT_DEFAULT;
         int initialDifficulty = DIFFICULTY_DEFAULT;
         int initialVerbosity = VERBOSITY_DEFAULT;
+        int initialThreads = THREADS_DEFAULT;
         this->lobbyName = LOBBY_DEFAULT;
         this->uName = USERNAME_DEFAULT;
         this->pw = PASSWORD_DEFAULT;
+        this->engine = ENGINE_DEFAULT;
 
-        while((c = getopt_long(argc, argv, "a:t:l:u:p:k:d:v:h", longopts, &optionIndex)) != -1){
+        while((c = getopt_long(argc, argv, "a:t:l:u:p:k:d:v:j:PT:Jb:e:h", longopts, &optionIndex)) != -1){
             std::string optionName;
             if(optionIndex == -1){
                 optionName = static_cast<char>(c);
@@ -91,6 +101,24 @@ namespace util {
                 case 'v':
                     initialVerbosity = parse(optionName);
                     break;
+                case 'j':
+                    initialThreads = parse(optionName);
+                    break;
+                case 'P':
+                    ponder = true;
+                    break;
+                case 'T':
+                    telemetry = optarg;
+                    break;
+                case 'J':
+                    prettyJson = true;
+                    break;
+                case 'b':
+                    book = optarg;
+                    break;
+                case 'e':
+                    engine = optarg;
+                    break;
                 case 'h':
                     printHelp();
                     std::exit(0);
@@ -127,9 +155,14 @@ namespace util {
             throw std::invalid_argument{"Verbosity needs to be none negative"};
         }
 
+        if (initialThreads < 1) {
+            throw std::invalid_argument{"Threads needs to be positive"};
+        }
+
         port = static_cast<uint16_t>(initialPort);
         difficulty = static_cast<unsigned int>(initialDifficulty);
         verbosity = static_cast<unsigned int>(initialVerbosity);
+        threads = static_cast<unsigned int>(initialThreads);
     }
 
     void ArgumentParser::printHelp() {
@@ -143,7 +176,13 @@ namespace util {
                   << "\t -k/--password: Password of the AI player\n"
                   << "\t -p/--port: Port to connect to\n"
                   << "\t -d/--difficulty: Strength of the AI Player. Choose between 0 (maximum difficulty) and 2\n"
-                  << "\t -v/--verbosity: Displays additional information (0 = none, 1 = error level, 2 = warn level, 3 = info level, 4 = debug level)"
+                  << "\t -v/--verbosity: Displays additional information (0 = none, 1 = error level, 2 = warn level, 3 = info level, 4 = debug level)\n"
+                  << "\t -j/--threads: Number of threads used for the search\n"
+                  << "\t -P/--ponder: Keep searching while the opponent is thinking\n"
+                  << "\t -T/--telemetry: Write search statistics as JSON lines to a file or to unix:SOCKET_PATH\n"
+                  << "\t -J/--pretty-json: Send indented JSON to the server (for debugging)\n"
+                  << "\t -b/--book: Opening book written by SelfPlay --book\n"
+                  << "\t -e/--engine: Search engine (alphabeta, star1 = expectimax with Star1 pruning, star2 = expectimax with Star2 pruning, mcts = Monte Carlo tree search for actions and fans)"
                   << std::endl;
     }
 
@@ -178,4 +217,28 @@ namespace util {
     int ArgumentParser::getVerbosity() const {
         return verbosity;
     }
+
+    int ArgumentParser::getThreads() const {
+        return threads;
+    }
+
+    bool ArgumentParser::getPonder() const {
+        return ponder;
+    }
+
+    std::string ArgumentParser::getTelemetry() const {
+        return telemetry;
+    }
+
+    bool ArgumentParser::getPrettyJson() const {
+        return prettyJson;
+    }
+
+    std::string ArgumentParser::getBook() const {
+        return book;
+    }
+
+    std::string ArgumentParser::getEngine() const {
+        return engine;
+    }
 }
@@ -74,6 +74,42 @@ namespace util {
          */
         int getVerbosity() const;
 
+        /**
+         * Return the number of search threads
+         * @return the value given to the threads flag or 1
+         */
+        int getThreads() const;
+
+        /**
+         * Return whether to search on the opponent's time
+         * @return true if the ponder flag is set
+         */
+        bool getPonder() const;
+
+        /**
+         * Return the telemetry target
+         * @return the value given to the telemetry flag or an empty string
+         */
+        std::string getTelemetry() const;
+
+        /**
+         * Return whether to indent the JSON sent to the server
+         * @return true if the pretty-json flag is set
+         */
+        bool getPrettyJson() const;
+
+        /**
+         * Return the path of the opening book
+         * @return the value given to the book flag or an empty string
+         */
+        std::string getBook() const;
+
+        /**
+         * Return the name of the search engine
+         * @return the value given to the engine flag or "alphabeta"
+         */
+        std::string getEngine() const;
+
         /**
          * Prints the help message, gets called by the CTor if the -h or --help flag is set.
          */
@@ -87,6 +123,12 @@ namespace util {
         uint port{};
         unsigned int difficulty{};
         unsigned int verbosity{};
+        unsigned int threads{};
+        bool ponder{};
+        std::string telemetry;
+        bool prettyJson{};
+        std::string book;
+        std::string engine;
     };
 }
 
@@ -0,0 +1,171 @@
+/**
+ * @file AsyncLog.cpp
+ * @brief Implementation of the AsyncLog class
+ */
+
+#include "AsyncLog.hpp"
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <SopraUtil/Logging.hpp>
+
+namespace util {
+    /**
+     * Bounded multi-producer single-consumer queue (sequence numbers per slot as described by D. Vyukov) and the
+     * thread consuming it
+     */
+    class AsyncLog::Ring {
+    public:
+        Ring(std::ostream &stream, unsigned int verbosity, std::size_t capacity) :
+                backend{stream, verbosity}, mask{roundUp(capacity) - 1}, slots{makeSlots(mask + 1)},
+                thread{&Ring::drain, this} {}
+
+        ~Ring() {
+            stop = true;
+            thread.join();
+        }
+
+        Ring(const Ring &) = delete;
+        Ring &operator=(const Ring &) = delete;
+
+        bool push(Level level, std::string &message) {
+            auto position = head.load(std::memory_order_relaxed);
+            Slot *slot;
+            while (true) {
+                slot = &slots[position & mask];
+                auto sequence = slot->sequence.load(std::memory_order_acquire);
+                auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+                if (difference == 0) {
+                    if (head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                } else if (difference < 0) {
+                    dropped.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                } else {
+                    position = head.load(std::memory_order_relaxed);
+                }
+            }
+
+            slot->level = level;
+            slot->message = std::move(message);
+            slot->sequence.store(position + 1, std::memory_order_release);
+            return true;
+        }
+
+        void flush() const {
+            auto target = head.load(std::memory_order_acquire);
+            while (tail.load(std::memory_order_acquire) < target) {
+                std::this_thread::sleep_for(IDLE_INTERVAL);
+            }
+        }
+
+        auto getDropped() const -> std::size_t {
+            return dropped.load(std::memory_order_relaxed);
+        }
+
+    private:
+        struct Slot {
+            std::atomic<std::size_t> sequence;
+            Level level;
+            std::string message;
+        };
+
+        static constexpr std::chrono::milliseconds IDLE_INTERVAL{1};
+
+        util::Logging backend;
+        const std::size_t mask;
+        std::unique_ptr<Slot[]> slots;
+        std::atomic<std::size_t> head = 0;
+        std::atomic<std::size_t> tail = 0;
+        std::atomic<std::size_t> dropped = 0;
+        std::atomic_bool stop = false;
+        std::thread thread;
+
+        static auto roundUp(std::size_t capacity) -> std::size_t {
+            std::size_t ret = 1;
+            while (ret < capacity) {
+                ret <<= 1;
+            }
+
+            return ret;
+        }
+
+        static auto makeSlots(std::size_t size) -> std::unique_ptr<Slot[]> {
+            std::unique_ptr<Slot[]> ret{new Slot[size]};
+            for (std::size_t i = 0; i < size; i++) {
+                ret[i].sequence.store(i, std::memory_order_relaxed);
+            }
+
+            return ret;
+        }
+
+        bool pop() {
+            auto position = tail.load(std::memory_order_relaxed);
+            auto &slot = slots[position & mask];
+            if (slot.sequence.load(std::memory_order_acquire) != position + 1) {
+                return false;
+            }
+
+            switch (slot.level) {
+                case Level::Error:
+                    backend.error(slot.message);
+                    break;
+                case Level::Warn:
+                    backend.warn(slot.message);
+                    break;
+                case Level::Info:
+                    backend.info(slot.message);
+                    break;
+                case Level::Debug:
+                    backend.debug(slot.message);
+                    break;
+                case Level::ShitTalk:
+                    backend.shitTalk(slot.message);
+                    break;
+            }
+
+            slot.message.clear();
+            slot.sequence.store(position + mask + 1, std::memory_order_release);
+            tail.store(position + 1, std::memory_order_release);
+            return true;
+        }
+
+        void drain() {
+            while (true) {
+                if (!pop()) {
+                    if (stop) {
+                        while (pop()) {}
+                        return;
+                    }
+
+                    std::this_thread::sleep_for(IDLE_INTERVAL);
+                }
+            }
+        }
+    };
+
+    AsyncLog::AsyncLog(std::ostream &stream, unsigned int verbosity, std::size_t capacity) : verbosity{verbosity} {
+        if (verbosity > 0) {
+            ring = std::make_shared<Ring>(stream, verbosity, capacity);
+        }
+    }
+
+    bool AsyncLog::isEnabled(Level level) const {
+        return level == Level::ShitTalk ? verbosity > 0 : static_cast<unsigned int>(level) <= verbosity;
+    }
+
+    void AsyncLog::flush() const {
+        if (ring != nullptr) {
+            ring->flush();
+        }
+    }
+
+    auto AsyncLog::getDropped() const -> std::size_t {
+        return ring != nullptr ? ring->getDropped() : 0;
+    }
+
+    void AsyncLog::push(Level level, std::string message) const {
+        ring->push(level, message);
+    }
+}
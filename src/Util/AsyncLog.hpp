@@ -0,0 +1,104 @@
+/**
+ * @file AsyncLog.hpp
+ * @brief Declaration of the AsyncLog class
+ */
+
+#ifndef KI_ASYNCLOG_HPP
+#define KI_ASYNCLOG_HPP
+
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <type_traits>
+
+namespace util {
+    /**
+     * Logging front end for util::Logging. Messages are only formatted if their level is enabled, a message can
+     * be passed as a callable returning the text to defer the formatting. Records are written to a lock-free ring
+     * buffer that a background thread drains into util::Logging, so logging never waits for the output stream.
+     *
+     * Copies share the same buffer and thread, the thread stops when the last copy is destroyed.
+     */
+    class AsyncLog {
+    public:
+        enum class Level : std::uint8_t {
+            Error = 1, Warn, Info, Debug, ShitTalk
+        };
+
+        static constexpr std::size_t DEFAULT_CAPACITY = 4096;
+
+        /**
+         * CTor, starts the background thread if any level is enabled
+         * @param stream the stream util::Logging writes to
+         * @param verbosity log level (0 = none, 1 = error, 2 = warn, 3 = info, 4 = debug)
+         * @param capacity number of records the buffer holds, rounded up to a power of two. Records are dropped
+         * while the buffer is full.
+         */
+        AsyncLog(std::ostream &stream, unsigned int verbosity, std::size_t capacity = DEFAULT_CAPACITY);
+
+        template<typename Message>
+        void error(Message &&message) const {
+            write(Level::Error, std::forward<Message>(message));
+        }
+
+        template<typename Message>
+        void warn(Message &&message) const {
+            write(Level::Warn, std::forward<Message>(message));
+        }
+
+        template<typename Message>
+        void info(Message &&message) const {
+            write(Level::Info, std::forward<Message>(message));
+        }
+
+        template<typename Message>
+        void debug(Message &&message) const {
+            write(Level::Debug, std::forward<Message>(message));
+        }
+
+        template<typename Message>
+        void shitTalk(Message &&message) const {
+            write(Level::ShitTalk, std::forward<Message>(message));
+        }
+
+        /**
+         * Whether messages of a level are written, util::Logging decides about the level of shit talk itself
+         * @param level the level to check
+         */
+        bool isEnabled(Level level) const;
+
+        /**
+         * Blocks until all records logged so far have been written
+         */
+        void flush() const;
+
+        /**
+         * Number of records dropped because the buffer was full
+         */
+        auto getDropped() const -> std::size_t;
+
+    private:
+        class Ring;
+
+        unsigned int verbosity;
+        std::shared_ptr<Ring> ring;
+
+        template<typename Message>
+        void write(Level level, Message &&message) const {
+            if (!isEnabled(level)) {
+                return;
+            }
+
+            if constexpr (std::is_invocable_v<Message>) {
+                push(level, std::string(std::forward<Message>(message)()));
+            } else {
+                push(level, std::string(std::forward<Message>(message)));
+            }
+        }
+
+        void push(Level level, std::string message) const;
+    };
+}
+
+#endif //KI_ASYNCLOG_HPP
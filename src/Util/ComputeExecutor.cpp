@@ -0,0 +1,97 @@
+/**
+ * @file ComputeExecutor.cpp
+ * @brief Implementation of the ComputeExecutor class
+ */
+
+#include "ComputeExecutor.hpp"
+#include <algorithm>
+
+namespace util {
+    ComputeExecutor::ComputeExecutor(std::size_t capacity, ErrorHandler onError) :
+            capacity{capacity}, onError{std::move(onError)}, thread{&ComputeExecutor::run, this} {}
+
+    ComputeExecutor::~ComputeExecutor() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopped = true;
+            queue.clear();
+        }
+
+        cv.notify_all();
+        thread.join();
+    }
+
+    bool ComputeExecutor::submit(Job job, bool replaceable) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (replaceable) {
+                auto size = queue.size();
+                queue.erase(std::remove_if(queue.begin(), queue.end(), [](const Entry &entry) {
+                    return entry.replaceable;
+                }), queue.end());
+                dropped += size - queue.size();
+            }
+
+            if (replaceable && queue.size() >= capacity) {
+                dropped++;
+                return false;
+            }
+
+            queue.push_back({std::move(job), replaceable});
+        }
+
+        cv.notify_one();
+        return true;
+    }
+
+    auto ComputeExecutor::getDropped() const -> std::size_t {
+        std::lock_guard<std::mutex> lock(mutex);
+        return dropped;
+    }
+
+    void ComputeExecutor::run() {
+        while (true) {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cv.wait(lock, [this] { return stopped || !queue.empty(); });
+                if (stopped) {
+                    return;
+                }
+
+                job = std::move(queue.front().job);
+                queue.pop_front();
+            }
+
+            try {
+                job();
+            } catch (std::exception &e) {
+                if (onError) {
+                    onError(e);
+                }
+            }
+        }
+    }
+
+    void LatencyStats::add(std::chrono::steady_clock::duration latency) {
+        count++;
+        total += latency;
+        max = std::max(max, latency);
+    }
+
+    auto LatencyStats::getCount() const -> unsigned long {
+        return count;
+    }
+
+    auto LatencyStats::getMean() const -> double {
+        if (count == 0) {
+            return 0;
+        }
+
+        return std::chrono::duration<double, std::milli>(total).count() / static_cast<double>(count);
+    }
+
+    auto LatencyStats::getMax() const -> double {
+        return std::chrono::duration<double, std::milli>(max).count();
+    }
+}
@@ -0,0 +1,105 @@
+/**
+ * @file ComputeExecutor.hpp
+ * @brief Declaration of the ComputeExecutor class
+ */
+
+#ifndef KI_COMPUTEEXECUTOR_HPP
+#define KI_COMPUTEEXECUTOR_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace util {
+    /**
+     * Long-lived thread that runs jobs one after another from a queue. Submitting never blocks, so the thread
+     * receiving network messages can hand work over without waiting for a running search. Only replaceable jobs are
+     * dropped, all other jobs are always queued.
+     */
+    class ComputeExecutor {
+    public:
+        using Job = std::function<void()>;
+        using ErrorHandler = std::function<void(const std::exception &)>;
+
+        /**
+         * CTor, starts the thread
+         * @param capacity queue length from which replaceable jobs are dropped, the running job does not count
+         * @param onError called on the executor thread if a job throws, the executor keeps running
+         */
+        ComputeExecutor(std::size_t capacity, ErrorHandler onError);
+
+        /**
+         * DTor. Drops all queued jobs, waits for the running job and stops the thread
+         */
+        ~ComputeExecutor();
+
+        ComputeExecutor(const ComputeExecutor &) = delete;
+        ComputeExecutor &operator=(const ComputeExecutor &) = delete;
+
+        /**
+         * Queues a job
+         * @param job the job to run
+         * @param replaceable replaceable jobs that are still queued are dropped when another replaceable job is
+         * submitted, they are stale at that point
+         * @return false if the job was replaceable and dropped because the queue was full
+         */
+        bool submit(Job job, bool replaceable = false);
+
+        /**
+         * Number of jobs that were dropped because they were replaced or the queue was full
+         */
+        auto getDropped() const -> std::size_t;
+
+    private:
+        struct Entry {
+            Job job;
+            bool replaceable;
+        };
+
+        const std::size_t capacity;
+        const ErrorHandler onError;
+        mutable std::mutex mutex;
+        std::condition_variable cv;
+        std::deque<Entry> queue;
+        std::size_t dropped = 0;
+        bool stopped = false;
+        std::thread thread;
+
+        void run();
+    };
+
+    /**
+     * Running statistics of a latency, not synchronised
+     */
+    class LatencyStats {
+    public:
+        /**
+         * Adds a sample
+         * @param latency time between the request and the answer
+         */
+        void add(std::chrono::steady_clock::duration latency);
+
+        auto getCount() const -> unsigned long;
+
+        /**
+         * Mean latency in milliseconds, 0 without samples
+         */
+        auto getMean() const -> double;
+
+        /**
+         * Maximum latency in milliseconds
+         */
+        auto getMax() const -> double;
+
+    private:
+        unsigned long count = 0;
+        std::chrono::steady_clock::duration total{};
+        std::chrono::steady_clock::duration max{};
+    };
+}
+
+#endif //KI_COMPUTEEXECUTOR_HPP
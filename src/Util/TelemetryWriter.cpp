@@ -0,0 +1,115 @@
+/**
+ * @file TelemetryWriter.cpp
+ * @brief Definition of the TelemetryWriter class
+ */
+
+#include "TelemetryWriter.hpp"
+#include <cstring>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace util {
+    static constexpr auto SOCKET_PREFIX = "unix:";
+
+    TelemetryWriter::TelemetryWriter(const std::string &target, std::size_t capacity) : capacity(capacity) {
+        if (target.rfind(SOCKET_PREFIX, 0) == 0) {
+            auto path = target.substr(std::strlen(SOCKET_PREFIX));
+            sockaddr_un address{};
+            if (path.size() >= sizeof(address.sun_path)) {
+                throw std::runtime_error{"Telemetry socket path is too long"};
+            }
+
+            address.sun_family = AF_UNIX;
+            std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+            socket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+            if (socket < 0 || connect(socket, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0) {
+                if (socket >= 0) {
+                    close(socket);
+                }
+
+                throw std::runtime_error{"Could not connect to telemetry socket " + path};
+            }
+        } else {
+            file.open(target, std::ios::app);
+            if (!file.is_open()) {
+                throw std::runtime_error{"Could not open telemetry file " + target};
+            }
+        }
+
+        thread = std::thread(&TelemetryWriter::drain, this);
+    }
+
+    TelemetryWriter::~TelemetryWriter() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+
+        queued.notify_one();
+        thread.join();
+        if (socket >= 0) {
+            close(socket);
+        }
+    }
+
+    void TelemetryWriter::write(nlohmann::json record) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (queue.size() >= capacity) {
+                dropped++;
+                return;
+            }
+
+            queue.emplace_back(std::move(record));
+        }
+
+        queued.notify_one();
+    }
+
+    void TelemetryWriter::flush() {
+        std::unique_lock<std::mutex> lock(mutex);
+        idle.wait(lock, [this] { return queue.empty() && !writing; });
+    }
+
+    auto TelemetryWriter::getDropped() -> std::size_t {
+        std::lock_guard<std::mutex> lock(mutex);
+        return dropped;
+    }
+
+    void TelemetryWriter::drain() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            queued.wait(lock, [this] { return stop || !queue.empty(); });
+            if (queue.empty()) {
+                return;
+            }
+
+            auto record = std::move(queue.front());
+            queue.pop_front();
+            writing = true;
+            lock.unlock();
+            writeLine(record.dump() + '\n');
+            lock.lock();
+            writing = false;
+            idle.notify_all();
+        }
+    }
+
+    void TelemetryWriter::writeLine(const std::string &line) {
+        if (socket >= 0) {
+            std::size_t written = 0;
+            while (written < line.size()) {
+                auto ret = ::send(socket, line.data() + written, line.size() - written, MSG_NOSIGNAL);
+                if (ret <= 0) {
+                    return;
+                }
+
+                written += static_cast<std::size_t>(ret);
+            }
+        } else {
+            file << line << std::flush;
+        }
+    }
+}
@@ -0,0 +1,77 @@
+/**
+ * @file TelemetryWriter.hpp
+ * @brief Declaration of the TelemetryWriter class
+ */
+
+#ifndef KI_TELEMETRYWRITER_HPP
+#define KI_TELEMETRYWRITER_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <nlohmann/json.hpp>
+
+namespace util {
+    /**
+     * Writes records as newline-delimited JSON either to a file or to a local (unix domain) socket. Records are
+     * queued and serialized and written by a background thread, so a slow disk or reader never delays the caller.
+     */
+    class TelemetryWriter {
+    public:
+        static constexpr std::size_t DEFAULT_CAPACITY = 1024;
+
+        /**
+         * CTor, opens the target and starts the background thread
+         * @param target path of the file to append to, or "unix:" followed by the path of a listening socket
+         * @param capacity number of records the queue holds, records are dropped while it is full
+         * @throws std::runtime_error if the target can't be opened
+         */
+        explicit TelemetryWriter(const std::string &target, std::size_t capacity = DEFAULT_CAPACITY);
+
+        /**
+         * DTor, writes the queued records and stops the background thread
+         */
+        ~TelemetryWriter();
+
+        TelemetryWriter(const TelemetryWriter &) = delete;
+        TelemetryWriter &operator=(const TelemetryWriter &) = delete;
+
+        /**
+         * Queues a record to be written as a single line, thread safe. Errors are ignored so that telemetry never
+         * stops the game.
+         * @param record the record to write
+         */
+        void write(nlohmann::json record);
+
+        /**
+         * Blocks until all records queued so far have been written
+         */
+        void flush();
+
+        /**
+         * Number of records dropped because the queue was full
+         */
+        auto getDropped() -> std::size_t;
+
+    private:
+        void drain();
+        void writeLine(const std::string &line);
+
+        std::size_t capacity;
+        std::mutex mutex;
+        std::condition_variable queued;
+        std::condition_variable idle;
+        std::deque<nlohmann::json> queue;
+        bool writing = false;
+        bool stop = false;
+        std::size_t dropped = 0;
+        std::ofstream file;
+        int socket = -1;
+        std::thread thread;
+    };
+}
+
+#endif //KI_TELEMETRYWRITER_HPP
@@ -1,6 +1,9 @@
 #include <Util/ArgumentParser.hpp>
+#include <Util/TelemetryWriter.hpp>
+#include <Game/OpeningBook.hpp>
+#include <Game/Engine.hpp>
 #include <iostream>
-#include <SopraUtil/Logging.hpp>
+#include <Util/AsyncLog.hpp>
 #include <Communication/MessageHandler.hpp>
 #include <filesystem>
 #include <fstream>
@@ -15,6 +18,12 @@ int main(int argc, char *argv[]) {
     uint16_t port;
     unsigned int difficulty;
     unsigned int verbosity;
+    unsigned int threads;
+    bool ponder;
+    std::string telemetryTarget;
+    bool prettyJson;
+    std::string bookPath;
+    ai::Engine engine;
 
     try {
         util::ArgumentParser argumentParser{argc, argv};
@@ -26,6 +35,12 @@ int main(int argc, char *argv[]) {
         port = argumentParser.getPort();
         difficulty = argumentParser.getDifficulty();
         verbosity = argumentParser.getVerbosity();
+        threads = argumentParser.getThreads();
+        ponder = argumentParser.getPonder();
+        telemetryTarget = argumentParser.getTelemetry();
+        prettyJson = argumentParser.getPrettyJson();
+        bookPath = argumentParser.getBook();
+        engine = ai::engineFromString(argumentParser.getEngine());
     } catch (std::invalid_argument &e) {
         std::cerr << e.what() << std::endl;
         std::exit(1);
@@ -50,9 +65,29 @@ int main(int argc, char *argv[]) {
         std::exit(1);
     }
 
-    util::Logging log{std::cout, verbosity};
-    communication::Communicator communicator{
-        lobbyName, uName, pw, difficulty, teamConfig, address, port, log};
+    std::shared_ptr<util::TelemetryWriter> telemetry;
+    if (!telemetryTarget.empty()) {
+        try {
+            telemetry = std::make_shared<util::TelemetryWriter>(telemetryTarget);
+        } catch (std::runtime_error &e) {
+            std::cerr << e.what() << std::endl;
+            std::exit(1);
+        }
+    }
+
+    std::shared_ptr<const ai::OpeningBook> openingBook;
+    if (!bookPath.empty()) {
+        try {
+            openingBook = std::make_shared<const ai::OpeningBook>(bookPath);
+        } catch (std::runtime_error &e) {
+            std::cerr << e.what() << std::endl;
+            std::exit(1);
+        }
+    }
+
+    util::AsyncLog log{std::cout, verbosity};
+    communication::Communicator communicator{lobbyName, uName, pw, difficulty, threads, ponder, engine, telemetry,
+                                             openingBook, prettyJson, teamConfig, address, port, log};
 
     log.info("Started");
 